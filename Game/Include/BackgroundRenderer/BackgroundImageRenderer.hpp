@@ -4,6 +4,7 @@
 #define MAX_BACKGROUNDS 50
 
 #include <queue>
+#include "Misc/StringPool.hpp"
 
 enum BackgroundStatus {bgLoaded, bgUnloaded, bgError};
 
@@ -37,7 +38,7 @@ private:
 class Background {
 public:
   Background(std::string bName, std::string bFilename, sf::RenderWindow *windowPointer) {
-    name = bName;
+    name = InternedString(bName);
     fileName = bFilename;
     myStatus = BackgroundStatus::bgUnloaded;
     myTexture = nullptr;
@@ -77,7 +78,7 @@ public:
       }
     }
   }
-  std::string getName() {
+  InternedString getName() {
     return name;
   }
   void setAlpha(float alpha) {
@@ -92,7 +93,7 @@ public:
     }
   }
 private:
-  std::string name;
+  InternedString name;
   std::string fileName;
   int id;
   sf::Texture *myTexture;
@@ -127,8 +128,13 @@ public:
   void update();
   void draw();
   void setBackground(std::string name);
+  void setBackground(InternedString name);
   void setUpcomingBackground(std::string name);
+  void setUpcomingBackground(InternedString name);
+  void clearUpcomingBackground();
+  InternedString getBackgroundName();
   int findBackground(std::string name);
+  int findBackground(InternedString name);
   void setBackgroundColour(sf::Color *colour);
   void disableImageDrawing();
   void enableImageDrawing();
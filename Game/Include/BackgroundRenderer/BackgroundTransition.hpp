@@ -11,6 +11,8 @@ public:
 
     bool update();
 
+    void finish();
+
     void draw();
 
     void setPrimaryColour(sf::Color colour);
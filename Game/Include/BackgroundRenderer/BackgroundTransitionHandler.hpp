@@ -14,6 +14,10 @@ public:
 
     bool hasTransitionCompleted();
 
+    void cancelTransition();
+
+    void finishTransition();
+
     void
     startTransition(int transitionType, sf::Color primaryColour, int delayBeforeStart, int delay, int animationLength);
 
@@ -28,6 +28,7 @@ private:
     BackgroundImageRenderer *backgroundImageRenderer;
     BackgroundTransitionHandler *backgroundTransitionRenderer;
     CharacterSpriteRenderer *characterSpriteRenderer;
+    LoadingProgress *loadingProgress;
     int frameRateLimit;
 #ifdef MULTITHREADED_RENDERING
     std::thread *renderingThread;
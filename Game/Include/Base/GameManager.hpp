@@ -3,19 +3,24 @@
 #ifndef BASE_GAME_MANAGER_INCLUDED
 #define BASE_GAME_MANAGER_INCLUDED
 
+#include <future>
+
 // Include all of the game GameScreens
 #include "VisualNovelEngine/Screens/NovelScreen.hpp"
 #include "Base/ErrorScreen.hpp"
+#include "Base/LoadingScreen.hpp"
 #include "VisualNovelEngine/Classes/Data/Novel.hpp"
+#include "Config/Config.hpp"
 
 // Don't give anything in this enum the same name as a class, it breaks the build process - I learned this the hard way.
 enum GameState {
-    Init, Title, Menu, GameField, Test, Novel, ExceptionCaught
+    Loading, Init, Title, Menu, GameField, Test, Novel, ExceptionCaught
 };
 
 class GameManager {
 public:
-    GameManager(Engine *enginePointer, const std::string& initialErrorMessage);
+    GameManager(Engine *enginePointer, const std::string& initialErrorMessage, std::future<NovelData *> gameLoad,
+                LoadingProgress *loadingProgress, Config *gameConfig);
 
     ~GameManager();
 
@@ -32,13 +37,23 @@ public:
     void invokeErrorScreen(GeneralException &e);
 
     void invokeErrorScreen(const std::string& message);
+
+    bool isLoading() {
+        return currentGameState == GameState::Loading;
+    }
 private:
+    void finishLoading();
+
 
     GameState currentGameState;
     Engine *engine;
     InputManager *inputManager;
     NovelScreen *novelScreen;
     ErrorScreen *errorScreen;
+    LoadingScreen *loadingScreen;
+    LoadingProgress *progress;
+    Config *config;
+    std::future<NovelData *> novelLoad;
     NovelData *novel;
     ResourceManager *resourceManager;
 };
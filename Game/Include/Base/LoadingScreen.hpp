@@ -0,0 +1,22 @@
+#ifndef LOADING_SCREEN_INCLUDED
+#define LOADING_SCREEN_INCLUDED
+
+#include "Misc/LoadingProgress.hpp"
+
+class LoadingScreen {
+public:
+    LoadingScreen(sf::RenderWindow *window, LoadingProgress *loadingProgress);
+    ~LoadingScreen();
+    void start();
+    void update();
+    void draw();
+private:
+    sf::Font *loadingFont;
+    sf::Text *descriptionText;
+    sf::RectangleShape *progressBarOutline;
+    sf::RectangleShape *progressBar;
+    sf::RenderWindow *mainWindow;
+    LoadingProgress *progress;
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include "Exceptions/ConfigurationException.hpp"
 #include "Config/ConfigConstants.hpp"
 #include "Misc/JsonHandler.hpp"
+#include "Database/DatabaseConnectionProfile.hpp"
 
 // TODO: Validate that the novel itself supports any given setting (e.g display modes due to sprite sizes)
 
@@ -21,6 +22,11 @@ public:
     void setDefaults() {
         setDisplayMode(ConfigConstants::DISPLAY_MODE_WINDOWED);
         setFrameRate(ConfigConstants::FPS_60);
+
+        databaseProfile = *DatabaseConnectionProfile::getRuntimeProfile();
+        novelResidency = ConfigConstants::NOVEL_RESIDENCY_FULL;
+        skipUnreadText = false;
+        locale = "";
     }
 
     /**
@@ -37,6 +43,34 @@ public:
             setFrameRate(JsonHandler::getInteger(pConfig, "frameRate"));
         }
 
+        if (pConfig.find("novelResidency") != pConfig.end()) {
+            setNovelResidency(JsonHandler::getString(pConfig, "novelResidency"));
+        }
+
+        if (pConfig.find("skipUnreadText") != pConfig.end()) {
+            skipUnreadText = JsonHandler::getBoolean(pConfig, "skipUnreadText");
+        }
+
+        if (pConfig.find("locale") != pConfig.end()) {
+            locale = JsonHandler::getString(pConfig, "locale");
+        }
+
+        if (pConfig.find("databaseMode") != pConfig.end()) {
+            setDatabaseMode(JsonHandler::getString(pConfig, "databaseMode"));
+        }
+
+        if (pConfig.find("databaseMmapSize") != pConfig.end()) {
+            databaseProfile.mmapSize = JsonHandler::getInteger(pConfig, "databaseMmapSize");
+        }
+
+        if (pConfig.find("databaseCacheSize") != pConfig.end()) {
+            databaseProfile.cacheSizeKiB = JsonHandler::getInteger(pConfig, "databaseCacheSize");
+        }
+
+        if (pConfig.find("databasePoolSize") != pConfig.end()) {
+            databaseProfile.poolSize = JsonHandler::getInteger(pConfig, "databasePoolSize");
+        }
+
     };
 
     /**
@@ -84,6 +118,63 @@ public:
         frameRate = pFrameRate;
     }
 
+    /**
+     * Sets how the novel and resource databases are opened: readwrite, readonly or memory
+     * @param pDatabaseMode
+     */
+    void setDatabaseMode(const std::string &pDatabaseMode) {
+
+        if (!DatabaseConnectionProfile::parseMode(pDatabaseMode, databaseProfile.mode)) {
+            std::vector<std::string> error = {
+                    "Unsupported database mode setting: ", pDatabaseMode
+            };
+            throw ConfigurationException(Utils::implodeString(error));
+        }
+    }
+
+    /**
+     * Sets whether the whole novel is loaded at startup (full), only the scenes around the current one (windowed), or
+     * whether it is read from the novel image written by the compiler (image)
+     * @param pNovelResidency
+     */
+    void setNovelResidency(const std::string &pNovelResidency) {
+
+        if (pNovelResidency == "full") {
+            novelResidency = ConfigConstants::NOVEL_RESIDENCY_FULL;
+        } else if (pNovelResidency == "windowed") {
+            novelResidency = ConfigConstants::NOVEL_RESIDENCY_WINDOWED;
+        } else if (pNovelResidency == "image") {
+            novelResidency = ConfigConstants::NOVEL_RESIDENCY_IMAGE;
+        } else {
+            std::vector<std::string> error = {
+                    "Unsupported novel residency setting: ", pNovelResidency
+            };
+            throw ConfigurationException(Utils::implodeString(error));
+        }
+    }
+
+    int getNovelResidency() {
+        return novelResidency;
+    }
+
+    /**
+     * Whether skip mode carries on through lines which have never been read, rather than stopping at the first one
+     */
+    bool shouldSkipUnreadText() {
+        return skipUnreadText;
+    }
+
+    /**
+     * The locale the novel is played in, empty for the locale it is written in
+     */
+    std::string getLocale() {
+        return locale;
+    }
+
+    DatabaseConnectionProfile getDatabaseProfile() {
+        return databaseProfile;
+    }
+
     int getFrameRate() {
         return frameRate;
     }
@@ -98,6 +189,14 @@ private:
     int displayWidth;
     int displayHeight;
     int frameRate;
+
+    // Novel settings
+    int novelResidency;
+    bool skipUnreadText;
+    std::string locale;
+
+    // Database settings
+    DatabaseConnectionProfile databaseProfile;
 };
 
 #endif
\ No newline at end of file
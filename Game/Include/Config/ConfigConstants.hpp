@@ -11,6 +11,9 @@ public:
     static const int FPS_60 = 60;
     static const int FPS_120 = 120;
     static const int FPS_144 = 144;
+    static const int NOVEL_RESIDENCY_FULL = 0;
+    static const int NOVEL_RESIDENCY_WINDOWED = 1;
+    static const int NOVEL_RESIDENCY_IMAGE = 2;
 private:
 };
 
@@ -4,12 +4,17 @@
 #include <sqlite3.h>
 #include <iostream>
 #include <vector>
+#include <unordered_map>
 #include <Exceptions/DatabaseException.hpp>
 #include <Exceptions/DataSetException.hpp>
 #include <regex>
-
-#define DATA_SET_MAX_ROWS 1000
-#define DATA_SET_MAX_COLUMNS 50
+#include <string_view>
+#include <charconv>
+#include <limits>
+#include <cstdlib>
+#include <cctype>
+#include "Database/PreparedStatement.hpp"
+#include "Database/DatabaseConnectionProfile.hpp"
 
 #define DATA_TYPE_NUMBER 0
 #define DATA_TYPE_STRING 1
@@ -17,21 +22,55 @@
 #define DATA_TYPE_DATE_TIME 3
 #define DATA_TYPE_BOOLEAN 4
 
+#define INSERT_MAX_ROWS_PER_STATEMENT 50
+
 enum FetchMode {
     None, All, One
 };
 
+struct DataSet;
+
+/**
+ * The storage class SQLite returned a value with, values are kept in this form until they are read
+ */
+enum class DataStorageType : unsigned char {
+    Null, Integer, Float, Text, Blob
+};
+
+/**
+ * A single value from a result set. Integers and floats are stored in the container itself, text and blobs live in the
+ * arena of the owning DataSet and this only records where to find them. The typed accessors read the native value
+ * directly, so they do not allocate unless the value has to be parsed from text.
+ */
 struct DataContainer {
-    DataContainer(const std::string &value, const std::string &parentColumnName, bool isNull) {
-        data = isNull ? "" : value;
-        columnName = parentColumnName;
+    DataContainer(DataSet *ownerDataSet, int parentColumnIndex, DataStorageType storageType) {
+        owner = ownerDataSet;
+        columnIndex = parentColumnIndex;
+        type = storageType;
+        integer = 0;
     }
+
     /**
-     * Returns the raw data contained within this object as a string
+     * Returns the raw data contained within this object as a string, numbers are formatted in the same way SQLite does
      * @return unformatted data
      */
-    std::string getRawData() {
-        return data;
+    std::string getRawData();
+
+    /**
+     * Returns text or blob data without copying it, the view is only valid for as long as the DataSet is
+     * @return the data, or an empty view for null values
+     */
+    std::string_view asStringView();
+
+    /**
+     * @return true if the database returned NULL for this value
+     */
+    bool isNull() {
+        return type == DataStorageType::Null;
+    }
+
+    DataStorageType getStorageType() {
+        return type;
     }
 
     /**
@@ -43,44 +82,111 @@ struct DataContainer {
     }
 
     /**
-     * Formats the data contained within this object as an integer and returns it
+     * Returns the data as a 64-bit integer, text is only parsed when the value was not stored as a number
      * @return
      */
-    int asInteger() {
+    long long asInteger64() {
+
+        switch (type) {
+            case DataStorageType::Integer:
+                return integer;
+            case DataStorageType::Float:
+                return static_cast<long long>(real);
+            case DataStorageType::Null:
+                return 0;
+            default:
+                break;
+        }
+
+        std::string_view data = asStringView();
+        const char *begin = data.data();
+        const char *end = begin + data.size();
+
+        // Leading whitespace and trailing characters are allowed, as they were with std::stoi
+        while (begin != end && std::isspace(static_cast<unsigned char>(*begin))) {
+            begin++;
+        }
 
         if (data.empty()) {
             return 0;
         }
 
-        try {
-            return std::stoi(data);
-        } catch (std::exception &e) {
+        if (begin != end && *begin == '+') {
+            begin++;
+        }
+
+        long long value = 0;
+        auto result = std::from_chars(begin, end, value);
+
+        if (result.ec != std::errc()) {
             std::vector<std::string> error = {
                     "DataContainer.asInteger() called on a datum which does not contain an integer.\n\n",
-                    "Column name: '", columnName, "' \n",
-                    "Value: '", data, "'"
+                    "Column name: '", getColumnName(), "' \n",
+                    "Value: '", std::string(data), "'"
+            };
+            throw DataSetException(Utils::implodeString(error));
+        }
+
+        return value;
+    }
+
+    /**
+     * Formats the data contained within this object as an integer and returns it
+     * @return
+     */
+    int asInteger() {
+
+        long long value = asInteger64();
+
+        if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+            std::vector<std::string> error = {
+                    "DataContainer.asInteger() called on a datum which is too large for an integer.\n\n",
+                    "Column name: '", getColumnName(), "' \n",
+                    "Value: '", getRawData(), "'"
             };
             throw DataSetException(Utils::implodeString(error));
         }
+
+        return static_cast<int>(value);
     }
 
-    float asFloat() {
+    double asDouble() {
+
+        switch (type) {
+            case DataStorageType::Integer:
+                return static_cast<double>(integer);
+            case DataStorageType::Float:
+                return real;
+            case DataStorageType::Null:
+                return 0;
+            default:
+                break;
+        }
+
+        std::string_view data = asStringView();
 
         if (data.empty()) {
             return 0;
         }
 
-        try {
-            return std::stof(data);
-        } catch (std::exception &e) {
+        // Text in the arena is always followed by a terminator, so it can be parsed in place
+        char *parsedEnd = nullptr;
+        double value = std::strtod(data.data(), &parsedEnd);
+
+        if (parsedEnd == data.data()) {
             std::vector<std::string> error = {
-                    "DataContainer.asInteger() called on a datum which does not contain a float value.\n\n",
-                    "Column name: '", columnName, "' \n",
-                    "Value: '", data, "'"
+                    "DataContainer.asFloat() called on a datum which does not contain a float value.\n\n",
+                    "Column name: '", getColumnName(), "' \n",
+                    "Value: '", std::string(data), "'"
             };
             throw DataSetException(Utils::implodeString(error));
         }
 
+        return value;
+    }
+
+    float asFloat() {
+        return static_cast<float>(asDouble());
     }
 
     /**
@@ -89,30 +195,34 @@ struct DataContainer {
      */
     bool asBoolean() {
 
-        if (data.empty()) {
+        if (type == DataStorageType::Null) {
             return false;
         }
 
-        // Validate that we are actually dealing with a boolean in a string...
-        std::vector<std::string> acceptedValues = {"1", "0"};
-
-        if (!Utils::isAcceptedValue(acceptedValues, data, false)) {
-            std::vector<std::string> error {
-                    "DataContainer.asBoolean called on a datum which does not contain a boolean. \n\n",
-                    "Column name: '", columnName, "' \n",
-                    "Value: '", data, "'"
-            };
-            throw DataSetException(Utils::implodeString(error));
+        // Booleans are stored as 1 or 0, which SQLite hands back as integers
+        if (type == DataStorageType::Integer && (integer == 0 || integer == 1)) {
+            return integer == 1;
         }
 
-        return data == "1";
+        std::string_view data = type == DataStorageType::Text ? asStringView() : std::string_view();
 
+        if (type == DataStorageType::Text && (data.empty() || data == "1" || data == "0")) {
+            return data == "1";
+        }
+
+        std::vector<std::string> error {
+                "DataContainer.asBoolean called on a datum which does not contain a boolean. \n\n",
+                "Column name: '", getColumnName(), "' \n",
+                "Value: '", getRawData(), "'"
+        };
+        throw DataSetException(Utils::implodeString(error));
     }
 
     // TODO: Test this function... I got side tracked from something else and wrote it.
     std::string asDate(DateFormat format) {
 
         std::string date;
+        std::string data = getRawData();
 
         if (data.empty()) {
             date = "1970-01-01";
@@ -120,25 +230,24 @@ struct DataContainer {
             date = data;
         }
 
-        std::regex isoDateRegex = std::regex("^([0-9]{4})-([0-9][0-9])-([0-9][0-9])$");
+        // Compiled once rather than on every call
+        static const std::regex isoDateRegex("^([0-9]{4})-([0-9][0-9])-([0-9][0-9])$");
 
         // Ensure that the string at least looks like a date
         if (!std::regex_match(date, isoDateRegex)) {
             std::vector<std::string> error = {
                     "DataContainer.asDate() called on a column which does not contain a date\n\n",
-                    "Column name: '", columnName, "' \n",
+                    "Column name: '", getColumnName(), "' \n",
                     "Data: ", date, "'\n"
             };
 
             throw DataSetException(Utils::implodeString(error));
         }
 
-        // Ensure that the values of each part of the date are in range
-        std::vector<std::string> datePortions = Utils::explodeString(date, '-');
-
-        int year = std::stoi(datePortions[0]);
-        int month = std::stoi(datePortions[1]);
-        int day = std::stoi(datePortions[2]);
+        // The regex guarantees the position and length of each part of the date
+        int year = std::stoi(date.substr(0, 4));
+        int month = std::stoi(date.substr(5, 2));
+        int day = std::stoi(date.substr(8, 2));
 
         // Initial range validation
         bool validDate = (month > 0 && month <=12) && (day > 0 && day <= 31);
@@ -146,7 +255,7 @@ struct DataContainer {
         if (!validDate) {
             std::vector<std::string> error = {
                     "DataContainer.asDate() called on a date which is out of range (Month or day out of range) \n\n",
-                    "Column name: '", columnName, "'\n",
+                    "Column name: '", getColumnName(), "'\n",
                     "Data: ", date, "'\n"
             };
             throw DataSetException(Utils::implodeString(error));
@@ -161,7 +270,7 @@ struct DataContainer {
         if (day > monthLength) {
             std::vector<std::string> error = {
                     "DataContainer.asDate() called on a date which is out of range (More days than the length of the month) \n\n",
-                    "Column name: '", columnName,"'",
+                    "Column name: '", getColumnName(),"'",
                     "Data: '", date, "'\n"
             };
         }
@@ -174,32 +283,45 @@ struct DataContainer {
         }
     }
 private:
-    std::string data;
-    std::string columnName; // Used for printing errors
+    friend struct DataSetColumn;
+    friend struct DataSet;
+
+    DataSet *owner;
+    int columnIndex;
+    DataStorageType type;
+
+    struct ArenaSlice {
+        unsigned int offset;
+        unsigned int length;
+    };
+
+    union {
+        long long integer;
+        double real;
+        ArenaSlice text;
+    };
+
+    std::string getColumnName(); // Used for printing errors
 };
 
 // Data set related stuff
 struct DataSetColumn {
 public:
-    DataSetColumn(std::string cName, std::string cData, bool isNull) {
-        name = std::move(cName);
-        dataContainer = new DataContainer(cData, name, isNull);
+    DataSetColumn(DataSet *owner, int columnIndex, DataStorageType type) : dataContainer(owner, columnIndex, type) {
     };
 
-    ~DataSetColumn() {
-        delete(dataContainer);
-    };
-
-    std::string getName() {
-        return name;
+    DataContainer &getContainer() {
+        return dataContainer;
     }
 
+    std::string getName();
+
     /**
      * Returns the DataContainer object containing the data in this column
      * @return - DataContainer object
      */
     DataContainer* getData() {
-        return dataContainer;
+        return &dataContainer;
     }
 
     /**
@@ -208,176 +330,128 @@ public:
      */
     std::string getRawData() {
         // TODO: Remove this function when all usages have been changed
-        return dataContainer->getRawData();
+        return dataContainer.getRawData();
     }
 
 private:
-    std::string name;
-    DataContainer *dataContainer;
+    DataContainer dataContainer;
 };
 
+/**
+ * A row is only a view onto a run of cells inside the owning DataSet, column names are stored once per data set
+ */
 struct DataSetRow {
 public:
-    DataSetRow() {
-        for (auto &emptyColumn : column) {
-            emptyColumn = nullptr;
-        }
+    DataSetRow(DataSet *ownerDataSet, unsigned int firstCellIndex) {
+        owner = ownerDataSet;
+        firstCell = firstCellIndex;
     };
 
-    ~DataSetRow() {
-        for (auto &currentColumn : column) {
-            delete currentColumn;
-        }
-    };
+    DataSetColumn *getColumn(int index);
 
-    /**
-     * Adds a column to the row
-     *
-     * @param name
-     * @param data
-     * @return
-     */
-    DataSetColumn *addColumn(const std::string &name, const std::string &data, bool isNull) {
+    DataSetColumn *getColumn(const std::string &name);
 
-        if (name.empty()) {
-            return nullptr;
-        }
+    bool doesColumnExist(const std::string &name);
 
-        for (auto &potentialNewColumn : column) {
-            if (!potentialNewColumn) {
-                potentialNewColumn = new DataSetColumn(name, data, isNull);
-                return potentialNewColumn;
-            }
-        }
+    void debugOutputContents();
 
-        return nullptr;
-    }
+private:
+    friend struct DataSet;
 
-    /**
-     * Returns a column from the row with the given index
-     *
-     * @param index
-     * @return
-     */
-    DataSetColumn *getColumn(int index) {
+    DataSet *owner;
+    unsigned int firstCell;
+};
 
-        // Throw an exception when this column does not exist so that we never can end up with null pointer errors.
-        if (!column[index]) {
-            std::vector<std::string> errorVector = {
-              "No column with index ",
-              std::to_string(index),
-              "was found"
-            };
-            throw DataSetException(std::string(Utils::implodeString(errorVector)));
-        }
-        return column[index];
-    }
+/**
+ * The result of a query. Values are packed into a single arena, and cells and rows are stored contiguously, so the
+ * number of rows is only limited by memory.
+ */
+struct DataSet {
+public:
+    DataSet() = default;
 
-    /**
-     * Returns a column from the row with the given name
-     *
-     * @param name
-     * @return
-     */
-    DataSetColumn *getColumn(const std::string &name) {
-        for (int i = 0; i < DATA_SET_MAX_COLUMNS; i++) {
-            if (column[i]) {
-                if (column[i]->getName() == name) {
-                    return getColumn(i);
-                }
-            }
-        }
+    DataSet(const DataSet &) = delete;
 
-        // No column with this name found - throw an error.
-        std::vector<std::string> errorVector = {
-                "No column with name '",
-                name,
-                "' was found"
-        };
+    DataSet &operator=(const DataSet &) = delete;
 
-        throw DataSetException(Utils::implodeString(errorVector));
-    }
+    void clear() {
+        columnNames.clear();
+        columnIndexes.clear();
+        cells.clear();
+        rows.clear();
+        arena.clear();
+    };
 
     /**
-     * Returns true if a column with the given name exists in this row
+     * Sets the names of the columns in the result, this must be called before any rows are added
      *
-     * @param name
-     * @return
+     * @param names
      */
-    bool doesColumnExist(const std::string &name) {
-        for (auto &currentColumn : column) {
-            if (currentColumn) {
-                if (currentColumn->getName() == name) {
-                    return true;
-                }
-            }
-        }
+    void setColumns(const std::vector<std::string> &names) {
+
+        columnNames = names;
+        columnIndexes.clear();
 
-        return false;
+        for (unsigned int i = 0; i < columnNames.size(); i++) {
+            // When names are repeated, the first column with that name wins
+            columnIndexes.emplace(columnNames[i], i);
+        }
     }
 
     /**
-     * Outputs the content of the row to the console
+     * Adds a row to the data set, its values must then be added in column order with addInteger, addFloat, addText,
+     * addBlob or addNull
+     *
+     * @return Pointer to the newly-created row, this is only valid until the next row is added
      */
-    void debugOutputContents() {
-
-        for (auto &currentColumn : column) {
-            if (currentColumn) {
-                std::cout << "Column: " << currentColumn->getName() << " | " << currentColumn->getRawData();
-                std::cout << std::endl;
-            }
-        }
-
+    DataSetRow *addRow() {
+        rows.emplace_back(this, static_cast<unsigned int>(cells.size()));
+        return &rows.back();
     }
 
-private:
-    DataSetColumn *column[DATA_SET_MAX_COLUMNS]{};
-};
-
-struct DataSet {
-public:
-    DataSet() {
-
-        for (auto &emptyRow : row) {
-            emptyRow = nullptr;
-        }
-
-        rowCount = 0;
-
-    };
+    void addInteger(long long value) {
+        addCell(DataStorageType::Integer).integer = value;
+    }
 
-    ~DataSet() {
+    void addFloat(double value) {
+        addCell(DataStorageType::Float).real = value;
+    }
 
-        for (auto &currentRow : row) {
-            delete currentRow;
-        }
+    void addText(const char *data, unsigned int length) {
+        addArenaValue(DataStorageType::Text, data, length);
+    }
 
-    };
+    void addBlob(const void *data, unsigned int length) {
+        addArenaValue(DataStorageType::Blob, static_cast<const char *>(data), length);
+    }
 
-    void clear() {
-        for (auto &currentRow : row) {
-            delete currentRow;
-            currentRow = nullptr;
-        }
-    };
+    void addNull() {
+        addCell(DataStorageType::Null);
+    }
 
     /**
-     * Adds a row to the data set
+     * Returns the index of the column with the given name so that it can be looked up once per query
      *
-     * @return Pointer to the newly-created row
+     * @param name
+     * @return The column index, or -1 when there is no such column
      */
-    DataSetRow *addRow() {
+    int getColumnIndex(const std::string &name) {
+
+        auto column = columnIndexes.find(name);
 
-        for (auto &currentRow : row) {
-            if (!currentRow) {
-                currentRow = new DataSetRow();
-                rowCount++;
-                return currentRow;
-            }
+        if (column == columnIndexes.end()) {
+            return -1;
         }
 
-        return nullptr;
+        return column->second;
+    }
 
+    std::string getColumnName(int index) {
+        return columnNames[index];
+    }
+
+    int getColumnCount() {
+        return static_cast<int>(columnNames.size());
     }
 
     /**
@@ -385,20 +459,10 @@ public:
      */
     void debugOutputContents() {
 
-        int rows = 0;
-
-        for (auto &currentRow : row) {
-            if (currentRow) {
-                rows++;
-            }
-        }
-
-        std::cout << "Contents of DataSet -  Rows: " << rows << std::endl;
+        std::cout << "Contents of DataSet -  Rows: " << rows.size() << std::endl;
 
-        for (auto &currentRow : row) {
-            if (currentRow) {
-                currentRow->debugOutputContents();
-            }
+        for (auto &currentRow : rows) {
+            currentRow.debugOutputContents();
         }
     }
 
@@ -406,7 +470,7 @@ public:
      * @return count of rows within the data set
      */
     int getRowCount() {
-        return rowCount;
+        return static_cast<int>(rows.size());
     }
 
     /**
@@ -416,7 +480,7 @@ public:
      */
     DataSetRow *getRow(int index) {
 
-        if (!row[index]) {
+        if (index < 0 || index >= getRowCount()) {
             std::vector<std::string> errorVector = {
                     "A row with index ",
                     std::to_string(index),
@@ -425,18 +489,168 @@ public:
 
             throw DataSetException(Utils::implodeString(errorVector));
         }
-        return row[index];
+        return &rows[index];
     }
 
 private:
-    DataSetRow *row[DATA_SET_MAX_ROWS]{};
-    int rowCount;
+    friend struct DataContainer;
+    friend struct DataSetRow;
+
+    std::vector<std::string> columnNames;
+    std::unordered_map<std::string, int> columnIndexes;
+    std::vector<DataSetColumn> cells;
+    std::vector<DataSetRow> rows;
+    std::vector<char> arena;
+
+    /**
+     * Adds a cell to the row which was last added
+     *
+     * @param type
+     * @return The cell's container, so that the value can be filled in
+     */
+    DataContainer &addCell(DataStorageType type) {
+        int columnIndex = static_cast<int>(cells.size() - rows.back().firstCell);
+        cells.emplace_back(this, columnIndex, type);
+        return cells.back().getContainer();
+    }
+
+    /**
+     * Copies text or blob data into the arena, followed by a terminator so that text can be parsed in place
+     *
+     * @param type
+     * @param data
+     * @param length
+     */
+    void addArenaValue(DataStorageType type, const char *data, unsigned int length) {
+
+        DataContainer &container = addCell(type);
+        container.text.offset = static_cast<unsigned int>(arena.size());
+        container.text.length = data ? length : 0;
+
+        if (data && length > 0) {
+            arena.insert(arena.end(), data, data + length);
+        }
+
+        arena.push_back('\0');
+    }
 };
 
+inline std::string DataContainer::getRawData() {
+
+    switch (type) {
+        case DataStorageType::Integer:
+            return std::to_string(integer);
+        case DataStorageType::Float: {
+            // Matches the text SQLite itself returns for a REAL value
+            char buffer[32];
+            sqlite3_snprintf(sizeof(buffer), buffer, "%!.15g", real);
+            return buffer;
+        }
+        case DataStorageType::Null:
+            return "";
+        default:
+            return std::string(asStringView());
+    }
+}
+
+inline std::string_view DataContainer::asStringView() {
+
+    if (type == DataStorageType::Null) {
+        return std::string_view();
+    }
+
+    if (type != DataStorageType::Text && type != DataStorageType::Blob) {
+        std::vector<std::string> error = {
+                "DataContainer.asStringView() called on a numeric datum, getRawData() must be used instead.\n\n",
+                "Column name: '", getColumnName(), "'"
+        };
+        throw DataSetException(Utils::implodeString(error));
+    }
+
+    return std::string_view(owner->arena.data() + text.offset, text.length);
+}
+
+inline std::string DataContainer::getColumnName() {
+    return owner->getColumnName(columnIndex);
+}
+
+inline std::string DataSetColumn::getName() {
+    return dataContainer.getColumnName();
+}
+
+/**
+ * Returns a column from the row with the given index
+ *
+ * @param index
+ * @return
+ */
+inline DataSetColumn *DataSetRow::getColumn(int index) {
+
+    // Throw an exception when this column does not exist so that we never can end up with null pointer errors.
+    if (index < 0 || index >= owner->getColumnCount()) {
+        std::vector<std::string> errorVector = {
+                "No column with index ",
+                std::to_string(index),
+                "was found"
+        };
+        throw DataSetException(std::string(Utils::implodeString(errorVector)));
+    }
+
+    return &owner->cells[firstCell + index];
+}
+
+/**
+ * Returns a column from the row with the given name
+ *
+ * @param name
+ * @return
+ */
+inline DataSetColumn *DataSetRow::getColumn(const std::string &name) {
+
+    int index = owner->getColumnIndex(name);
+
+    if (index != -1) {
+        return getColumn(index);
+    }
+
+    // No column with this name found - throw an error.
+    std::vector<std::string> errorVector = {
+            "No column with name '",
+            name,
+            "' was found"
+    };
+
+    throw DataSetException(Utils::implodeString(errorVector));
+}
+
+/**
+ * Returns true if a column with the given name exists in this row
+ *
+ * @param name
+ * @return
+ */
+inline bool DataSetRow::doesColumnExist(const std::string &name) {
+    return owner->getColumnIndex(name) != -1;
+}
+
+/**
+ * Outputs the content of the row to the console
+ */
+inline void DataSetRow::debugOutputContents() {
+
+    for (int i = 0; i < owner->getColumnCount(); i++) {
+        std::cout << "Column: " << owner->getColumnName(i) << " | " << getColumn(i)->getRawData();
+        std::cout << std::endl;
+    }
+
+}
+
 class DatabaseConnection {
 public:
     explicit DatabaseConnection(const std::string &name);
 
+    DatabaseConnection(const std::string &name, const DatabaseConnectionProfile &profile);
+
     ~DatabaseConnection();
 
     void executeQuery(const std::string &query, DataSet *destinationDataSet);
@@ -448,8 +662,25 @@ public:
     int insert(const std::string &tableName, const std::vector<std::string> &columns,
                std::vector<std::string> &values, std::vector<int> types);
 
+    int insert(const std::string &tableName, const std::vector<std::string> &columns,
+               std::vector<std::vector<std::string>> &rows, std::vector<int> types);
+
     int insert(const std::string &tableName);
 
+    PreparedStatement *prepare(const std::string &query);
+
+    void beginTransaction();
+
+    void commitTransaction();
+
+    void rollbackTransaction();
+
+    bool isInTransaction() {
+        return transactionDepth > 0;
+    }
+
+    void setPragma(const std::string &pragma, const std::string &value);
+
     bool isUsable() {
         return usable;
     }
@@ -460,8 +691,14 @@ private:
     char *zErrMsg;
     int rc;
     bool usable;
+    int transactionDepth;
+    std::unordered_map<std::string, std::vector<PreparedStatement *>> statementCache;
+
+    static int openReadOnly(const std::string &filename, sqlite3 **connection);
+
+    int openInMemory(const std::string &filename);
 
-    static std::string sanitizeString(const std::string &string);
+    static void bindValue(PreparedStatement *statement, int index, const std::string &value, int type);
 };
 
 #endif
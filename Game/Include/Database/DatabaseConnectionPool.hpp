@@ -0,0 +1,85 @@
+#ifndef DATABASE_CONNECTION_POOL_INCLUDED
+#define DATABASE_CONNECTION_POOL_INCLUDED
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include "Database/DatabaseConnection.hpp"
+#include "Database/DatabaseConnectionProfile.hpp"
+
+class DatabaseConnectionPool;
+
+/**
+ * A connection checked out of a pool, it is returned to the pool when this goes out of scope.
+ * A DatabaseConnection is not thread safe, so a checked out connection must only be used by the thread holding it.
+ */
+class PooledConnection {
+public:
+    PooledConnection(DatabaseConnectionPool *ownerPool, DatabaseConnection *pooledConnection);
+
+    PooledConnection(PooledConnection &&other) noexcept;
+
+    ~PooledConnection();
+
+    PooledConnection(const PooledConnection &) = delete;
+
+    PooledConnection &operator=(const PooledConnection &) = delete;
+
+    DatabaseConnection *get() {
+        return connection;
+    }
+
+    DatabaseConnection *operator->() {
+        return connection;
+    }
+
+private:
+    DatabaseConnectionPool *pool;
+    DatabaseConnection *connection;
+};
+
+/**
+ * Hands out connections to a single database file so that several threads can read from it at once.
+ *
+ * Readers are opened with the pool's profile, new ones are only opened when every existing connection is checked out,
+ * and once poolSize connections exist further checkouts wait for one to be returned.
+ * A pool opened in memory keeps a single connection, as each connection would hold its own copy of the database.
+ */
+class DatabaseConnectionPool {
+public:
+    DatabaseConnectionPool(const std::string &databaseName, const DatabaseConnectionProfile &connectionProfile);
+
+    ~DatabaseConnectionPool();
+
+    DatabaseConnectionPool(const DatabaseConnectionPool &) = delete;
+
+    DatabaseConnectionPool &operator=(const DatabaseConnectionPool &) = delete;
+
+    static DatabaseConnectionPool *getRuntimePool(const std::string &databaseName);
+
+    PooledConnection checkout();
+
+    PooledConnection tryCheckout();
+
+    DatabaseConnection *acquire();
+
+    void release(DatabaseConnection *connection);
+
+private:
+    friend class PooledConnection;
+
+    std::string name;
+    DatabaseConnectionProfile profile;
+    int maxConnections;
+
+    std::mutex poolMutex;
+    std::condition_variable connectionReturned;
+    std::vector<DatabaseConnection *> connections;
+    std::vector<DatabaseConnection *> idleConnections;
+
+    DatabaseConnection *openConnection();
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef DATABASE_CONNECTION_PROFILE_INCLUDED
+#define DATABASE_CONNECTION_PROFILE_INCLUDED
+
+#include <string>
+
+// Defaults used by the runner when the config file does not set them
+#define DATABASE_DEFAULT_MMAP_SIZE 268435456 // 256MB, SQLite only maps as much of the file as exists
+#define DATABASE_DEFAULT_CACHE_SIZE_KIB 16384
+#define DATABASE_DEFAULT_POOL_SIZE 4
+
+/**
+ * How a database file is opened
+ *
+ * ReadWrite - A normal connection, this is what the compiler uses
+ * ReadOnly  - Opened read-only and immutable, so no locks are taken and no journal is checked, reads use mmap
+ * Memory    - The whole file is copied into an in-memory database when it is opened, the file is then closed. Pools
+ *             keep a single connection in this mode
+ */
+enum class DatabaseOpenMode {
+    ReadWrite, ReadOnly, Memory
+};
+
+/**
+ * The settings a DatabaseConnection is opened with. The runner's settings come from config.json, and can be
+ * overridden with the --database-mode parameter so that startup can be compared under each mode.
+ */
+struct DatabaseConnectionProfile {
+    DatabaseOpenMode mode = DatabaseOpenMode::ReadWrite;
+    long long mmapSize = 0;
+    int cacheSizeKiB = 0;
+    int poolSize = 1; // Most read connections a DatabaseConnectionPool will open at once
+
+    static DatabaseConnectionProfile *getRuntimeProfile();
+
+    static void setRuntimeProfile(const DatabaseConnectionProfile &profile);
+
+    static void overrideRuntimeMode(DatabaseOpenMode mode);
+
+    static bool parseMode(const std::string &name, DatabaseOpenMode &mode);
+
+    static std::string getModeName(DatabaseOpenMode mode);
+
+private:
+    static bool modeOverridden;
+};
+
+#endif
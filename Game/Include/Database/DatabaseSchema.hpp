@@ -18,6 +18,7 @@
 #define MAX_COLUMNS 0xFF
 
 #include <iostream>
+#include <vector>
 
 enum ColumnType {
     tText, tInteger, tDouble, tDate, tTimestamp, tBoolean
@@ -41,12 +42,16 @@ public:
 
     std::string getCreationQuery();
 
+    void setForeignKey(const std::string &foreignTableName, const std::string &foreignColumnName);
+
 private:
     std::string name;
     ColumnType type;
     bool primaryKey;
     bool notNull;
     std::string defaultValue;
+    std::string foreignTable;
+    std::string foreignColumn;
 };
 
 class DatabaseTable {
@@ -61,15 +66,21 @@ public:
     DatabaseColumn *addPrimaryKey();
 
     DatabaseColumn *
-    addForeignKey(const std::string &cName, const std::string &foreignTableName, const std::string &foreignTableId);
+    addForeignKey(const std::string &cName, const std::string &foreignTableName, const std::string &foreignTableId,
+                  bool cNotNull);
+
+    void addIndex(const std::vector<std::string> &columnNames);
 
     void outputTableInfo();
 
     std::string getCreationQuery();
 
+    std::vector<std::string> getIndexCreationQueries();
+
 private:
     std::string name;
     DatabaseColumn *column[MAX_COLUMNS]{};
+    std::vector<std::vector<std::string>> indexes;
 
     DatabaseColumn *
     addColumnInternal(const std::string &cName, ColumnType cType, bool cNotNull, const std::string &cDefaultValue,
@@ -0,0 +1,38 @@
+#ifndef DATABASE_TRANSACTION_INCLUDED
+#define DATABASE_TRANSACTION_INCLUDED
+
+#include "Database/DatabaseConnection.hpp"
+
+/**
+ * Begins a transaction on a connection for as long as this object exists.
+ * If commit() is not called before it goes out of scope (e.g. an exception was thrown), everything is rolled back.
+ */
+class DatabaseTransaction {
+public:
+    explicit DatabaseTransaction(DatabaseConnection *connection) {
+        db = connection;
+        finished = false;
+        db->beginTransaction();
+    }
+
+    ~DatabaseTransaction() {
+        if (!finished) {
+            db->rollbackTransaction();
+        }
+    }
+
+    DatabaseTransaction(const DatabaseTransaction &) = delete;
+
+    DatabaseTransaction &operator=(const DatabaseTransaction &) = delete;
+
+    void commit() {
+        db->commitTransaction();
+        finished = true;
+    }
+
+private:
+    DatabaseConnection *db;
+    bool finished;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef PREPARED_STATEMENT_INCLUDED
+#define PREPARED_STATEMENT_INCLUDED
+
+#include <sqlite3.h>
+#include <string>
+
+struct DataSet;
+
+/**
+ * A compiled SQL statement which can be executed many times with different parameters.
+ * Values are bound through sqlite3_bind_* so they never need to be escaped or concatenated into the query string.
+ *
+ * Statements created through DatabaseConnection::prepare are owned and cached by the connection, so they must not be deleted.
+ */
+class PreparedStatement {
+public:
+    PreparedStatement(sqlite3 *database, const std::string &queryString);
+
+    ~PreparedStatement();
+
+    PreparedStatement *bind(int index, int value);
+
+    PreparedStatement *bind(int index, sqlite3_int64 value);
+
+    PreparedStatement *bind(int index, double value);
+
+    PreparedStatement *bind(int index, const std::string &value);
+
+    PreparedStatement *bind(int index, const char *value);
+
+    PreparedStatement *bindNull(int index);
+
+    void execute(DataSet *destinationDataSet);
+
+    int execute();
+
+    std::string getQuery() {
+        return query;
+    }
+
+    /**
+     * @return true while a cursor is reading from this statement, in which case it cannot be executed again
+     */
+    bool isBusy() {
+        return inUse || (statement && sqlite3_stmt_busy(statement));
+    }
+
+private:
+    friend class QueryCursor;
+
+    sqlite3 *db;
+    sqlite3_stmt *statement;
+    std::string query;
+    bool inUse;
+
+    void reset();
+
+    void recordExecution(double milliseconds, int rows);
+
+    void checkBindResult(int result, int index);
+
+    void throwError();
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef QUERY_CURSOR_INCLUDED
+#define QUERY_CURSOR_INCLUDED
+
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Database/PreparedStatement.hpp"
+
+/**
+ * A forward-only cursor over the results of a prepared statement. Each row is read straight from SQLite as it is
+ * stepped to, so nothing is copied unless the caller asks for a std::string.
+ *
+ * Values returned by getText are only valid until the cursor moves to the next row.
+ * The statement is reset when the cursor is destroyed, so it can be reused even if not every row was read.
+ */
+class QueryCursor {
+public:
+    explicit QueryCursor(PreparedStatement *preparedStatement);
+
+    ~QueryCursor();
+
+    QueryCursor(const QueryCursor &) = delete;
+
+    QueryCursor &operator=(const QueryCursor &) = delete;
+
+    bool next();
+
+    int getColumnIndex(const std::string &name);
+
+    bool doesColumnExist(const std::string &name);
+
+    bool isNull(int column);
+
+    bool isNull(const std::string &name);
+
+    long long getInteger64(int column);
+
+    long long getInteger64(const std::string &name);
+
+    int getInteger(int column);
+
+    int getInteger(const std::string &name);
+
+    float getFloat(int column);
+
+    float getFloat(const std::string &name);
+
+    bool getBoolean(int column);
+
+    bool getBoolean(const std::string &name);
+
+    std::string_view getText(int column);
+
+    std::string_view getText(const std::string &name);
+
+    std::string getString(int column);
+
+    std::string getString(const std::string &name);
+
+private:
+    PreparedStatement *statement;
+    sqlite3_stmt *handle;
+    std::unordered_map<std::string, int> columnIndexes;
+    bool hasRow;
+    bool finished;
+    bool profiling;
+    int rowCount;
+    double stepMilliseconds;
+
+    int requireColumn(const std::string &name);
+
+    void checkRow(int column);
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef QUERY_PROFILER_INCLUDED
+#define QUERY_PROFILER_INCLUDED
+
+#include <sqlite3.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define QUERY_PROFILER_REPORT_FILE "query_profile.log"
+
+// Queries with the same shape which are run at least this many times are reported as likely N+1 patterns
+#define QUERY_PROFILER_N_PLUS_ONE_THRESHOLD 10
+
+struct QueryProfile {
+    std::string query;
+    int count = 0;
+    double totalMilliseconds = 0;
+    double maxMilliseconds = 0;
+    long rows = 0;
+    std::string queryPlan;
+};
+
+/**
+ * Records how often each query is run and how long it takes, for every DatabaseConnection in the program.
+ * This is disabled by default, it is enabled with the --profile-queries parameter on the runner.
+ *
+ * Queries are grouped by their normalised text, so queries which only differ by their literal values are counted together.
+ * The report is written to query_profile.log when the program exits, or when writeReport is called.
+ */
+class QueryProfiler {
+public:
+    static QueryProfiler *getInstance();
+
+    ~QueryProfiler();
+
+    void enable(bool captureQueryPlans);
+
+    /**
+     * Checked before any timing is done, so that there is no cost when the profiler is not in use
+     * @return
+     */
+    static bool isEnabled() {
+        return enabled;
+    }
+
+    void record(sqlite3 *db, const std::string &query, double milliseconds, int rows);
+
+    void writeReport();
+
+    void writeReport(std::ostream &output);
+
+    static std::string normaliseQuery(const std::string &query);
+
+private:
+    QueryProfiler();
+
+    static std::atomic<bool> enabled;
+
+    bool explainQueries;
+    bool reportWritten;
+    std::mutex profileMutex;
+    std::unordered_map<std::string, QueryProfile> profiles;
+
+    static std::string getQueryPlan(sqlite3 *db, const std::string &query);
+};
+
+#endif
@@ -1,9 +1,13 @@
 #ifndef CHAPTER_BUILDER_INCLUDED
 #define CHAPTER_BUILDER_INCLUDED
 
+#include <unordered_map>
+#include "GameCompiler/RequirementCompiler.hpp"
+
 class ChapterBuilder {
 public:
-    ChapterBuilder(const std::string &fileName, DatabaseConnection *novelDb, JsonHandler *fileHandler);
+    ChapterBuilder(const std::string &fileName, DatabaseConnection *novelDb, JsonHandler *fileHandler,
+                   std::unordered_map<std::string, int> *stateGroupIds, RequirementCompiler *requirements);
 
     ~ChapterBuilder();
 
@@ -17,9 +21,17 @@ private:
 
     void processSceneSegment(json sceneSegmentJson, int sceneId);
 
-    void processLine(json lineJson, int sceneSegmentId);
+    void processLine(json lineJson, int sceneSegmentId, std::vector<std::vector<std::string>> &lineRows);
+
+    static std::string makeStringKey(const std::string &text);
 
     JsonHandler *fHandler;
+
+    // Ids of the character state groups written so far, keyed by the ids of the sprites they show. Shared between chapters
+    std::unordered_map<std::string, int> *characterStateGroupIds;
+
+    // Shared between chapters, it knows every flag declared in project.json
+    RequirementCompiler *requirementCompiler;
 };
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
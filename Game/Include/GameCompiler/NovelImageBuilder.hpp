@@ -0,0 +1,57 @@
+#ifndef NOVEL_IMAGE_BUILDER_INCLUDED
+#define NOVEL_IMAGE_BUILDER_INCLUDED
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Database/DatabaseConnection.hpp"
+#include "Misc/NovelImageFormat.hpp"
+
+/**
+ * Writes the novel image (see NovelImageFormat.hpp) from a compiled novel database.
+ * Each table is read with a single query in the order it is played, so the children of every record are contiguous.
+ */
+class NovelImageBuilder {
+public:
+    explicit NovelImageBuilder(DatabaseConnection *novelDb);
+
+    ~NovelImageBuilder();
+
+    void write(const std::string &path);
+
+private:
+    DatabaseConnection *novel;
+
+    std::vector<NovelImageChapter> chapters;
+    std::vector<NovelImageScene> scenes;
+    std::vector<NovelImageSceneSegment> sceneSegments;
+    std::vector<NovelImageSegmentLine> segmentLines;
+    std::vector<uint32_t> segmentLineIndexById;
+    std::vector<NovelImageCharacterStateGroup> characterStateGroups;
+    std::vector<NovelImageCharacterState> characterStates;
+    std::vector<NovelImageMusicPlaybackRequest> musicPlaybackRequests;
+    std::vector<NovelImageSceneSegmentJump> sceneSegmentJumps;
+    std::string strings;
+
+    std::unordered_map<std::string, NovelImageString> stringIndex;
+    std::unordered_map<int, uint32_t> characterStateGroupIndex;
+    std::unordered_map<int, uint32_t> musicPlaybackRequestIndex;
+
+    void readCharacterStateGroups();
+
+    void readMusicPlaybackRequests();
+
+    void readChapters();
+
+    void readScenes();
+
+    void readSceneSegments();
+
+    void readSegmentLines();
+
+    void readSceneSegmentJumps();
+
+    NovelImageString addString(const std::string &value);
+};
+
+#endif
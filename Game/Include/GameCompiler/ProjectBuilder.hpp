@@ -1,3 +1,5 @@
+#include <unordered_map>
+
 // TODO: Move this - I have no clue what I was thinking last weekend.
 class GameCompilerOptions {
 public:
@@ -20,11 +22,16 @@ class ProjectBuilder {
     ProjectBuilder(std::string fileName, DatabaseConnection *novelDb, DatabaseConnection *resourceDb, JsonHandler *fileHandler);
     ~ProjectBuilder();
     void process();
+    std::string getProjectDirectory() {
+      return projectPath;
+    }
   private:
     std::string projectFileName;
     std::string projectPath;
     DatabaseConnection *novel;
     DatabaseConnection *resource;
     void processCharacters();
+    void processLocales(json localesJson);
     JsonHandler *fHandler;
+    std::unordered_map<std::string, int> characterStateGroupIds;
 };
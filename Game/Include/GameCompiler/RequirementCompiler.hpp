@@ -0,0 +1,59 @@
+#ifndef REQUIREMENT_COMPILER_INCLUDED
+#define REQUIREMENT_COMPILER_INCLUDED
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include "Database/DatabaseConnection.hpp"
+
+/**
+ * Numbers the story flags and counters declared in project.json, and compiles the requirements and flag changes which
+ * refer to them by name into the flat form the runner evaluates (see NovelRequirementFormat.hpp).
+ *
+ * Flags and counters are declared in the 'flags' attribute of project.json:
+ *
+ *     "flags": [{"name": "metAlice"}, {"name": "aliceAffection", "counter": true, "default": 2}]
+ *
+ * A requirement is either the name of a flag, which must be set, true or false, or an object: {"not": requirement},
+ * {"all": [requirements]}, {"any": [requirements]} or {"counter": name, "atLeast": n, "atMost": n, "equals": n} with
+ * any of the comparisons.
+ */
+class RequirementCompiler {
+public:
+    explicit RequirementCompiler(DatabaseConnection *novelDb);
+
+    ~RequirementCompiler();
+
+    void processFlags(const nlohmann::json &flagsJson);
+
+    int compile(const nlohmann::json &requirementJson, const std::string &owner);
+
+    void compileFlagChanges(int sceneSegmentId, const nlohmann::json &sceneSegmentJson, const std::string &owner);
+
+    int getFlagIndex(const std::string &name, bool counter, const std::string &owner);
+
+private:
+    struct CompiledTerm {
+        int opcode;
+        int operand;
+        int value;
+    };
+
+    struct DeclaredFlag {
+        bool counter;
+        int index;
+    };
+
+    DatabaseConnection *novel;
+
+    std::unordered_map<std::string, DeclaredFlag> flags;
+    int flagCount;
+    int counterCount;
+
+    int compileTerms(const nlohmann::json &requirementJson, const std::string &owner, std::vector<CompiledTerm> &terms);
+
+    DeclaredFlag findFlag(const std::string &name, bool counter, const std::string &owner);
+};
+
+#endif
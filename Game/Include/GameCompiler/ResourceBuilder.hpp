@@ -16,6 +16,8 @@ private:
   void processSprites();
   void processFonts();
   void processMusic();
+  void processScripts();
+  int insertResource(const std::string &tableName, const std::string &name, const std::string &fileName, bool enabled);
 };
 
 #endif
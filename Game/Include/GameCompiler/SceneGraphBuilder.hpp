@@ -0,0 +1,74 @@
+#ifndef SCENE_GRAPH_BUILDER_INCLUDED
+#define SCENE_GRAPH_BUILDER_INCLUDED
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Database/DatabaseConnection.hpp"
+
+/**
+ * Resolves where the story goes at the end of every scene segment, and writes it to the scene_segment_jumps table.
+ *
+ * Chapters, scenes and segments can be given a 'label', and a 'next' naming the label which the story jumps to once
+ * they have finished. Anything without a 'next' carries on to whatever follows it in the project, the end of the last
+ * chapter is the end of the story. Each jump is written as the position of the segment it leads to (the index of its
+ * chapter, of the scene within the chapter and of the segment within the scene) so the runner never has to find it.
+ * The branches of segments, which name a label in the same way, are resolved into positions as well.
+ */
+class SceneGraphBuilder {
+public:
+    explicit SceneGraphBuilder(DatabaseConnection *novelDb);
+
+    ~SceneGraphBuilder();
+
+    void process();
+
+private:
+    struct GraphPosition {
+        int chapter;
+        int scene;
+        int sceneSegment;
+    };
+
+    struct GraphSceneSegment {
+        int id;
+        std::string label;
+        std::string nextLabel;
+    };
+
+    struct GraphScene {
+        int id;
+        std::string label;
+        std::string nextLabel;
+        std::vector<GraphSceneSegment> sceneSegments;
+    };
+
+    struct GraphChapter {
+        int id;
+        std::string title;
+        std::string label;
+        std::string nextLabel;
+        std::vector<GraphScene> scenes;
+    };
+
+    DatabaseConnection *novel;
+
+    std::vector<GraphChapter> chapters;
+    std::unordered_map<std::string, GraphPosition> labels;
+
+    void readChapters();
+
+    void readScenes();
+
+    void readSceneSegments();
+
+    void resolveBranches();
+
+    void addLabel(const std::string &label, GraphPosition position, const std::string &owner);
+
+    GraphPosition findLabel(const std::string &label, const std::string &owner);
+
+    GraphPosition findFallThrough(int chapterIndex, int sceneIndex, int sceneSegmentIndex);
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef SCRIPT_COMPILER_INCLUDED
+#define SCRIPT_COMPILER_INCLUDED
+
+#include <string>
+#include <unordered_set>
+#include "Database/DatabaseConnection.hpp"
+#include "GameCompiler/RequirementCompiler.hpp"
+#include "GameCompiler/ScriptParser.hpp"
+
+/**
+ * Compiles the scripts listed in the resource database's scripts table (see ResourceBuilder::processScripts) into the
+ * bytecode the runner executes, and checks that the scene segments which start a script start one which exists.
+ *
+ * Scripts are read from resource/Scripts/, and are compiled once the flags and characters they refer to by name have
+ * been written.
+ */
+class ScriptCompiler {
+public:
+    ScriptCompiler(DatabaseConnection *resourceDb, DatabaseConnection *novelDb, const std::string &projectDirectory,
+                   RequirementCompiler *requirementCompiler);
+
+    ~ScriptCompiler();
+
+    void process();
+
+    void checkSegmentScripts();
+
+private:
+    DatabaseConnection *resource;
+    DatabaseConnection *novel;
+    std::string scriptDirectory;
+    RequirementCompiler *requirements;
+    std::unordered_set<std::string> scriptNames; // Every enabled script which has been compiled
+
+    void compile(int scriptId, const std::string &name, const std::string &fileName);
+
+    int findOperandValue(const CompiledScriptOperand &operand, const std::string &name);
+};
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef SCRIPT_PARSER_INCLUDED
+#define SCRIPT_PARSER_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Misc/ScriptBytecodeFormat.hpp"
+#include "GameCompiler/RequirementCompiler.hpp"
+
+/**
+ * Something a compiled script refers to by name (see ScriptBytecodeFormat.hpp). Sprites are named by the first name of
+ * their character, which the ScriptCompiler turns into the character's id.
+ */
+struct CompiledScriptOperand {
+    int kind;
+    std::string name;
+    std::string characterName;
+};
+
+struct CompiledScript {
+    std::vector<uint32_t> instructions;
+    std::vector<int32_t> constants;
+    std::vector<CompiledScriptOperand> operands;
+    int registerCount;
+};
+
+/**
+ * Compiles the source of a script into bytecode for the runner's ScriptMachine.
+ *
+ * A script is a list of statements, which don't need to be separated:
+ *
+ *     var steps = 3                       // Declares a variable, every value is an int
+ *     while steps > 0 { steps = steps - 1 yield }
+ *     if flag("metAlice") and counter("aliceAffection") >= 2 { morph("park_evening", 1000) } else { fadeOut(1000) }
+ *     sprite(0, "Alice", "smile")         // Shows a character's sprite in a sprite slot
+ *
+ * 'yield' waits for the next frame and 'stop' ends the script. Expressions have the usual arithmetic, comparison and
+ * 'and', 'or' and 'not' operators, and can read flag(name), counter(name) and transitioning(). The statements which act
+ * on the game are background(name), morph(name, ms), fadeIn(ms), fadeOut(ms), sprite(slot, character, name),
+ * clearSprite(slot), music(name), stopMusic(), setFlag(name, value) and setCounter(name, value). Names are string
+ * literals, so that they are looked up once by the compiler rather than while the script runs. '//' starts a comment.
+ *
+ * Variables are given a register each for the whole script, and the values being worked out in a statement are held
+ * in the registers above them.
+ */
+class ScriptParser {
+public:
+    ScriptParser(const std::string &name, RequirementCompiler *requirementCompiler);
+
+    CompiledScript parse(const std::string &source);
+
+private:
+    enum class TokenType {
+        Identifier, Number, String, Symbol, End
+    };
+
+    struct Token {
+        TokenType type;
+        std::string text;
+        int64_t number;
+        int line;
+    };
+
+    std::string scriptName;
+    std::string owner;
+    RequirementCompiler *requirements;
+
+    std::vector<Token> tokens;
+    size_t position;
+
+    CompiledScript script;
+    std::unordered_map<std::string, int> variables;
+    std::unordered_map<int32_t, int> constantIndices;
+    std::unordered_map<std::string, int> operandIndices;
+    int nextRegister;
+    int lastResult; // The instruction which wrote the value of the expression just compiled, -1 if there isn't one
+
+    void tokenize(const std::string &source);
+
+    const Token &peek() const;
+
+    const Token &next();
+
+    bool accept(const std::string &text);
+
+    void expect(const std::string &text);
+
+    bool isKeyword(const std::string &text) const;
+
+    std::string expectIdentifier();
+
+    std::string expectString();
+
+    void statement();
+
+    void block();
+
+    void callStatement(const std::string &function, int line);
+
+    int expression(int target);
+
+    int orExpression(int target);
+
+    int andExpression(int target);
+
+    int comparison(int target);
+
+    int sum(int target);
+
+    int product(int target);
+
+    int unary(int target);
+
+    int primary(int target);
+
+    int allocateRegister();
+
+    void freeRegister();
+
+    int emit(uint32_t instruction);
+
+    int emitResult(uint32_t instruction);
+
+    int emitJump(int opcode, int reg);
+
+    void patchJump(int jump, int target);
+
+    void loadNumber(int target, int64_t value);
+
+    int addOperand(int kind, const std::string &name, const std::string &characterName);
+
+    int flagIndex(const std::string &name, bool counter);
+
+    [[noreturn]] void fail(int line, const std::string &message) const;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef STRING_PACK_BUILDER_INCLUDED
+#define STRING_PACK_BUILDER_INCLUDED
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include "Database/DatabaseConnection.hpp"
+#include "Misc/JsonHandler.hpp"
+#include "Misc/StringPackFormat.hpp"
+
+/**
+ * Writes a string pack (see StringPackFormat.hpp) for each locale in the novel database's locales table.
+ *
+ * The first locale's pack holds the text the novel is written in. The others are translated with Locales/<name>.json
+ * in the project directory, which has a 'lines' object keyed by the string_key of each line, and 'characters' and
+ * 'chapters' objects keyed by the character names and chapter titles as they are written. Anything without a
+ * translation is written in the novel's own locale, and listed in <name>.missing.json next to the pack in the same
+ * layout, so that it can be filled in and copied into the translation.
+ */
+class StringPackBuilder {
+public:
+    StringPackBuilder(DatabaseConnection *novelDb, JsonHandler *fileHandler, const std::string &projectDirectory);
+
+    ~StringPackBuilder();
+
+    void write(const std::string &directory);
+
+private:
+    DatabaseConnection *novel;
+    JsonHandler *fHandler;
+    std::string localeDirectory;
+
+    // The text the novel is written in, indexed by the id of the line, character or chapter
+    struct SourceLine {
+        std::string key;
+        std::string text;
+        std::string characterName;
+        bool spoken = false;
+    };
+
+    std::vector<SourceLine> lines;
+    std::vector<std::string> characterNames;
+    std::vector<std::string> chapterTitles;
+
+    void readSource();
+
+    void writePack(const std::string &path, const std::string &locale, const json &translation, json &missing);
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef LOADING_PROGRESS_INCLUDED
+#define LOADING_PROGRESS_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+/**
+ * Shared between the threads loading the game and the loading screen which shows how far they have got.
+ *
+ * Each part of the load adds the number of steps it will take before it starts, and completes them as it goes. The
+ * clock starts when the progress is created, so it also measures how long the game has taken to start.
+ */
+class LoadingProgress {
+public:
+    LoadingProgress();
+
+    void addSteps(int count);
+
+    void beginStep(const std::string &description);
+
+    void completeStep();
+
+    float getFraction();
+
+    std::string getDescription();
+
+    long long getElapsedMilliseconds();
+
+private:
+    std::atomic<int> totalSteps;
+    std::atomic<int> completedSteps;
+    std::mutex descriptionMutex;
+    std::string description;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+#endif
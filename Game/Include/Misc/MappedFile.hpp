@@ -0,0 +1,42 @@
+#ifndef MAPPED_FILE_INCLUDED
+#define MAPPED_FILE_INCLUDED
+
+#include <cstddef>
+#include <string>
+
+/**
+ * A file mapped read only into memory for as long as this exists. Pages are only read from disk once they are
+ * touched, so mapping a large file costs little until its contents are used.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *getData() const {
+        return data;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+private:
+    std::string filePath;
+    const char *data;
+    size_t size;
+
+#ifdef _WIN32
+    void *fileHandle;
+    void *mappingHandle;
+#endif
+
+    void unmap();
+};
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef NOVEL_IMAGE_FORMAT_INCLUDED
+#define NOVEL_IMAGE_FORMAT_INCLUDED
+
+#include <cstdint>
+
+/**
+ * Layout of the novel image, a flat copy of the chapters, scenes, segments and lines of the novel database which the
+ * compiler writes next to it. The runner maps the file into memory and reads the records where they are.
+ *
+ * The file starts with a NovelImageHeader, followed by one table per record type and a blob holding every string.
+ * Tables are located by their offset from the start of the file, and records refer to each other by their index in
+ * the table, so the file can be mapped at any address. Children are stored contiguously in the order they are played,
+ * a parent only records the index of its first child and how many it has. Lines can also be found by their id, through
+ * a table indexed by line id which holds the index of each line, or NOVEL_IMAGE_NO_INDEX for an id with no line.
+ * The jump taken after each scene segment is in a table indexed by segment id.
+ *
+ * Values are stored in the byte order of the machine which compiled the novel. The runner refuses an image with a
+ * different magic, version or byte order and falls back to the novel database.
+ */
+
+#define NOVEL_IMAGE_PATH "db/novel.img"
+#define NOVEL_IMAGE_MAGIC "TSNOVIMG"
+#define NOVEL_IMAGE_MAGIC_LENGTH 8
+#define NOVEL_IMAGE_VERSION 4
+#define NOVEL_IMAGE_BYTE_ORDER_MARK 0x01020304u
+
+// Used for references to a record which does not exist, e.g. a line without a character state group
+#define NOVEL_IMAGE_NO_INDEX 0xFFFFFFFFu
+
+// Every table starts on a multiple of this, so that its records can be read in place
+#define NOVEL_IMAGE_TABLE_ALIGNMENT 8
+
+struct NovelImageTable {
+    uint32_t offset;
+    uint32_t count;
+};
+
+// A string within the string blob, it is not null terminated
+struct NovelImageString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct NovelImageHeader {
+    char magic[NOVEL_IMAGE_MAGIC_LENGTH];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t headerSize;
+    uint32_t fileSize;
+    NovelImageTable chapters;
+    NovelImageTable scenes;
+    NovelImageTable sceneSegments;
+    NovelImageTable segmentLines;
+    // A table of uint32_t indexes into segmentLines, indexed by line id
+    NovelImageTable segmentLineIndexById;
+    NovelImageTable characterStateGroups;
+    NovelImageTable characterStates;
+    NovelImageTable musicPlaybackRequests;
+    NovelImageTable sceneSegmentJumps;
+    // The count of the string blob is its length in bytes
+    NovelImageTable strings;
+};
+
+struct NovelImageChapter {
+    int32_t id;
+    NovelImageString title;
+    uint32_t firstScene;
+    uint32_t sceneCount;
+};
+
+struct NovelImageScene {
+    int32_t id;
+    NovelImageString backgroundImageName;
+    int32_t backgroundColourId;
+    int32_t startTransitionColourId;
+    int32_t endTransitionColourId;
+    int32_t startTransitionTypeId;
+    int32_t endTransitionTypeId;
+    uint32_t firstSceneSegment;
+    uint32_t sceneSegmentCount;
+};
+
+struct NovelImageSceneSegment {
+    int32_t id;
+    NovelImageString visualEffectName;
+    uint32_t musicPlaybackRequest;
+    uint32_t firstSegmentLine;
+    uint32_t segmentLineCount;
+};
+
+struct NovelImageSegmentLine {
+    int32_t id;
+    int32_t characterId;
+    uint32_t characterStateGroup;
+    NovelImageString text;
+    NovelImageString overrideCharacterName;
+};
+
+struct NovelImageCharacterStateGroup {
+    int32_t id;
+    uint32_t firstCharacterState;
+    uint32_t characterStateCount;
+};
+
+// characterId is 0 when the state refers to a character sprite which does not exist
+struct NovelImageCharacterState {
+    int32_t id;
+    int32_t characterSpriteId;
+    int32_t characterId;
+    NovelImageString spriteName;
+};
+
+// The metadata fields are only set when hasMetadata is not 0
+struct NovelImageMusicPlaybackRequest {
+    int32_t id;
+    NovelImageString musicName;
+    uint32_t hasMetadata;
+    int32_t metadataId;
+    float pitch;
+    int32_t volume;
+    int32_t startTime;
+    int32_t endTime;
+    uint8_t loop;
+    uint8_t muted;
+    uint8_t padding[2];
+};
+
+// Where the story goes after a scene segment, see the scene_segment_jumps table. Indexed by scene segment id, an id
+// with no segment has a jump of -1 which ends the story
+struct NovelImageSceneSegmentJump {
+    int32_t chapter;
+    int32_t scene;
+    int32_t sceneSegment;
+};
+
+static_assert(sizeof(NovelImageHeader) == 104, "NovelImageHeader must not contain padding");
+static_assert(sizeof(NovelImageChapter) == 20, "NovelImageChapter must not contain padding");
+static_assert(sizeof(NovelImageScene) == 40, "NovelImageScene must not contain padding");
+static_assert(sizeof(NovelImageSceneSegment) == 24, "NovelImageSceneSegment must not contain padding");
+static_assert(sizeof(NovelImageSegmentLine) == 28, "NovelImageSegmentLine must not contain padding");
+static_assert(sizeof(NovelImageCharacterStateGroup) == 12, "NovelImageCharacterStateGroup must not contain padding");
+static_assert(sizeof(NovelImageCharacterState) == 20, "NovelImageCharacterState must not contain padding");
+static_assert(sizeof(NovelImageMusicPlaybackRequest) == 40, "NovelImageMusicPlaybackRequest must not contain padding");
+static_assert(sizeof(NovelImageSceneSegmentJump) == 12, "NovelImageSceneSegmentJump must not contain padding");
+
+#endif
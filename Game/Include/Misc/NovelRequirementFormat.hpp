@@ -0,0 +1,32 @@
+#ifndef NOVEL_REQUIREMENT_FORMAT_INCLUDED
+#define NOVEL_REQUIREMENT_FORMAT_INCLUDED
+
+/**
+ * Values shared by the compiler, which writes the story flags and requirements of a novel, and the runner which reads
+ * them (see RequirementCompiler, NovelFlags and NovelRequirements).
+ *
+ * A requirement is written to requirement_terms as a list of terms in postfix order. A term testing a flag or counter
+ * pushes its result, NOT replaces the newest result and AND and OR replace the newest two with one. What is left at the
+ * end is whether the requirement is met. The operand of a term is the index of its flag or counter, which the compiler
+ * numbers from 0 without gaps for each kind.
+ */
+
+#define NOVEL_REQUIREMENT_FALSE 0
+#define NOVEL_REQUIREMENT_TRUE 1
+#define NOVEL_REQUIREMENT_FLAG 2 // The flag must be set
+#define NOVEL_REQUIREMENT_COUNTER_AT_LEAST 3 // The counter must be at least the term's value
+#define NOVEL_REQUIREMENT_COUNTER_AT_MOST 4
+#define NOVEL_REQUIREMENT_COUNTER_EQUALS 5
+#define NOVEL_REQUIREMENT_NOT 6
+#define NOVEL_REQUIREMENT_AND 7
+#define NOVEL_REQUIREMENT_OR 8
+
+// Terms are evaluated on a stack of single bits held in one word, so a requirement can't nest any deeper than this
+#define NOVEL_REQUIREMENT_MAX_DEPTH 64
+
+// What a flag change does to its operand, as written to scene_segment_flag_changes
+#define NOVEL_FLAG_CHANGE_SET_FLAG 1 // The flag is set if the value is not 0, and cleared otherwise
+#define NOVEL_FLAG_CHANGE_SET_COUNTER 2
+#define NOVEL_FLAG_CHANGE_ADD_COUNTER 3
+
+#endif
@@ -10,4 +10,6 @@ private:
   bool shouldExitProgram;
   void printVersionInformation();
   void printLicenceInformation();
+  void benchmarkNovelLoad();
+  void benchmarkScripts();
 };
@@ -0,0 +1,74 @@
+#ifndef SCRIPT_BYTECODE_FORMAT_INCLUDED
+#define SCRIPT_BYTECODE_FORMAT_INCLUDED
+
+#include <cstdint>
+
+/**
+ * Values shared by the compiler, which compiles scripts to bytecode, and the runner which executes it (see
+ * ScriptCompiler, ScriptProgram and ScriptMachine).
+ *
+ * A script is compiled to a list of 32 bit instructions written to script_instructions. The opcode is the lowest byte,
+ * followed by the byte A, then either the bytes B and C or the 16 bit operand BX. A, B and C name registers, of which a
+ * script has at most SCRIPT_MAX_REGISTERS. BX is the index of a constant or operand of the script, or of a flag or
+ * counter, except for LOADI and the jumps which treat it as signed. Jumps are relative to the next instruction.
+ *
+ * Every value is a 32 bit int, comparisons give 1 or 0 and any value other than 0 is true.
+ */
+
+#define SCRIPT_OP_HALT 0 // The script has finished
+#define SCRIPT_OP_YIELD 1 // Nothing more is run until the next frame
+#define SCRIPT_OP_LOADI 2 // A = signed BX
+#define SCRIPT_OP_LOADK 3 // A = constant BX
+#define SCRIPT_OP_MOVE 4 // A = B
+#define SCRIPT_OP_ADD 5 // A = B + C, and so on down to OR
+#define SCRIPT_OP_SUB 6
+#define SCRIPT_OP_MUL 7
+#define SCRIPT_OP_DIV 8 // Dividing by 0 stops the script with an error
+#define SCRIPT_OP_MOD 9
+#define SCRIPT_OP_EQ 10
+#define SCRIPT_OP_NE 11
+#define SCRIPT_OP_LT 12
+#define SCRIPT_OP_LE 13
+#define SCRIPT_OP_AND 14
+#define SCRIPT_OP_OR 15
+#define SCRIPT_OP_NOT 16 // A = !B
+#define SCRIPT_OP_NEG 17 // A = -B
+#define SCRIPT_OP_JMP 18 // Jumps by signed BX
+#define SCRIPT_OP_JMPIFNOT 19 // Jumps by signed BX if A is 0
+#define SCRIPT_OP_FLAG 20 // A = whether flag BX is set
+#define SCRIPT_OP_COUNTER 21 // A = counter BX
+#define SCRIPT_OP_SETFLAG 22 // Flag BX is set if A is not 0, and cleared otherwise
+#define SCRIPT_OP_SETCOUNTER 23 // Counter BX = A
+#define SCRIPT_OP_BACKGROUND 24 // Shows the background named by operand BX straight away
+#define SCRIPT_OP_MORPH 25 // Morphs into the background named by operand BX over A milliseconds
+#define SCRIPT_OP_FADEIN 26 // Fades in from black over A milliseconds
+#define SCRIPT_OP_FADEOUT 27 // Fades out to black over A milliseconds
+#define SCRIPT_OP_TRANSITIONING 28 // A = whether a background transition is still running
+#define SCRIPT_OP_SPRITE 29 // Shows the character sprite named by operand BX in sprite slot A
+#define SCRIPT_OP_CLEARSPRITE 30 // Empties sprite slot A
+#define SCRIPT_OP_MUSIC 31 // Plays the music named by operand BX
+#define SCRIPT_OP_STOPMUSIC 32
+#define SCRIPT_OP_COUNT 33
+
+// What an operand of a script names, as written to script_operands
+#define SCRIPT_OPERAND_BACKGROUND 1 // The name of a background image
+#define SCRIPT_OPERAND_MUSIC 2 // The name of a music track
+#define SCRIPT_OPERAND_SPRITE 3 // The name of a sprite of the character whose id is the operand's value
+
+#define SCRIPT_MAX_REGISTERS 256
+#define SCRIPT_MAX_OPERAND 65535 // The highest index BX can hold
+
+#define SCRIPT_ENCODE_ABC(op, a, b, c) \
+    (static_cast<uint32_t>(op) | (static_cast<uint32_t>(a) << 8) | (static_cast<uint32_t>(b) << 16) \
+     | (static_cast<uint32_t>(c) << 24))
+#define SCRIPT_ENCODE_ABX(op, a, bx) \
+    (static_cast<uint32_t>(op) | (static_cast<uint32_t>(a) << 8) | ((static_cast<uint32_t>(bx) & 0xFFFF) << 16))
+
+#define SCRIPT_DECODE_OP(instruction) ((instruction) & 0xFF)
+#define SCRIPT_DECODE_A(instruction) (((instruction) >> 8) & 0xFF)
+#define SCRIPT_DECODE_B(instruction) (((instruction) >> 16) & 0xFF)
+#define SCRIPT_DECODE_C(instruction) ((instruction) >> 24)
+#define SCRIPT_DECODE_BX(instruction) ((instruction) >> 16)
+#define SCRIPT_DECODE_SBX(instruction) static_cast<int32_t>(static_cast<int16_t>((instruction) >> 16))
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef STRING_PACK_FORMAT_INCLUDED
+#define STRING_PACK_FORMAT_INCLUDED
+
+#include <cstdint>
+
+/**
+ * Layout of a string pack, which holds the text of the novel in one locale: the text of every line, the names lines
+ * show in place of their character's name, the characters' names and the chapter titles. The compiler writes one pack
+ * for each locale listed in project.json, and the runner maps the pack of the locale being played into memory.
+ *
+ * The file starts with a StringPackHeader, followed by one table per kind of string and a blob holding the strings
+ * themselves. Each table is indexed by the id the string belongs to in the novel database (the id of the line,
+ * character or chapter), so the runner finds a string without searching for it. An id with nothing to show, such as
+ * a line which doesn't override its character's name, has an empty string.
+ *
+ * Every pack has an entry for every id, a string which hasn't been translated holds the text the novel was written in.
+ * Values are stored in the byte order of the machine which compiled the novel, as in the novel image.
+ */
+
+#define STRING_PACK_DIRECTORY "db/strings/"
+#define STRING_PACK_EXTENSION ".pack"
+#define STRING_PACK_MAGIC "TSSTRPAK"
+#define STRING_PACK_MAGIC_LENGTH 8
+#define STRING_PACK_VERSION 1
+#define STRING_PACK_BYTE_ORDER_MARK 0x01020304u
+
+// The longest locale name, including the null terminator it is padded with
+#define STRING_PACK_LOCALE_LENGTH 16
+
+// Every table starts on a multiple of this, so that its records can be read in place
+#define STRING_PACK_TABLE_ALIGNMENT 8
+
+struct StringPackTable {
+    uint32_t offset;
+    uint32_t count;
+};
+
+// A string within the string blob, it is not null terminated
+struct StringPackString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct StringPackHeader {
+    char magic[STRING_PACK_MAGIC_LENGTH];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t headerSize;
+    uint32_t fileSize;
+    char locale[STRING_PACK_LOCALE_LENGTH];
+    // Each of these is a table of StringPackStrings
+    StringPackTable lineTexts;
+    StringPackTable lineCharacterNames;
+    StringPackTable characterNames;
+    StringPackTable chapterTitles;
+    // The count of the string blob is its length in bytes
+    StringPackTable strings;
+};
+
+static_assert(sizeof(StringPackHeader) == 80, "StringPackHeader must not contain padding");
+static_assert(sizeof(StringPackString) == 8, "StringPackString must not contain padding");
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef STRING_POOL_INCLUDED
+#define STRING_POOL_INCLUDED
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct StringPoolEntry {
+    uint32_t id;
+    std::string value;
+};
+
+/**
+ * Holds a single copy of every string interned into it, for as long as the program runs.
+ *
+ * Entries are never moved or removed, so ids and the strings they point to stay valid once they have been handed out.
+ * Names of resources and characters are interned, as they are repeated throughout the novel and looked up by name.
+ * The text of lines is not, as that is rarely repeated and would never be released.
+ */
+class StringPool {
+public:
+    static const StringPoolEntry *intern(std::string_view value);
+
+    static const StringPoolEntry *find(std::string_view value);
+
+    static const std::string &get(uint32_t id);
+
+    static size_t size();
+
+private:
+    StringPool();
+
+    ~StringPool();
+
+    static StringPool *getPool();
+
+    std::mutex poolMutex;
+    std::vector<StringPoolEntry *> entries;
+    std::unordered_map<std::string_view, StringPoolEntry *> entriesByValue;
+};
+
+/**
+ * A handle to a string in the StringPool. Two handles are equal when they hold the same string, which only needs
+ * their pointers to be compared. A default constructed handle holds the empty string.
+ */
+class InternedString {
+public:
+    InternedString() : InternedString(std::string_view()) {
+    }
+
+    explicit InternedString(std::string_view value) {
+        entry = StringPool::intern(value);
+    }
+
+    /**
+     * [InternedString::find Looks up a string without adding it to the pool]
+     * @param  value [The string]
+     * @return       [Its handle. If it has never been interned, the handle is not equal to any other]
+     */
+    static InternedString find(std::string_view value) {
+        return InternedString(StringPool::find(value));
+    }
+
+    bool isInterned() const {
+        return entry != nullptr;
+    }
+
+    uint32_t getId() const {
+        return entry ? entry->id : UINT32_MAX;
+    }
+
+    const std::string &str() const {
+        return entry ? entry->value : StringPool::get(0);
+    }
+
+    std::string_view view() const {
+        return str();
+    }
+
+    bool empty() const {
+        return str().empty();
+    }
+
+    bool operator==(const InternedString &other) const {
+        return entry == other.entry;
+    }
+
+    bool operator!=(const InternedString &other) const {
+        return entry != other.entry;
+    }
+
+private:
+    explicit InternedString(const StringPoolEntry *poolEntry) {
+        entry = poolEntry;
+    }
+
+    const StringPoolEntry *entry;
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include <queue>
 #include "VisualNovelEngine/Classes/Data/DataModels/MusicPlaybackRequestMetadata.hpp"
 #include "Resource/MusicPlayRequest.hpp"
+#include "Misc/StringPool.hpp"
 
 enum AudioStreamState {
     Unloaded, Stopped, Playing, Paused, Error
@@ -21,16 +22,16 @@ public:
     AudioStream(const std::string& asName, const std::string& asFname) {
         music = nullptr;
         state = AudioStreamState::Unloaded;
-        name = asName;
+        name = InternedString(asName);
         fileName = asFname;
 
 #ifdef DEBUG_AUDIO_STREAM
-        std::cout<<"Audio stream added, name: "<<name<<" filename: "<<fileName<<std::endl;
+        std::cout<<"Audio stream added, name: "<<name.str()<<" filename: "<<fileName<<std::endl;
 #endif
 
         if (!Utils::fileExists(asFname)) {
             std::vector<std::string> errorMessage = {
-                    "Unable to add audio stream with name '", name, "' (File '", fileName, "' does not exist)"
+                    "Unable to add audio stream with name '", name.str(), "' (File '", fileName, "' does not exist)"
             };
 
             throw ResourceException(Utils::implodeString(errorMessage));
@@ -41,7 +42,7 @@ public:
         delete music;
     };
 
-    std::string getName() {
+    InternedString getName() {
         return name;
     };
 
@@ -64,7 +65,7 @@ public:
             music = new sf::Music();
             if (!music->openFromFile(fileName)) {
                 std::vector<std::string> errorMessage = {
-                        "Unable to play audio stream '", name, "'. The file may be corrupted or in the wrong format."
+                        "Unable to play audio stream '", name.str(), "'. The file may be corrupted or in the wrong format."
                 };
 
                 throw ResourceException(Utils::implodeString(errorMessage));
@@ -116,7 +117,7 @@ public:
     }
 
 private:
-    std::string name;
+    InternedString name;
     std::string fileName;
     sf::Music *music;
     AudioStreamState state;
@@ -146,8 +147,18 @@ public:
 
     void playAudioStream(std::string name, MusicPlaybackRequestMetadata* metadata);
 
+    void playAudioStream(InternedString name);
+
+    void playAudioStream(InternedString name, MusicPlaybackRequestMetadata* metadata);
+
+    void stopAudioStreams();
+
+    InternedString getPlayingStreamName();
+
     int findAudioStream(std::string name);
 
+    int findAudioStream(InternedString name);
+
     void loadAllFromDatabase(DatabaseConnection *database);
 
 private:
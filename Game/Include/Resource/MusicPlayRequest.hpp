@@ -1,6 +1,8 @@
 #ifndef MUSIC_PLAY_REQUEST_INCLUDED
 #define MUSIC_PLAY_REQUEST_INCLUDED
 
+#include <optional>
+
 struct MusicPlayRequest {
 public:
     MusicPlayRequest(int id) {
@@ -18,17 +20,22 @@ public:
         return loop;
     }
 
+    // Copied, as the playback request it came from may be repointed at another one before the queue is processed
     void setMetadata(MusicPlaybackRequestMetadata *pMetadata) {
-        metadata = pMetadata;
+        metadata.reset();
+
+        if (pMetadata) {
+            metadata.emplace(*pMetadata);
+        }
     }
 
     MusicPlaybackRequestMetadata *getMetadata() {
-        return metadata;
+        return metadata ? &*metadata : nullptr;
     }
 private:
     int streamId;
     bool loop;
-    MusicPlaybackRequestMetadata *metadata;
+    std::optional<MusicPlaybackRequestMetadata> metadata;
 };
 
 #endif
\ No newline at end of file
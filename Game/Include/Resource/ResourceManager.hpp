@@ -7,6 +7,7 @@
 #include "Resource/FontManager.hpp"
 #include "Resource/MusicManager.hpp"
 #include "Resource/TextureManager.hpp"
+#include "Misc/LoadingProgress.hpp"
 
 class ResourceManager {
 public:
@@ -40,7 +41,7 @@ public:
         return resourceDatabase;
     }
 
-    void loadResourcesFromDatabase();
+    void loadResourcesFromDatabase(LoadingProgress *progress = nullptr);
 
 private:
     void processQueue();
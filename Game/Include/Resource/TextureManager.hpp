@@ -5,6 +5,7 @@
 #include <queue>
 #include <SFML/Graphics.hpp>
 #include "Exceptions/ResourceException.hpp"
+#include "Misc/StringPool.hpp"
 
 #define MAX_TEXTURES 0xFF
 
@@ -20,7 +21,7 @@ public:
     delete texture;
   };
   void assign(const std::string& assignableName) {
-    name = assignableName;
+    name = InternedString(assignableName);
     loaded = false;
   }
   void loadFromFile(const std::string& fileName) {
@@ -32,7 +33,7 @@ public:
           throw ResourceException(Utils::implodeString(errorMessage));
       };
   }
-  std::string name;
+  InternedString name;
   sf::Texture *texture;
   bool loaded;
 };
@@ -61,6 +62,7 @@ public:
   ~TextureManager();
   int loadTexture(const std::string& fname, const std::string& name);
   int findTexture(const std::string& name);
+  int findTexture(InternedString name);
   Texture* getTexture(int id);
   Texture* getTexture(const std::string& name);
   bool isQueueEmpty();
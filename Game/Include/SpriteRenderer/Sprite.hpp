@@ -1,3 +1,5 @@
+#include "Misc/StringPool.hpp"
+
 class Sprite {
 public:
   Sprite(TextureManager *sTextureManager,sf::RenderWindow *window, const std::string& sName, const std::string& sImageName, int sPriority, int myId);
@@ -30,6 +32,7 @@ public:
     return textureSet;
   }
   void setTextureName(std::string name, bool switchImmediately);
+  void setTextureName(InternedString name, bool switchImmediately);
   sf::FloatRect getSize();
 private:
   sf::Sprite *mySprite;
@@ -37,7 +40,7 @@ private:
   int animationFrame;
   int animationSpeed;
   sf::RenderWindow *displayWindow;
-  std::string textureName;
+  InternedString textureName;
   int textureId;
   TextureManager *textureManager;
   bool visible;
@@ -32,6 +32,7 @@ public:
   }
   CharacterSprite* getSprite(int id);
   CharacterSprite* getSprite(std::string name);
+  CharacterSprite* getSprite(InternedString name);
 private:
   int id;
   std::string firstName;
@@ -1,18 +1,23 @@
 #ifndef NOVEL_DATA_CHARACTER_SPRITE_INCLUDED
 #define NOVEL_DATA_CHARACTER_SPRITE_INCLUDED
 
+#include "Misc/StringPool.hpp"
+
 class CharacterSprite {
 public:
   CharacterSprite(std::string cName, int tId, int pCharacterId);
   ~CharacterSprite();
   void setSprite(int id);
-  std::string getName();
+  InternedString getName();
   int getTextureId();
   void setSpriteId(int id);
   void setTextureName(std::string name) {
+    textureName = InternedString(name);
+  }
+  void setTextureName(InternedString name) {
     textureName = name;
   }
-  std::string getTextureName() {
+  InternedString getTextureName() {
     return textureName;
   }
   int getCharacterId() {
@@ -21,8 +26,8 @@ public:
 private:
   int characterId;
   int textureId;
-  std::string name;
-  std::string textureName;
+  InternedString name;
+  InternedString textureName;
   int spriteId;
 };
 
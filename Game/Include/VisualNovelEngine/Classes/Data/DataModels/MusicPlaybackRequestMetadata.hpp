@@ -3,7 +3,9 @@
 
 class MusicPlaybackRequestMetadata {
 public:
-    explicit MusicPlaybackRequestMetadata(DataSet *data);
+    explicit MusicPlaybackRequestMetadata(DataSetRow *data);
+    MusicPlaybackRequestMetadata(int myId, float myPitch, int myVolume, bool shouldLoop, int startTime, int endTime,
+                                 bool mute);
     int getId() {
         return id;
     }
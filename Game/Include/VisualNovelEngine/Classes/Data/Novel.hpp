@@ -1,17 +1,59 @@
 #ifndef NOVEL_INCLUDED
 #define NOVEL_INCLUDED
 
-#define MAX_CHAPTERS 50
-#define MAX_SCENES 50
-#define MAX_SEGMENTS 50
-#define MAX_LINES 1000
-#define MAX_CHARACTERS 50
-
 // Include headers for other classes which we need
 #include "VisualNovelEngine/Classes/Data/Character.hpp"
+#include "Database/QueryCursor.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelImage.hpp"
+#include "VisualNovelEngine/Classes/Data/StringPack.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelFlags.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelRequirements.hpp"
+#include "Misc/StringPool.hpp"
+#include "Misc/LoadingProgress.hpp"
+#include <future>
+#include <optional>
+#include <unordered_map>
 
 enum AdvanceState {
-  ChapterEnd, SceneEnd, SceneSegmentEnd, NextLine
+  StoryEnd, SceneEnd, SceneSegmentEnd, NextLine
+};
+
+/**
+ * Where the story goes once a scene segment has finished, as resolved by the compiler (see SceneGraphBuilder). It is
+ * the index of the chapter, of the scene within that chapter and of the segment within that scene. The chapter is -1
+ * where the story ends
+ */
+struct NovelJump {
+  int chapter;
+  int scene;
+  int sceneSegment;
+};
+
+/**
+ * A jump a scene segment takes instead of its usual one while a requirement is met
+ */
+struct NovelBranch {
+  int requirementId;
+  NovelJump target;
+};
+
+/**
+ * Whether a chapter is listed with the others, and the requirement it needs to be met before it can be played
+ */
+struct NovelChapterRequirement {
+  bool hidden;
+  int requirementId;
+};
+
+/**
+ * Full     - Every chapter, scene, segment and line is loaded when the novel starts
+ * Windowed - Only the ids of the scenes are kept, along with the previous, current and upcoming scene. The upcoming
+ *            scene is loaded on another thread while the current one is played
+ * Image    - The novel image written by the compiler is mapped into memory, and the current chapter, scene, segment and
+ *            line are read from it as they are reached. Nothing else is loaded
+ */
+enum class NovelResidency {
+  Full, Windowed, Image
 };
 
 class ProjectInformation {
@@ -35,24 +77,28 @@ private:
 #include "VisualNovelEngine/Classes/Data/DataModels/MusicPlaybackRequestMetadata.hpp"
 class MusicPlaybackRequest {
 public:
-    MusicPlaybackRequest(DatabaseConnection *db, int myId, std::string myMusicName, int musicPlaybackRequestMetadataId);
+    MusicPlaybackRequest(int myId, std::string myMusicName, MusicPlaybackRequestMetadata *requestMetadata);
+    ~MusicPlaybackRequest();
+    void setFromImage(NovelImage *image, const NovelImageMusicPlaybackRequest &record);
     MusicPlaybackRequestMetadata* getMetadata() {
         return metadata;
     }
 
-    std::string getMusicName() {
+    InternedString getMusicName() {
         return musicName;
     }
 private:
     MusicPlaybackRequestMetadata *metadata;
+    std::optional<MusicPlaybackRequestMetadata> imageMetadata; // Image only, the metadata of the record being viewed
     int id;
-    std::string musicName;
+    InternedString musicName;
 };
 
 class CharacterState {
 public:
-  CharacterState(int myId, DatabaseConnection *db, Character *character[]);
+  CharacterState(int myId, CharacterSprite *sprite);
   ~CharacterState();
+  void set(int myId, CharacterSprite *sprite);
   CharacterSprite* getCharacterSprite() {
     return characterSprite;
   }
@@ -63,37 +109,60 @@ private:
 
 class CharacterStateGroup {
 public:
-  CharacterStateGroup(int myId, DatabaseConnection *db, Character *character[]);
+  CharacterStateGroup(int myId);
   ~CharacterStateGroup();
   int getId() {
     return id;
   }
   std::vector<CharacterState*> getCharacterStates();
+  void addCharacterState(CharacterState *state);
+  void setFromImage(const NovelImageCharacterStateGroup &record);
+  void setCharacterState(uint32_t index, int stateId, CharacterSprite *sprite);
 private:
   int id;
-  std::vector<CharacterState*> characterState;
+  std::vector<CharacterState*> characterState; // A view keeps the states of larger groups it has viewed, for reuse
+  size_t characterStateCount;
 };
 
 class NovelSceneSegmentLine {
 public:
-  NovelSceneSegmentLine(DatabaseConnection *db, int sslId, int sslCharacterId, std::string sslText, int sslCharacterStateGroupId, std::string sslOverrideCharacterName, Character *character[]);
-  ~NovelSceneSegmentLine();
-  std::string getText();
+  NovelSceneSegmentLine(int sslId, int sslCharacterId, std::string sslText, CharacterStateGroup *sslCharacterStateGroup, std::string sslOverrideCharacterName);
+  void setFromImage(NovelImage *image, const NovelImageSegmentLine &record, CharacterStateGroup *group);
+  int getId() {
+    return id;
+  }
+  std::string_view getText();
   int getCharacterId();
-  std::string getOverrideCharacterName();
+  InternedString getOverrideCharacterName();
   CharacterStateGroup* getCharacterStateGroup();
 private:
   int id;
   int characterId;
   std::string text;
-  std::string overrideCharacterName;
+  std::string_view imageText; // Image only, the text within the mapped image
+  bool imageView;
+  InternedString overrideCharacterName;
   CharacterStateGroup *characterStateGroup;
 };
 
+class NovelScene;
+
+/**
+ * Segments are stored by value within their scene, and their lines are a range of the scene's lines
+ */
 class NovelSceneSegment {
 public:
-  NovelSceneSegment(DatabaseConnection *db, int ssId, std::string ssVisualEffectName, Character *character[], int musicPlaybackRequestId);
+  NovelSceneSegment(int ssId, std::string ssVisualEffectName, MusicPlaybackRequest *ssMusicPlaybackRequest);
+  NovelSceneSegment(NovelSceneSegment &&other) noexcept;
+  NovelSceneSegment &operator=(NovelSceneSegment &&other) noexcept;
+  NovelSceneSegment(const NovelSceneSegment &) = delete;
+  NovelSceneSegment &operator=(const NovelSceneSegment &) = delete;
   ~NovelSceneSegment();
+  bool addLine(NovelSceneSegmentLine newLine);
+  void setFromImage(const NovelImageSceneSegment &record, MusicPlaybackRequest *request);
+  int getId() {
+    return id;
+  }
   int getLineCount();
   NovelSceneSegmentLine* getLine(int id);
   std::string getBackgroundMusicName();
@@ -104,19 +173,27 @@ private:
   int id;
   std::string backgroundMusicName;
   std::string visualEffectName;
-  NovelSceneSegmentLine *line[MAX_LINES];
+  NovelScene *scene;
+  int firstLine;
   int lineCount;
   MusicPlaybackRequest *musicPlaybackRequest;
+  bool imageView;
+  friend class NovelScene;
 };
 
 class NovelScene {
 public:
-  NovelScene(DatabaseConnection *db, DataSetRow *data, Character *character[]);
+  NovelScene();
+  NovelScene(QueryCursor *data);
   ~NovelScene();
+  NovelScene(const NovelScene &) = delete;
+  NovelScene &operator=(const NovelScene &) = delete;
+  void addSceneSegment(NovelSceneSegment newSegment);
+  void setFromImage(NovelImage *image, const NovelImageScene &record);
   NovelSceneSegment* getSceneSegment(int id);
   int getSegmentCount();
   int getId();
-  std::string getBackgroundImageName();
+  InternedString getBackgroundImageName();
   int getBackgroundColourId();
   int getStartTransitionColourId();
   int getEndTransitionColourId();
@@ -125,51 +202,111 @@ public:
   }
 private:
   int id;
-  std::string backgroundImage;
-  NovelSceneSegment *segment[MAX_SEGMENTS];
+  InternedString backgroundImage;
+  std::vector<NovelSceneSegment> segment;
+  std::vector<NovelSceneSegmentLine> line;
   int segmentCount;
   int backgroundColourId;
   int startTransitionColourId;
   int endTransitionColourId;
   int startTransitionTypeId;
   int endTransitionTypeId;
+  friend class NovelSceneSegment;
 };
 
 class NovelChapter {
 public:
-  NovelChapter(DatabaseConnection *db, std::string chapterTitle, int chapterId, Character *character[]);
+  NovelChapter(std::string chapterTitle, int chapterId);
   ~NovelChapter();
+  void addScene(NovelScene *newScene);
   std::string getTitle();
   int getId();
   void start();
   NovelScene* getScene(int id);
   int getSceneCount();
+  void setSceneIndex(const std::vector<int> &ids);
+  int getSceneId(int index);
+  void setScene(int index, NovelScene *newScene);
+  void releaseScene(int index);
+  void setFromImage(NovelImage *image, const NovelImageChapter &record);
 private:
   DatabaseConnection *novelDb;
   int id;
   std::string title;
-  NovelScene *scene[MAX_SCENES];
+  std::string_view imageTitle; // Image only, the title within the mapped image
+  bool imageView;
+  std::vector<NovelScene*> scene;
+  std::vector<int> sceneIds;
   int sceneCount;
 };
 
+class NovelLoader;
+class PooledConnection;
+
 class NovelData {
 public:
   NovelData();
+  explicit NovelData(NovelResidency residencyMode, LoadingProgress *progress = nullptr, int loaderThreads = 0,
+                     const std::string &locale = "");
   ~NovelData();
   void start();
   void start(int cChapter, int cScene, int cSceneSegment, int cSceneSegmentLine);
+  NovelSceneSegmentLine* jumpTo(int cChapter, int cScene, int cSceneSegment, int cSceneSegmentLine);
   AdvanceState getNextAction();
   NovelSceneSegment* getCurrentSceneSegment();
   NovelSceneSegmentLine* getNextLine();
+  NovelSceneSegmentLine* getCurrentLine();
   NovelSceneSegment* advanceToNextSegment();
   NovelScene* advanceToNextScene();
   NovelScene* getCurrentScene();
   NovelChapter* getCurrentChapter();
   ProjectInformation* getProjectInformation();
   Character* getCharacter(int id);
+  CharacterSprite* findCharacterSprite(int characterId, const std::string &spriteName);
+  std::string getLineText(int lineId);
+  std::string getLineText(NovelSceneSegmentLine *line);
+  std::string getCharacterName(NovelSceneSegmentLine *line);
+  std::string getCharacterName(int lineId);
+  std::string getChapterTitle(int chapterIndex);
+  void setLocale(const std::string &locale);
+
+  /**
+   * @return The locales the novel can be played in, the first being the one it is written in. Empty if the novel has
+   *         no string packs, in which case it is played in the locale it is written in
+   */
+  const std::vector<std::string> &getLocales() {
+      return locales;
+  }
+
+  /**
+   * @return The locale being played in, empty if the novel has no string packs
+   */
+  std::string getLocale() {
+      return localeIndex >= 0 ? locales[localeIndex] : "";
+  }
+  bool isChapterAvailable(int chapterIndex);
+  bool isChapterHidden(int chapterIndex);
+  int getFlagChanges(int sceneSegmentId, const NovelFlagChange **changes);
+  InternedString getSegmentScript(int sceneSegmentId);
+  void resetFlags();
+
+  /**
+   * @return Whether a requirement is met by the current flags and counters
+   */
+  bool isRequirementMet(int requirementId) {
+      return requirements.evaluate(requirementId, flags);
+  }
+
+  /**
+   * @return The story flags and counters, which are changed as scene segments start and are saved with the story
+   */
+  NovelFlags &getFlags() {
+      return flags;
+  }
   NovelScene* getPreviousScene() {
       return previousScene;
   };
+  NovelScene* getUpcomingScene();
 
   /**
    * Gets the current scene index within the chapter
@@ -178,18 +315,82 @@ public:
   int getCurrentSceneIndex() {
       return currentScene;
   };
+
+  int getCurrentChapterIndex() {
+      return currentChapter;
+  };
+
+  int getCurrentSceneSegmentIndex() {
+      return currentSceneSegment;
+  };
+
+  int getCurrentSceneSegmentLineIndex() {
+      return currentSceneSegmentLine;
+  };
 private:
-  void loadFromDatabase();
+  void loadFromDatabase(LoadingProgress *progress, const std::string &locale);
+  void makeSceneResident(int chapterIndex, int sceneIndex);
+  void prefetchScene(int chapterIndex, int sceneIndex);
+  void updateSceneWindow();
+  void finishPrefetch();
+  DatabaseConnection* getLineReader(PooledConnection &connection);
+  void indexLines();
+  void loadStoryFlags();
+  void loadLocales(const std::string &locale);
+  NovelJump getJump(int sceneSegmentId);
+  NovelJump findJump(int sceneSegmentId);
+  std::string getCharacterName(int lineId, int characterId, std::string_view overrideCharacterName);
+  int getChapterSceneCount(int chapterIndex);
+  int getImageSceneIndex(int chapterIndex, int sceneIndex);
+  NovelScene* getImageScene(int chapterIndex, int sceneIndex);
+  CharacterStateGroup* getImageCharacterStateGroup(uint32_t index);
+  MusicPlaybackRequest* getImageMusicPlaybackRequest(uint32_t index);
+  NovelResidency residency;
+  int loaderThreadCount; // Full only, the most threads the novel is read with
+  NovelLoader *loader;
+  std::vector<std::pair<int, int>> residentScenes; // Windowed only, the chapter and scene index of each loaded scene
+  int prefetchChapterIndex;
+  int prefetchSceneIndex;
+  std::future<NovelScene*> prefetch;
+  NovelImage *image;
+  std::vector<std::string> locales;
+  int localeIndex;
+  StringPack *strings; // The string pack of the current locale, when the novel has locales. Lines are loaded without text
+  NovelChapter *imageChapterView;
+  int imageChapterViewIndex;
+  NovelScene *imageSceneView[3];
+  int imageSceneViewIndex[3];
+  NovelSceneSegment *imageSceneSegmentView;
+  int imageSceneSegmentViewIndex;
+  NovelSceneSegmentLine *imageSegmentLineView;
+  CharacterStateGroup *imageCharacterStateGroupView;
+  uint32_t imageCharacterStateGroupViewIndex;
+  MusicPlaybackRequest *imageMusicPlaybackRequestView;
+  std::vector<NovelSceneSegmentLine*> lineById; // Full only, lines are never moved once the novel has loaded
+  std::vector<NovelJump> jumps; // Full and Windowed only, indexed by scene segment id
+  std::vector<NovelBranch> branches;
+  std::vector<uint32_t> firstBranch; // Indexed by scene segment id, a segment's branches end where the next one's start
+  std::vector<NovelFlagChange> flagChanges;
+  std::vector<uint32_t> firstFlagChange; // Indexed by scene segment id, in the same way as firstBranch
+  std::vector<InternedString> segmentScripts; // Indexed by scene segment id
+  std::vector<NovelChapterRequirement> chapterRequirements;
+  NovelRequirements requirements;
+  NovelFlags flags;
+  NovelFlags defaultFlags;
   DatabaseConnection *novelDb;
-  NovelChapter *chapter[MAX_CHAPTERS];
-  Character *character[MAX_CHARACTERS];
+  std::vector<NovelChapter*> chapter;
+  std::vector<Character*> character;
+  std::vector<CharacterStateGroup*> characterStateGroups;
   int chapterCount;
   int currentChapter;
   int currentScene;
   int currentSceneSegment;
   int currentSceneSegmentLine;
+  int entrySceneSegment; // The segment the current scene was jumped to, until its first segment has started
   ProjectInformation *projectInformation;
   NovelScene *previousScene;
+  int previousChapterIndex;
+  int previousSceneIndex;
 };
 
 #endif
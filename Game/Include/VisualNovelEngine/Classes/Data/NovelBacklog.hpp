@@ -0,0 +1,43 @@
+#ifndef NOVEL_DATA_NOVEL_BACKLOG_INCLUDED
+#define NOVEL_DATA_NOVEL_BACKLOG_INCLUDED
+
+#include <vector>
+
+// Once this many lines have been shown, each new line replaces the oldest
+#define NOVEL_BACKLOG_CAPACITY 4096
+
+/**
+ * A line which has been shown. The text and the name shown with it are read from the novel when the entry is drawn, in
+ * the locale being played at the time, so only the line's id is kept
+ */
+struct NovelBacklogEntry {
+    int lineId;
+};
+
+/**
+ * The lines which have been shown, oldest first, kept in a ring of a fixed size so that it never grows however long
+ * the game is played for
+ */
+class NovelBacklog {
+public:
+    explicit NovelBacklog(int entryCapacity = NOVEL_BACKLOG_CAPACITY);
+
+    void push(int lineId);
+
+    void removeNewest(int count);
+
+    void clear();
+
+    int getEntryCount() {
+        return entryCount;
+    }
+
+    const NovelBacklogEntry &getEntry(int index);
+
+private:
+    std::vector<NovelBacklogEntry> entries;
+    int firstEntry;
+    int entryCount;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef NOVEL_DATA_NOVEL_FLAGS_INCLUDED
+#define NOVEL_DATA_NOVEL_FLAGS_INCLUDED
+
+#include <cstdint>
+#include <vector>
+#include "Misc/NovelRequirementFormat.hpp"
+
+/**
+ * A change made to a flag or counter (see NovelRequirementFormat.hpp), the operand is the index of the flag or counter
+ */
+struct NovelFlagChange {
+    int operation;
+    int operand;
+    int value;
+};
+
+/**
+ * The story flags and counters, which decide which chapters are available and which way the story branches. They are
+ * saved along with the position in the story.
+ *
+ * Flags and counters are declared in project.json, and the compiler numbers each kind from 0 without gaps. Flags are
+ * kept as single bits and counters as an array of ints, so either is read with nothing more than an index.
+ */
+class NovelFlags {
+public:
+    NovelFlags();
+
+    NovelFlags(int flagCount, int counterCount);
+
+    void set(int flag, bool value);
+
+    void setCounter(int counter, int value);
+
+    NovelFlagChange apply(const NovelFlagChange &change);
+
+    void assign(const std::vector<uint64_t> &words, const std::vector<int32_t> &counterValues);
+
+    /**
+     * @param flag Index of the flag, which must be below getFlagCount
+     * @return Whether the flag is set
+     */
+    bool isSet(int flag) const {
+        return (flagWords[flag >> 6] >> (flag & 63)) & 1;
+    }
+
+    /**
+     * @param counter Index of the counter, which must be below getCounterCount
+     * @return The counter's value
+     */
+    int getCounter(int counter) const {
+        return counters[counter];
+    }
+
+    int getFlagCount() const {
+        return flagCount;
+    }
+
+    int getCounterCount() const {
+        return static_cast<int>(counters.size());
+    }
+
+    /**
+     * @return The flags, 64 to a word with the first flag in the lowest bit of the first word
+     */
+    const std::vector<uint64_t> &getFlagWords() const {
+        return flagWords;
+    }
+
+    const std::vector<int32_t> &getCounters() const {
+        return counters;
+    }
+
+private:
+    int flagCount;
+    std::vector<uint64_t> flagWords;
+    std::vector<int32_t> counters;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef NOVEL_IMAGE_INCLUDED
+#define NOVEL_IMAGE_INCLUDED
+
+#include <string>
+#include <string_view>
+#include "Misc/MappedFile.hpp"
+#include "Misc/NovelImageFormat.hpp"
+
+/**
+ * A novel image written by the compiler, mapped into memory for as long as this exists.
+ *
+ * Only the header is checked when the image is opened. Records are read straight from the mapping, and every index
+ * and string is checked against the size of its table as it is read, so a damaged image throws rather than reading
+ * outside of the file.
+ */
+class NovelImage {
+public:
+    explicit NovelImage(const std::string &path);
+
+    ~NovelImage();
+
+    NovelImage(const NovelImage &) = delete;
+
+    NovelImage &operator=(const NovelImage &) = delete;
+
+    uint32_t getChapterCount() {
+        return header->chapters.count;
+    }
+
+    const NovelImageChapter &getChapter(uint32_t index);
+
+    const NovelImageScene &getScene(uint32_t index);
+
+    const NovelImageSceneSegment &getSceneSegment(uint32_t index);
+
+    const NovelImageSegmentLine &getSegmentLine(uint32_t index);
+
+    uint32_t getSegmentLineCount() {
+        return header->segmentLines.count;
+    }
+
+    uint32_t getSegmentLineIndex(int lineId);
+
+    const NovelImageCharacterStateGroup &getCharacterStateGroup(uint32_t index);
+
+    const NovelImageCharacterState &getCharacterState(uint32_t index);
+
+    const NovelImageMusicPlaybackRequest &getMusicPlaybackRequest(uint32_t index);
+
+    const NovelImageSceneSegmentJump *findSceneSegmentJump(int sceneSegmentId);
+
+    std::string_view getString(const NovelImageString &imageString);
+
+private:
+    std::string imagePath;
+    MappedFile *file;
+    const char *data;
+    size_t size;
+    const NovelImageHeader *header;
+
+    void checkHeader();
+
+    void checkTable(const NovelImageTable &table, size_t recordSize, const std::string &tableName);
+
+    template<typename Record>
+    const Record &getRecord(const NovelImageTable &table, uint32_t index, const char *tableName);
+};
+
+#endif
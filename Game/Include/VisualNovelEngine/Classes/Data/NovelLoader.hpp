@@ -0,0 +1,119 @@
+#ifndef NOVEL_LOADER_INCLUDED
+#define NOVEL_LOADER_INCLUDED
+
+#include <unordered_map>
+#include <vector>
+#include "Database/DatabaseConnection.hpp"
+#include "Database/DatabaseConnectionPool.hpp"
+#include "VisualNovelEngine/Classes/Data/Novel.hpp"
+
+/**
+ * Builds the chapters of a novel, and everything within them, from the novel database.
+ *
+ * Each table is read with a single query ordered by its parent's id, so every child of a parent arrives together and
+ * is attached to it in one pass. The number of queries does not depend on the size of the novel.
+ *
+ * Either the whole novel is loaded with load(), or only the chapters and the ids of their scenes are loaded with
+ * loadChapterIndex() and scenes are then loaded one at a time with loadScene(). The character state groups of scenes
+ * loaded this way are counted by scene, and deleted by releaseScene() once no loaded scene uses them.
+ *
+ * loadInParallel() also loads the whole novel, but splits it by chapter between several threads. Each thread reads the
+ * scenes, segments and lines of one chapter at a time on its own connection, so none of them share a SQLite
+ * connection or any of the loader's maps. The character state groups are read before the threads start and are only
+ * read by them.
+ */
+class NovelLoader {
+public:
+    NovelLoader(DatabaseConnection *db, std::vector<Character *> *novelCharacters);
+
+    ~NovelLoader();
+
+    void load(LoadingProgress *progress = nullptr);
+
+    void loadInParallel(DatabaseConnectionPool *pool, int threadCount, LoadingProgress *progress = nullptr);
+
+    void loadChapterIndex();
+
+    NovelScene *loadScene(int sceneId);
+
+    void releaseScene(int sceneId);
+
+    void loadJumps(std::vector<NovelJump> &jumps);
+
+    void loadBranches(std::vector<NovelBranch> &branches, std::vector<uint32_t> &firstBranch);
+
+    void loadFlags(NovelFlags &flags);
+
+    void loadRequirements(NovelRequirements &requirements);
+
+    void loadChapterRequirements(std::vector<NovelChapterRequirement> &chapterRequirements);
+
+    void loadFlagChanges(std::vector<NovelFlagChange> &flagChanges, std::vector<uint32_t> &firstFlagChange);
+
+    void loadSegmentScripts(std::vector<InternedString> &segmentScripts);
+
+    /**
+     * @return The loaded chapters, in order. Ownership passes to the caller
+     */
+    std::vector<NovelChapter *> &getChapters() {
+        return chapters;
+    }
+
+    /**
+     * @return Every character state group loaded so far, lines only point to these. The loader deletes any which are
+     *         still in the vector when it is deleted, so the caller takes ownership by moving them out of it
+     */
+    std::vector<CharacterStateGroup *> &getCharacterStateGroups() {
+        return characterStateGroups;
+    }
+
+    CharacterSprite *findCharacterSprite(int characterId, std::string_view spriteName);
+
+    /**
+     * @param loaded Whether lines are loaded with their text. A novel played from a string pack leaves it out, so that
+     *               only the text of the locale being played is held in memory
+     */
+    void setLineTextLoaded(bool loaded) {
+        lineTextLoaded = loaded;
+    }
+
+private:
+    DatabaseConnection *novelDb;
+    std::vector<Character *> *character;
+    bool lineTextLoaded;
+
+    std::vector<NovelChapter *> chapters;
+    std::vector<CharacterStateGroup *> characterStateGroups;
+
+    std::unordered_map<int, NovelChapter *> chaptersById;
+    std::unordered_map<int, NovelScene *> scenesById;
+    std::unordered_map<int, NovelSceneSegment *> segmentsById;
+    std::unordered_map<int, CharacterStateGroup *> characterStateGroupsById; // Shared by every line, and every scene when windowed
+    std::unordered_map<int, std::vector<int>> sceneCharacterStateGroupIds; // Windowed only, the groups each loaded scene uses
+    std::unordered_map<int, int> characterStateGroupUseCounts; // Windowed only, how many loaded scenes use each group
+
+    DataSet musicPlaybackRequests;
+    DataSet musicPlaybackRequestMetadata;
+    std::unordered_map<int, int> musicPlaybackRequestRows;
+    std::unordered_map<int, int> musicPlaybackRequestMetadataRows;
+
+    std::vector<int> loadCharacterStateGroups(PreparedStatement *groupQuery, PreparedStatement *stateQuery);
+
+    void loadMusicPlaybackRequests();
+
+    void loadChapters();
+
+    void loadScenes();
+
+    void loadSceneIndexes();
+
+    void loadChapterScenes(NovelChapter *chapter);
+
+    void loadSceneSegments(PreparedStatement *segmentQuery);
+
+    void loadLines(PreparedStatement *lineQuery);
+
+    MusicPlaybackRequest *createMusicPlaybackRequest(int musicPlaybackRequestId);
+};
+
+#endif
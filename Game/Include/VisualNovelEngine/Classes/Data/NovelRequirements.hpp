@@ -0,0 +1,42 @@
+#ifndef NOVEL_DATA_NOVEL_REQUIREMENTS_INCLUDED
+#define NOVEL_DATA_NOVEL_REQUIREMENTS_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Misc/NovelRequirementFormat.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelFlags.hpp"
+
+struct NovelRequirementTerm {
+    int32_t opcode;
+    int32_t operand;
+    int32_t value;
+};
+
+/**
+ * Every requirement in the novel, such as the ones chapters and branches have, compiled into a flat list of terms in
+ * postfix order (see NovelRequirementFormat.hpp).
+ *
+ * Requirements are numbered from 1 by the compiler, and their terms are kept one after the other in a single array, so
+ * evaluating one never allocates or looks anything up by name.
+ */
+class NovelRequirements {
+public:
+    NovelRequirements();
+
+    void addTerm(int requirementId, const NovelRequirementTerm &term);
+
+    void validate(const NovelFlags &flags) const;
+
+    bool evaluate(int requirementId, const NovelFlags &flags) const;
+
+    int getRequirementCount() const {
+        return static_cast<int>(firstTerm.size()) - 2;
+    }
+
+private:
+    std::vector<NovelRequirementTerm> terms;
+    std::vector<uint32_t> firstTerm; // Indexed by requirement id, the terms of a requirement end where the next one's start
+};
+
+#endif
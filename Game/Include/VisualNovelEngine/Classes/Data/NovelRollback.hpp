@@ -0,0 +1,111 @@
+#ifndef NOVEL_DATA_NOVEL_ROLLBACK_INCLUDED
+#define NOVEL_DATA_NOVEL_ROLLBACK_INCLUDED
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Misc/StringPool.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelFlags.hpp"
+
+class CharacterSprite;
+
+// Size of the ring in bytes. A line which only moves on to the next line of its segment takes a single byte
+#define NOVEL_ROLLBACK_CAPACITY 65536
+
+// What a step records the previous value of, anything not flagged is the same as in the step after it
+#define NOVEL_ROLLBACK_CURSOR 1 // The line was not the next line in the same segment
+#define NOVEL_ROLLBACK_SPRITES 2 // Only the slots which changed, by their sprite's rollback id
+#define NOVEL_ROLLBACK_BACKGROUND 4
+#define NOVEL_ROLLBACK_MUSIC 8
+#define NOVEL_ROLLBACK_FLAGS 16 // The changes which undo what was done to the story flags and counters
+
+/**
+ * Everything needed to show a line as it was shown, the text and speaker are read from the line itself
+ */
+struct NovelRollbackState {
+    int chapter;
+    int scene;
+    int sceneSegment;
+    int sceneSegmentLine;
+    InternedString backgroundName;
+    InternedString musicName;
+    std::vector<CharacterSprite *> characterSprites;
+};
+
+/**
+ * The steps taken from each line shown to the next, so that the story can be rolled back to an earlier line with
+ * everything on screen as it was at the time.
+ *
+ * Rather than a copy of the screen for every line, each step only holds the previous value of whatever changed, kept
+ * in a ring of bytes of a fixed size. Once the ring is full, the oldest steps are dropped to make room. A step is laid
+ * out as its flags, the length of its values, the values, then the length and flags again so that the ring can be read
+ * from either end. A step with nothing but the line changing is just its flags, a single zero byte.
+ *
+ * Changes are given with the set methods and recordFlagChange as the screen makes them, and pushLine is called once a
+ * line is shown.
+ */
+class NovelRollback {
+public:
+    explicit NovelRollback(int byteCapacity = NOVEL_ROLLBACK_CAPACITY);
+
+    void setBackground(InternedString backgroundName);
+
+    void setMusic(InternedString musicName);
+
+    void setCharacterSprites(const std::vector<CharacterSprite *> &characterSprites);
+
+    void recordFlagChange(const NovelFlagChange &undo);
+
+    void pushLine(int chapter, int scene, int sceneSegment, int sceneSegmentLine);
+
+    int rollBack(int lineCount, NovelFlags *storyFlags);
+
+    void clear();
+
+    /**
+     * @return How many lines the story can be rolled back by
+     */
+    int getStepCount() {
+        return stepCount;
+    }
+
+    /**
+     * @return The line most recently shown, and what was shown with it
+     */
+    const NovelRollbackState &getState() {
+        return shown;
+    }
+
+private:
+    std::vector<uint8_t> ring;
+    int firstByte;
+    int byteCount;
+    int stepCount;
+
+    bool hasShownLine;
+    NovelRollbackState shown;
+    NovelRollbackState pending;
+    std::vector<NovelFlagChange> pendingFlagUndos;
+
+    std::vector<uint8_t> stepValues; // Reused for every step, so that showing a line doesn't allocate
+
+    // Steps refer to sprites by an id given to each the first time it is recorded, 0 is an empty slot
+    std::vector<CharacterSprite *> spriteById;
+    std::unordered_map<CharacterSprite *, uint16_t> spriteIds;
+
+    void appendSpriteChanges();
+
+    uint16_t getSpriteId(CharacterSprite *sprite);
+
+    void writeStep(uint8_t flags);
+
+    void dropOldestStep();
+
+    void readBytes(int offset, void *data, int size);
+
+    void writeBytes(int offset, const void *data, int size);
+
+    void appendValue(const void *data, int size);
+};
+
+#endif
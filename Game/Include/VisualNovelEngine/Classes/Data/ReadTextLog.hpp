@@ -0,0 +1,36 @@
+#ifndef NOVEL_DATA_READ_TEXT_LOG_INCLUDED
+#define NOVEL_DATA_READ_TEXT_LOG_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define READ_TEXT_LOG_PATH "saves/read_text.dat"
+
+#define READ_TEXT_LOG_MAGIC "TSREAD\0\0"
+#define READ_TEXT_LOG_VERSION 1
+
+/**
+ * Which lines of the novel have ever been shown, kept across every play of the game. Each line is a single bit indexed
+ * by its id, the compiler numbers lines from 1 without gaps so the bitmap stays as small as the novel.
+ *
+ * The file has the same header as a save game (see SaveGameHeader) with READ_TEXT_LOG_MAGIC, followed by the bitmap as
+ * uint64 words.
+ */
+class ReadTextLog {
+public:
+    ReadTextLog() = default;
+
+    bool markRead(int lineId);
+
+    bool hasBeenRead(int lineId) const;
+
+    static ReadTextLog readFromFile(const std::string &path);
+
+    void writeToFile(const std::string &path) const;
+
+private:
+    std::vector<uint64_t> words;
+};
+
+#endif
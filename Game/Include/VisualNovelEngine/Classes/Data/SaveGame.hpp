@@ -0,0 +1,73 @@
+#ifndef NOVEL_DATA_SAVE_GAME_INCLUDED
+#define NOVEL_DATA_SAVE_GAME_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define QUICK_SAVE_PATH "saves/quick.sav"
+
+#define SAVE_GAME_MAGIC "TSSAVE\0\0"
+#define SAVE_GAME_MAGIC_LENGTH 8
+#define SAVE_GAME_VERSION 2
+#define SAVE_GAME_FLAGS_VERSION 2 // Saves from before this version have no story flags, and are loaded with the defaults
+
+// Written as a native integer, a reader on a machine with a different byte order sees a different value
+#define SAVE_GAME_BYTE_ORDER_MARK 0x01020304
+
+/**
+ * The header at the start of every save file, followed by payloadSize bytes of payload.
+ *
+ * The payload holds, in order: the chapter, scene, segment and line indices as int32s, then the background name, the
+ * music name, the text of the text box and the name shown with it as strings, then a uint32 count of character sprite
+ * slots followed by the character id (int32) and sprite name of each. Each string is a uint32 length followed by its
+ * bytes. An empty sprite name is an empty slot. Then there is a uint32 count of flag words followed by each word as its
+ * low and high uint32, and a uint32 count of counters followed by each counter as an int32.
+ */
+struct SaveGameHeader {
+    char magic[SAVE_GAME_MAGIC_LENGTH];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint32_t payloadSize;
+    uint32_t checksum; // FNV-1a of the payload
+};
+
+static_assert(sizeof(SaveGameHeader) == 24, "The save game header must have the same layout for every compiler");
+
+struct SaveGameCharacterSprite {
+    int characterId;
+    std::string spriteName;
+};
+
+/**
+ * Everything needed to put the novel back as it was shown: the position of the story and what was on the screen.
+ * Nothing before the saved line is replayed when a save is loaded.
+ */
+class SaveGame {
+public:
+    SaveGame();
+
+    std::string serialise() const;
+
+    static SaveGame deserialise(const std::string &data, const std::string &path);
+
+    static SaveGame readFromFile(const std::string &path);
+
+    static void writeToFile(const std::string &path, const std::string &data);
+
+    static uint32_t checksum(const char *data, size_t length);
+
+    int chapter;
+    int scene;
+    int sceneSegment;
+    int sceneSegmentLine;
+    std::string backgroundName;
+    std::string musicName;
+    std::string text;
+    std::string characterName;
+    std::vector<SaveGameCharacterSprite> characterSprites;
+    std::vector<uint64_t> flagWords; // See NovelFlags
+    std::vector<int32_t> counters;
+};
+
+#endif
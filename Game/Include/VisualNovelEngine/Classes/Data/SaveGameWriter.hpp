@@ -0,0 +1,40 @@
+#ifndef NOVEL_DATA_SAVE_GAME_WRITER_INCLUDED
+#define NOVEL_DATA_SAVE_GAME_WRITER_INCLUDED
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "VisualNovelEngine/Classes/Data/SaveGame.hpp"
+
+struct SaveGameWriteRequest {
+    std::string path;
+    SaveGame saveGame;
+};
+
+/**
+ * Writes saves on its own thread, so that saving never holds up a frame. Saves are written in the order they were
+ * requested, and any which are still waiting are written before the writer is deleted.
+ */
+class SaveGameWriter {
+public:
+    SaveGameWriter();
+
+    ~SaveGameWriter();
+
+    void write(const std::string &path, const SaveGame &saveGame);
+
+    void flush();
+
+private:
+    void threadFunction();
+
+    std::thread *writerThread;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::queue<SaveGameWriteRequest> writeQueue;
+    bool writing;
+    bool terminateWriterThread;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef NOVEL_DATA_SCRIPT_LIBRARY_INCLUDED
+#define NOVEL_DATA_SCRIPT_LIBRARY_INCLUDED
+
+#include <unordered_map>
+#include <vector>
+#include "Database/DatabaseConnection.hpp"
+#include "VisualNovelEngine/Classes/Data/ScriptProgram.hpp"
+
+class NovelData;
+
+/**
+ * Every enabled script in the resource database, compiled to bytecode by the GameCompiler. Scripts are started by name
+ * from the scene segments which list them.
+ */
+class ScriptLibrary {
+public:
+    ScriptLibrary();
+
+    ~ScriptLibrary();
+
+    void load(DatabaseConnection *resourceDb, NovelData *novel);
+
+    const ScriptProgram *find(InternedString name) const;
+
+    int getScriptCount() const {
+        return static_cast<int>(programs.size());
+    }
+
+private:
+    std::vector<ScriptProgram *> programs;
+    std::unordered_map<uint32_t, ScriptProgram *> programsByName; // Keyed by the id of the interned name
+};
+
+#endif
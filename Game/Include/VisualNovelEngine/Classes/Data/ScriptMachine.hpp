@@ -0,0 +1,96 @@
+#ifndef NOVEL_DATA_SCRIPT_MACHINE_INCLUDED
+#define NOVEL_DATA_SCRIPT_MACHINE_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include "VisualNovelEngine/Classes/Data/ScriptProgram.hpp"
+
+// The most instructions a script runs in one frame, a script which needs more carries on in the next frame
+#define SCRIPT_INSTRUCTIONS_PER_FRAME 20000
+
+/**
+ * What a script can do to the game, given to ScriptMachine::run by whatever runs the script
+ */
+class ScriptHost {
+public:
+    virtual ~ScriptHost() = default;
+
+    virtual NovelFlags &getScriptFlags() = 0;
+
+    virtual void changeFlag(const NovelFlagChange &change) = 0;
+
+    virtual void showBackground(InternedString backgroundName) = 0;
+
+    virtual void morphBackground(InternedString backgroundName, int milliseconds) = 0;
+
+    virtual void fadeInBackground(int milliseconds) = 0;
+
+    virtual void fadeOutBackground(int milliseconds) = 0;
+
+    virtual bool isBackgroundTransitioning() = 0;
+
+    /**
+     * @return Whether there is such a slot, a script trying to use one which doesn't exist is stopped
+     */
+    virtual bool showSprite(int slot, CharacterSprite *characterSprite) = 0;
+
+    virtual void playMusic(InternedString musicName) = 0;
+
+    virtual void stopMusic() = 0;
+};
+
+enum class ScriptState {
+    Stopped, Running, Failed
+};
+
+/**
+ * Runs a ScriptProgram a number of instructions at a time, so that a script can be spread over several frames.
+ *
+ * The registers are a fixed array and the program is only read from, so running a script never allocates. Only
+ * stopping with an error does, to give the reason.
+ */
+class ScriptMachine {
+public:
+    ScriptMachine();
+
+    void start(const ScriptProgram *scriptProgram);
+
+    void stop();
+
+    ScriptState run(int instructionBudget, ScriptHost *host);
+
+    bool isRunning() const {
+        return state == ScriptState::Running;
+    }
+
+    ScriptState getState() const {
+        return state;
+    }
+
+    const ScriptProgram *getProgram() const {
+        return program;
+    }
+
+    const std::string &getError() const {
+        return error;
+    }
+
+    /**
+     * @return How many instructions have been run since the script started
+     */
+    uint64_t getExecutedCount() const {
+        return executedCount;
+    }
+
+private:
+    const ScriptProgram *program;
+    ScriptState state;
+    int programCounter;
+    uint64_t executedCount;
+    std::string error;
+    int32_t registers[SCRIPT_MAX_REGISTERS];
+
+    ScriptState fail(const std::string &reason);
+};
+
+#endif
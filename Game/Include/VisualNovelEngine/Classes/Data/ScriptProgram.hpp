@@ -0,0 +1,71 @@
+#ifndef NOVEL_DATA_SCRIPT_PROGRAM_INCLUDED
+#define NOVEL_DATA_SCRIPT_PROGRAM_INCLUDED
+
+#include <cstdint>
+#include <vector>
+#include "Misc/ScriptBytecodeFormat.hpp"
+#include "Misc/StringPool.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelFlags.hpp"
+
+class CharacterSprite;
+
+/**
+ * Something a script refers to by name (see ScriptBytecodeFormat.hpp), looked up once when the script is loaded
+ */
+struct ScriptOperand {
+    int kind;
+    InternedString name;
+    CharacterSprite *characterSprite; // Sprite operands only
+};
+
+/**
+ * A script compiled to bytecode by the GameCompiler, which is run by a ScriptMachine.
+ *
+ * Once validate has accepted it, every register, constant, operand, flag, counter and jump its instructions refer to
+ * is known to exist, so it can be run without checking any of them.
+ */
+class ScriptProgram {
+public:
+    ScriptProgram(InternedString programName, int programRegisterCount);
+
+    void addInstruction(uint32_t instruction);
+
+    void addConstant(int32_t value);
+
+    void addOperand(const ScriptOperand &operand);
+
+    void validate(const NovelFlags &flags) const;
+
+    InternedString getName() const {
+        return name;
+    }
+
+    int getRegisterCount() const {
+        return registerCount;
+    }
+
+    int getInstructionCount() const {
+        return static_cast<int>(instructions.size());
+    }
+
+    const uint32_t *getInstructions() const {
+        return instructions.data();
+    }
+
+    const int32_t *getConstants() const {
+        return constants.data();
+    }
+
+    const ScriptOperand &getOperand(int index) const {
+        return operands[index];
+    }
+
+private:
+    InternedString name;
+    int registerCount;
+    std::vector<uint32_t> instructions;
+    std::vector<int32_t> constants;
+    std::vector<ScriptOperand> operands;
+};
+
+#endif
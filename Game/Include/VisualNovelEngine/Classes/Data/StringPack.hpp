@@ -0,0 +1,51 @@
+#ifndef NOVEL_DATA_STRING_PACK_INCLUDED
+#define NOVEL_DATA_STRING_PACK_INCLUDED
+
+#include <string>
+#include <string_view>
+#include "Misc/MappedFile.hpp"
+#include "Misc/StringPackFormat.hpp"
+
+/**
+ * The string pack of one locale (see StringPackFormat.hpp), mapped into memory for as long as this exists.
+ *
+ * Only the header is checked when the pack is opened, every string is checked against the string blob as it is read.
+ * An id the pack has no entry for gives an empty string, as the novel has nothing to show for it.
+ */
+class StringPack {
+public:
+    explicit StringPack(const std::string &path);
+
+    ~StringPack();
+
+    StringPack(const StringPack &) = delete;
+
+    StringPack &operator=(const StringPack &) = delete;
+
+    static std::string getPath(const std::string &locale);
+
+    std::string getLocale();
+
+    std::string_view getLineText(int lineId);
+
+    std::string_view getLineCharacterName(int lineId);
+
+    std::string_view getCharacterName(int characterId);
+
+    std::string_view getChapterTitle(int chapterId);
+
+private:
+    std::string packPath;
+    MappedFile *file;
+    const char *data;
+    size_t size;
+    const StringPackHeader *header;
+
+    void checkHeader();
+
+    void checkTable(const StringPackTable &table, size_t recordSize, const std::string &tableName);
+
+    std::string_view getString(const StringPackTable &table, int id);
+};
+
+#endif
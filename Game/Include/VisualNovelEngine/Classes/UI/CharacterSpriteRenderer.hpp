@@ -25,6 +25,9 @@ public:
   void draw();
   void initData(NovelData *novelData);
   void push(std::vector<CharacterSpriteDrawRequest*> sprites);
+  std::vector<CharacterSprite*> getCharacterSprites();
+  void show(const std::vector<CharacterSprite*> &sprites);
+  bool pushToSlot(int slot, CharacterSprite *characterSprite);
   void clear();
   bool hasProcessedPositioning() {
     return processedPositioning;
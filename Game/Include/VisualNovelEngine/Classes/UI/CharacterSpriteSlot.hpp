@@ -11,6 +11,12 @@ public:
 
     void push(CharacterSpriteDrawRequest *drawRequest);
 
+    void show(CharacterSprite *characterSprite);
+
+    CharacterSprite *getCharacterSprite() {
+        return currentCharacterSprite;
+    }
+
     Sprite *getSprite(int id);
 
     bool isDoingNothing() {
@@ -23,6 +29,7 @@ private:
     int id;
     int previousCharacterId;
     int currentCharacterId;
+    CharacterSprite *currentCharacterSprite;
     int alpha[2];
     static const int UPDATE_STATE_MORPHING = 2;
     static const int UPDATE_STATE_FADING = 1;
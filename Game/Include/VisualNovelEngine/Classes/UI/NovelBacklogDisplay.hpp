@@ -0,0 +1,38 @@
+#ifndef NOVEL_BACKLOG_DISPLAY_INCLUDED
+#define NOVEL_BACKLOG_DISPLAY_INCLUDED
+
+#include "VisualNovelEngine/Classes/Data/NovelBacklog.hpp"
+
+// How many backlog entries fit on the screen at once, only these are laid out and drawn
+#define NOVEL_BACKLOG_VISIBLE_ENTRIES 5
+
+/**
+ * Shows the lines in a NovelBacklog, newest at the bottom. Only the entries which are scrolled into view have their
+ * text read and wrapped, so opening and scrolling the backlog takes the same time however many entries it holds.
+ */
+class NovelBacklogDisplay {
+public:
+  NovelBacklogDisplay(TextRenderer *tRenderer, NovelData *novelData, NovelBacklog *novelBacklog);
+  ~NovelBacklogDisplay();
+  void open();
+  void close();
+  bool isOpen() {
+    return opened;
+  }
+  void scroll(int entries);
+  void invalidate();
+private:
+  void layout();
+  TextRenderer *textRenderer;
+  FontManager *fontManager;
+  NovelData *novel;
+  NovelBacklog *backlog;
+  Text *nameText[NOVEL_BACKLOG_VISIBLE_ENTRIES];
+  Text *lineText[NOVEL_BACKLOG_VISIBLE_ENTRIES];
+  int shownLineId[NOVEL_BACKLOG_VISIBLE_ENTRIES]; // The text and name of a row are only read again when its line changes
+  int scrollPosition; // How many entries the newest entry has been scrolled past
+  int maxTextWidth;
+  bool opened;
+};
+
+#endif
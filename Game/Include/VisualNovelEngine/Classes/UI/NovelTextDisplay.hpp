@@ -9,16 +9,23 @@ public:
   void update();
   void displayWholeStringImmediately();
   void setText(std::string newText, std::string cName);
+  std::string getText() {
+    return text;
+  }
+  std::string getCharacterName() {
+    return characterName;
+  }
   void setVisible();
   void setInvisible();
   void clear();
+  static std::string wordWrap(std::string textToWrap, Font *font, float maxWidth);
 private:
-  std::string wordWrap(std::string textToWrap, float maxWidth);
   TextRenderer *textRenderer;
   FontManager *fontManager;
   SpriteRenderer *spriteRenderer;
   ResourceManager *resourceManager;
   std::string storyFont;
+  std::string text; // As it was given, before being wrapped
   std::string currentDisplayText;
   std::string fullDisplayText;
   std::string characterName;
@@ -2,5 +2,6 @@
 #define NOVEL_SCREEN_CLASSES_INCLUDED
 
 #include "VisualNovelEngine/Classes/UI/NovelTextDisplay.hpp"
+#include "VisualNovelEngine/Classes/UI/NovelBacklogDisplay.hpp"
 
 #endif
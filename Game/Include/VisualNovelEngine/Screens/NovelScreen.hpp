@@ -2,14 +2,22 @@
 #define NOVEL_SCREEN_INCLUDED
 
 #include "VisualNovelEngine/NovelScreenClasses.hpp"
+#include "VisualNovelEngine/Classes/Data/SaveGameWriter.hpp"
+#include "VisualNovelEngine/Classes/Data/ReadTextLog.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelRollback.hpp"
+#include "VisualNovelEngine/Classes/Data/ScriptLibrary.hpp"
+#include "VisualNovelEngine/Classes/Data/ScriptMachine.hpp"
 
-class NovelScreen {
+class NovelScreen : public ScriptHost {
 public:
   NovelScreen(Engine *enginePointer, NovelData *novelPointer);
   ~NovelScreen();
   void start();
   void update();
   void draw();
+  void setSkipUnreadText(bool shouldSkipUnreadText) {
+    skipUnreadText = shouldSkipUnreadText;
+  }
 private:
   Engine *engine;
   sf::RenderWindow *window;
@@ -30,7 +38,54 @@ private:
   void nextSegment();
   void nextScene();
   void transitionToNextScene();
+  void quickSave();
+  void quickLoad();
+  void restore(const SaveGame &saveGame);
+  void rollBack(int lineCount);
+  void showImmediately(InternedString backgroundName, const std::vector<CharacterSprite*> &sprites,
+                       const std::string &text, const std::string &characterName);
+  void resumeMusic(InternedString musicName);
+  void setSkipping(bool shouldSkip);
+  void skip();
+  void showSkippedLines();
+  void openBacklog();
+  void closeBacklog();
+  void updateBacklog();
+  int quickSaveEventId;
+  int quickLoadEventId;
+  SaveGameWriter *saveGameWriter;
+  ReadTextLog readText;
+  int skipEventId;
+  bool skipping;
+  bool skipUnreadText;
+  NovelSceneSegmentLine *skippedLine; // The last line skipped this frame, which is the only one shown
+  std::vector<CharacterSprite*> skippedCharacterSprites; // The last sprites shown by a line skipped this frame
+  bool skippedCharacterSpritesChanged; // Whether any line skipped this frame showed sprites
+  InternedString skippedMusicName; // The last music started by a segment skipped this frame
+  NovelBacklog backlog;
+  NovelBacklogDisplay *backlogDisplay;
+  int backlogEventId;
+  int backlogScrollUpEventId;
+  int backlogScrollDownEventId;
+  int backlogCloseEventId;
+  NovelRollback rollback;
+  int rollbackEventId;
+  int localeEventId;
+  void nextLocale();
   bool sceneTransitioning; // Indicates that we need to advance the scene after an end transition
+  ScriptLibrary scripts;
+  ScriptMachine scriptMachine; // Runs the script started by the current segment, if it hasn't finished
+  void runScript();
+  NovelFlags &getScriptFlags() override;
+  void changeFlag(const NovelFlagChange &change) override;
+  void showBackground(InternedString backgroundName) override;
+  void morphBackground(InternedString backgroundName, int milliseconds) override;
+  void fadeInBackground(int milliseconds) override;
+  void fadeOutBackground(int milliseconds) override;
+  bool isBackgroundTransitioning() override;
+  bool showSprite(int slot, CharacterSprite *characterSprite) override;
+  void playMusic(InternedString musicName) override;
+  void stopMusic() override;
 };
 
 #endif
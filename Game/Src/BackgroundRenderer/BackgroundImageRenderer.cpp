@@ -3,6 +3,7 @@
 #include <sstream>
 #include <SFML/Graphics.hpp>
 #include "Database/DatabaseConnection.hpp"
+#include "Database/QueryCursor.hpp"
 #include "BackgroundRenderer/BackgroundImageRenderer.hpp"
 
 BackgroundImageRenderer::BackgroundImageRenderer(sf::RenderWindow *windowPointer) {
@@ -95,57 +96,54 @@ void BackgroundImageRenderer::update() {
 
 void BackgroundImageRenderer::addAllFromDatabase(DatabaseConnection *db) {
 
-  DataSet *result = new DataSet();
+  QueryCursor result(db->prepare("SELECT * FROM background_images WHERE enabled IS TRUE;"));
 
-  db->executeQuery("SELECT * FROM background_images WHERE enabled IS TRUE;", result);
-
-  for (int i = 0; i < result->getRowCount(); i++) {
+  // Ignore every entry if either of the columns are missing
+  if (!(result.doesColumnExist("name") && result.doesColumnExist("filename"))) {
+    return;
+  }
 
-    // Ignore this entry if either of the columns are missing data
-    if (!(result->getRow(i)->doesColumnExist("name") && result->getRow(i)->doesColumnExist("filename"))) {
-      continue;
-    }
+  int idColumn = result.getColumnIndex("id");
+  int nameColumn = result.getColumnIndex("name");
+  int fileNameColumn = result.getColumnIndex("filename");
 
-    std::string name = result->getRow(i)->getColumn("name")->getRawData();
-    std::string fname = result->getRow(i)->getColumn("filename")->getRawData();
-    std::string id = result->getRow(i)->getColumn("id")->getRawData();
+  while (result.next()) {
 
     std::string fullFileName = "resource/backgrounds/";
-    fullFileName.append(fname);
+    fullFileName.append(result.getText(fileNameColumn));
 
-    Background *addedBackground = addBackground(name, fullFileName);
+    Background *addedBackground = addBackground(result.getString(nameColumn), fullFileName);
 
     if (!addedBackground) {
       return;
     }
 
     // If we have loaded a background, see if the background has any attributes in the database and apply them
-    DataSet *attributeResult = new DataSet();
-    std::ostringstream ss;
-    ss << "SELECT * FROM background_image_attributes WHERE background_image_id = " << id << " ORDER BY id DESC LIMIT 1;";
-    db->executeQuery(ss.str(), attributeResult);
+    QueryCursor attributeResult(
+            db->prepare("SELECT * FROM background_image_attributes WHERE background_image_id = ? ORDER BY id DESC LIMIT 1;")
+                    ->bind(1, result.getInteger(idColumn)));
 
-    if (attributeResult->getRowCount() == 1) {
+    if (attributeResult.next()) {
 
       float maxWidth = 0;
       float maxHeight = 0;
       float offsetLeft = 0;
       float offsetTop = 0;
 
-      if (attributeResult->getRow(0)->doesColumnExist("max_width")) {
-        maxWidth = std::atof(attributeResult->getRow(0)->getColumn("max_width")->getRawData().c_str());
+      if (attributeResult.doesColumnExist("max_width")) {
+        maxWidth = attributeResult.getFloat("max_width");
       }
 
-      if (attributeResult->getRow(0)->doesColumnExist("max_height")) {
-        maxHeight = std::atof(attributeResult->getRow(0)->getColumn("max_height")->getRawData().c_str());
+      if (attributeResult.doesColumnExist("max_height")) {
+        maxHeight = attributeResult.getFloat("max_height");
       }
 
-      if (attributeResult->getRow(0)->doesColumnExist("offset_left")) {
-        offsetLeft = std::atof(attributeResult->getRow(0)->getColumn("offset_left")->getRawData().c_str());
+      if (attributeResult.doesColumnExist("offset_left")) {
+        offsetLeft = attributeResult.getFloat("offset_left");
       }
 
-      if (attributeResult->getRow(0)->doesColumnExist("offset_top")) {
-        offsetTop = std::atof(attributeResult->getRow(0)->getColumn("offset_top")->getRawData().c_str());
+      if (attributeResult.doesColumnExist("offset_top")) {
+        offsetTop = attributeResult.getFloat("offset_top");
       }
 
       addedBackground->setAttributes(new BackgroundImageAttributes(maxWidth, maxHeight, offsetLeft, offsetTop));
@@ -159,6 +157,10 @@ void BackgroundImageRenderer::loadBackground(int id) {
 }
 
 int BackgroundImageRenderer::findBackground(std::string name) {
+  return findBackground(InternedString::find(name));
+}
+
+int BackgroundImageRenderer::findBackground(InternedString name) {
 
   for (int i = 0; i < MAX_BACKGROUNDS; i++) {
     if (background[i]) {
@@ -172,6 +174,10 @@ int BackgroundImageRenderer::findBackground(std::string name) {
 }
 
 void BackgroundImageRenderer::setBackground(std::string name) {
+  setBackground(InternedString::find(name));
+}
+
+void BackgroundImageRenderer::setBackground(InternedString name) {
   int bgId = findBackground(name);
 
   if (bgId < 0) {
@@ -183,6 +189,10 @@ void BackgroundImageRenderer::setBackground(std::string name) {
 }
 
 void BackgroundImageRenderer::setUpcomingBackground(std::string name) {
+    setUpcomingBackground(InternedString::find(name));
+}
+
+void BackgroundImageRenderer::setUpcomingBackground(InternedString name) {
     int bgId = findBackground(name);
 
     if (bgId < 0) {
@@ -193,6 +203,23 @@ void BackgroundImageRenderer::setUpcomingBackground(std::string name) {
     enableImageDrawing();
 }
 
+void BackgroundImageRenderer::clearUpcomingBackground() {
+  upcomingBackground = nullptr;
+}
+
+/**
+ * [BackgroundImageRenderer::getBackgroundName Returns the name of the background being shown, or being changed to]
+ * @return [The name, empty if there is no background]
+ */
+InternedString BackgroundImageRenderer::getBackgroundName() {
+
+  if (upcomingBackground) {
+    return upcomingBackground->getName();
+  }
+
+  return currentBackground ? currentBackground->getName() : InternedString();
+}
+
 void BackgroundImageRenderer::setBackgroundColour(sf::Color *colour) {
 
   if (backgroundColour) {
@@ -109,6 +109,35 @@ bool BackgroundTransition::update() {
     return true;
 }
 
+/**
+ * [BackgroundTransition::finish Jumps to the end of the transition, without waiting for its delays or animation]
+ */
+void BackgroundTransition::finish() {
+
+    delete (startDelayClock);
+    startDelayClock = nullptr;
+    delay = 0;
+
+    switch (type) {
+        case FADE_IN:
+            alpha = 0;
+            backgroundOverlay->setAlpha(alpha);
+            break;
+        case FADE_OUT:
+            alpha = 255;
+            backgroundOverlay->setAlpha(alpha);
+            break;
+        case MORPH:
+            alpha = 0;
+            backgroundImageRenderer->setBackgroundAlpha(alpha);
+            break;
+        default:
+            break;
+    }
+
+    transitionCompleted = true;
+}
+
 // Transition-specific init functions
 void BackgroundTransition::FadeInInit() {
     alpha = 255;
@@ -49,6 +49,32 @@ bool BackgroundTransitionHandler::hasTransitionCompleted() {
     return !currentTransition;
 }
 
+/**
+ * Stops the current transition where it is, and clears the overlay it was drawing
+ */
+void BackgroundTransitionHandler::cancelTransition() {
+    delete (currentTransition);
+    currentTransition = nullptr;
+
+    backgroundOverlay->setAlpha(0);
+    backgroundImageRenderer->clearUpcomingBackground();
+    backgroundImageRenderer->setBackgroundAlpha(255);
+}
+
+/**
+ * Ends the current transition straight away, leaving the screen as it would be once the transition had finished
+ */
+void BackgroundTransitionHandler::finishTransition() {
+
+    if (!currentTransition) {
+        return;
+    }
+
+    currentTransition->finish();
+    delete (currentTransition);
+    currentTransition = nullptr;
+}
+
 void BackgroundTransitionHandler::setScreenSize(int width, int height) {
     screenWidth = width;
     screenHeight = height;
@@ -13,6 +13,7 @@
 #include "Base/GameManager.hpp"
 #include <thread>
 #include <chrono>
+#include <future>
 #include "Base/Game.hpp"
 
 /**
@@ -26,15 +27,43 @@ Game::Game() = default;
 Game::~Game() {
     delete (gameManager);
     delete (engine);
+    delete (loadingProgress);
 }
 
 /**
  * [Game::run Initialise and run the game]
  */
 void Game::run() {
+    // Measures the time taken to load the game and show its first line
+    loadingProgress = new LoadingProgress();
+
     // Load from config file
     auto configHandler = new ConfigHandler();
 
+    // Must be set before the engine opens any databases, a mode given on the command line is kept
+    DatabaseConnectionProfile::setRuntimeProfile(configHandler->getConfig()->getDatabaseProfile());
+
+    // The novel is read on its own pooled connection while the window is created and the resources are loaded
+    NovelResidency residency;
+
+    switch (configHandler->getConfig()->getNovelResidency()) {
+        case ConfigConstants::NOVEL_RESIDENCY_WINDOWED:
+            residency = NovelResidency::Windowed;
+            break;
+        case ConfigConstants::NOVEL_RESIDENCY_IMAGE:
+            residency = NovelResidency::Image;
+            break;
+        default:
+            residency = NovelResidency::Full;
+            break;
+    }
+
+    std::string locale = configHandler->getConfig()->getLocale();
+
+    std::future<NovelData *> novelLoad = std::async(std::launch::async, [residency, locale, this] {
+        return new NovelData(residency, loadingProgress, 0, locale);
+    });
+
     // Initialise SFML
     int style;
 
@@ -58,13 +87,26 @@ void Game::run() {
     engine = new Engine(window);
     std::string errorMessage = engine->getErrorMessage();
 
-    // We throw exceptions when attempting to load resources, so store it so that we can get to the graphical error screen
-    try {
-        if (errorMessage.empty()) {
-            engine->getResourceManager()->loadResourcesFromDatabase();
-        }
-    } catch (GeneralException &e) {
-        errorMessage = e.what();
+    // The resource catalogue is read while the novel loads, the novel's sprites are then linked to their textures.
+    // Any exception thrown is rethrown to the GameManager, which shows the graphical error screen
+    std::future<NovelData *> gameLoad;
+
+    if (errorMessage.empty()) {
+        loadingProgress->addSteps(1);
+
+        gameLoad = std::async(std::launch::async, [this, novelLoad = std::move(novelLoad)]() mutable {
+            engine->getResourceManager()->loadResourcesFromDatabase(loadingProgress);
+
+            NovelData *novel = novelLoad.get();
+
+            loadingProgress->beginStep("Linking character sprites");
+            engine->getCharacterSpriteRenderer()->initData(novel);
+            loadingProgress->completeStep();
+
+            return novel;
+        });
+    } else {
+        gameLoad = std::move(novelLoad);
     }
 
     // Create ResourceManager to spin up the resource loading thread
@@ -77,7 +119,8 @@ void Game::run() {
     characterSpriteRenderer = engine->getCharacterSpriteRenderer();
     backgroundTransitionRenderer = engine->getBackgroundTransitionRenderer();
 
-    gameManager = new GameManager(engine, errorMessage);
+    gameManager = new GameManager(engine, errorMessage, std::move(gameLoad), loadingProgress,
+                                  configHandler->getConfig());
 
     sf::Clock updateClock;
 
@@ -131,6 +174,12 @@ void Game::update(int gameTime) {
         return;
     }
 
+    // The resource catalogue is still being filled on another thread, so only the loading screen is updated
+    if (gameManager->isLoading()) {
+        gameManager->update();
+        return;
+    }
+
     inputManager->update();
     resourceManager->update();
     gameManager->update();
@@ -155,6 +204,10 @@ void Game::draw() {
 
     gameManager->draw();
 
+    if (gameManager->isLoading()) {
+        return;
+    }
+
     // We don't want to update anything beyond here if the engine didn't start properly
     if (!engine->getErrorMessage().empty()) {
         return;
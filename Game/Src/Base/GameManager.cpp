@@ -4,13 +4,28 @@
 #include "VisualNovelEngine/Classes/Data/Novel.hpp"
 #include "Base/Engine.hpp"
 #include "Base/GameManager.hpp"
+#include <iostream>
 #include <sstream>
 
-GameManager::GameManager(Engine *enginePointer, const std::string &initialErrorMessage) {
-    currentGameState = GameState::Init;
+/**
+ * @param enginePointer       the engine
+ * @param initialErrorMessage an error which occurred while the engine was starting, shown instead of the game if set
+ * @param gameLoad            the novel and resource catalogue, being loaded on another thread
+ * @param loadingProgress     the progress of that load
+ * @param gameConfig          the player's settings
+ */
+GameManager::GameManager(Engine *enginePointer, const std::string &initialErrorMessage,
+                         std::future<NovelData *> gameLoad, LoadingProgress *loadingProgress, Config *gameConfig) {
+    currentGameState = GameState::Loading;
 
     engine = enginePointer;
-    sf::RenderWindow *window = engine->getWindow();
+    progress = loadingProgress;
+    config = gameConfig;
+    novelLoad = std::move(gameLoad);
+    novel = nullptr;
+    novelScreen = nullptr;
+    errorScreen = nullptr;
+    loadingScreen = nullptr;
 
     if (!initialErrorMessage.empty()) {
         invokeErrorScreen(initialErrorMessage);
@@ -20,25 +35,15 @@ GameManager::GameManager(Engine *enginePointer, const std::string &initialErrorM
     inputManager = engine->getInputManager();
     resourceManager = engine->getResourceManager();
 
-    // Create other objects
-    errorScreen = nullptr;
-
-    try {
-        novel = new NovelData();
-        engine->getCharacterSpriteRenderer()->initData(novel);
-
-        std::string windowTitle = novel->getProjectInformation()->getGameTitle();
-        window->setTitle(windowTitle);
-
-        // Create each game GameScreen
-        novelScreen = new NovelScreen(engine, novel);
-    } catch (GeneralException &e) {
-        invokeErrorScreen(e);
-    }
-
+    // Shown until the load has finished, the window keeps responding in the meantime
+    loadingScreen = new LoadingScreen(engine->getWindow(), progress);
+    loadingScreen->start();
 }
 
-GameManager::~GameManager() = default;
+GameManager::~GameManager() {
+    delete (novelScreen);
+    delete (loadingScreen);
+}
 
 void GameManager::init() {
 
@@ -49,6 +54,13 @@ void GameManager::update() {
     try {
 
         switch (currentGameState) {
+            case GameState::Loading:
+                loadingScreen->update();
+
+                if (novelLoad.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                    finishLoading();
+                }
+                return;
             case GameState::Novel:
                 novelScreen->update();
                 return;
@@ -72,6 +84,9 @@ void GameManager::draw() {
 
     try {
         switch (currentGameState) {
+            case GameState::Loading:
+                loadingScreen->draw();
+                return;
             case GameState::Novel:
                 novelScreen->draw();
                 return;
@@ -86,6 +101,30 @@ void GameManager::draw() {
     }
 }
 
+/**
+ * Creates the game screens once the novel has been loaded
+ */
+void GameManager::finishLoading() {
+
+    // Any exception thrown while the novel was loading is rethrown here
+    novel = novelLoad.get();
+
+    std::cout << "Loaded in " << progress->getElapsedMilliseconds() << "ms" << std::endl;
+
+    std::string windowTitle = novel->getProjectInformation()->getGameTitle();
+    engine->getWindow()->setTitle(windowTitle);
+
+    // Create each game GameScreen
+    novelScreen = new NovelScreen(engine, novel);
+    novelScreen->setSkipUnreadText(config->shouldSkipUnreadText());
+
+    delete (loadingScreen);
+    loadingScreen = nullptr;
+
+    // The novel starts once the resources queued by the load have been loaded
+    currentGameState = GameState::Init;
+}
+
 void GameManager::updateWindowPointers(sf::RenderWindow *windowPointer) {
     // TODO: Update the window pointer on every class which needs it.
 }
@@ -96,6 +135,9 @@ void GameManager::changeScreen(GameState newState) {
         switch (newState) {
             case GameState::Novel:
                 novelScreen->start();
+
+                // The first line has been handed to the text display
+                std::cout << "Time to first line: " << progress->getElapsedMilliseconds() << "ms" << std::endl;
                 break;
             default:
                 break;
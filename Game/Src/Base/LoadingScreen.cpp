@@ -0,0 +1,91 @@
+#include <SFML/System.hpp>
+#include <SFML/Graphics.hpp>
+#include "Base/LoadingScreen.hpp"
+
+#define LOADING_BAR_WIDTH 400
+#define LOADING_BAR_HEIGHT 8
+
+/**
+ * @param window          the window which we will be drawing to
+ * @param loadingProgress the progress of the load, updated by the threads doing the loading
+ */
+LoadingScreen::LoadingScreen(sf::RenderWindow *window, LoadingProgress *loadingProgress) {
+    mainWindow = window;
+    progress = loadingProgress;
+    loadingFont = nullptr;
+    descriptionText = nullptr;
+    progressBarOutline = nullptr;
+    progressBar = nullptr;
+}
+
+LoadingScreen::~LoadingScreen() {
+    delete (descriptionText);
+    delete (progressBarOutline);
+    delete (progressBar);
+    delete (loadingFont);
+}
+
+/**
+ * Start the loading screen - Creates the bar and, if the system font can be loaded, the text describing the current step
+ */
+void LoadingScreen::start() {
+    float windowWidth = mainWindow->getSize().x;
+    float windowHeight = mainWindow->getSize().y;
+
+    float xPosition = (windowWidth / 2) - (LOADING_BAR_WIDTH / 2);
+    float yPosition = (windowHeight / 2) - (LOADING_BAR_HEIGHT / 2);
+
+    progressBarOutline = new sf::RectangleShape(sf::Vector2f(LOADING_BAR_WIDTH, LOADING_BAR_HEIGHT));
+    progressBarOutline->setFillColor(sf::Color::Transparent);
+    progressBarOutline->setOutlineColor(sf::Color(128, 128, 128));
+    progressBarOutline->setOutlineThickness(1);
+    progressBarOutline->setPosition(xPosition, yPosition);
+
+    progressBar = new sf::RectangleShape(sf::Vector2f(0, LOADING_BAR_HEIGHT));
+    progressBar->setFillColor(sf::Color::White);
+    progressBar->setPosition(xPosition, yPosition);
+
+    // The bar is still shown without a font, as there is nothing to be done about it until loading has finished
+    loadingFont = new sf::Font();
+
+    if (!loadingFont->loadFromFile("Resource/fonts/system.ttf")) {
+        delete (loadingFont);
+        loadingFont = nullptr;
+        return;
+    }
+
+    descriptionText = new sf::Text();
+    descriptionText->setFont(*loadingFont);
+    descriptionText->setFillColor(sf::Color::White);
+    descriptionText->setCharacterSize(16);
+    descriptionText->setPosition(xPosition, yPosition + 20);
+}
+
+/**
+ * Show how far the load has got
+ */
+void LoadingScreen::update() {
+
+    if (progressBar) {
+        progressBar->setSize(sf::Vector2f(LOADING_BAR_WIDTH * progress->getFraction(), LOADING_BAR_HEIGHT));
+    }
+
+    if (descriptionText) {
+        descriptionText->setString(progress->getDescription());
+    }
+}
+
+void LoadingScreen::draw() {
+
+    if (progressBarOutline) {
+        mainWindow->draw(*progressBarOutline);
+    }
+
+    if (progressBar) {
+        mainWindow->draw(*progressBar);
+    }
+
+    if (descriptionText) {
+        mainWindow->draw(*descriptionText);
+    }
+}
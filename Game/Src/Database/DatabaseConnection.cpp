@@ -4,37 +4,70 @@
 #include <cstring>
 #include <string>
 #include <sstream>
+#include <cstdlib>
+#include <algorithm>
 #include "Database/DatabaseConnection.hpp"
 #include "Misc/Utils.hpp"
-#include <regex>
 #include <Exceptions/DatabaseException.hpp>
 
-DatabaseConnection::DatabaseConnection(const std::string& name) {
+DatabaseConnection::DatabaseConnection(const std::string& name) : DatabaseConnection(name, DatabaseConnectionProfile()) {
+}
+
+/**
+ * [DatabaseConnection::DatabaseConnection Opens a database from the db folder]
+ * @param name    [Name of the database file]
+ * @param profile [How the file should be opened, and the cache settings to use]
+ */
+DatabaseConnection::DatabaseConnection(const std::string& name, const DatabaseConnectionProfile &profile) {
 
     // Initialise values and open database connection
     zErrMsg = nullptr;
     db = nullptr;
+    transactionDepth = 0;
+    usable = false;
+    this->name = name;
 
     std::string filename = "db/";
     filename.append(name);
 
-    // Convert the string to a char array
-    char *fName = new char[filename.length() + 1];
-    std::strcpy(fName, filename.c_str());
-
-    rc = sqlite3_open(fName, &db);
-    delete[] fName;
+    switch (profile.mode) {
+        case DatabaseOpenMode::ReadOnly:
+            rc = openReadOnly(filename, &db);
+            break;
+        case DatabaseOpenMode::Memory:
+            rc = openInMemory(filename);
+            break;
+        default:
+            rc = sqlite3_open(filename.c_str(), &db);
+            break;
+    }
 
-    if (rc) {
+    if (rc != SQLITE_OK) {
         std::cout << "Error opening/creating database" << std::endl;
-        usable = false;
+        return;
     }
 
     usable = true;
 
+    if (profile.mmapSize > 0) {
+        setPragma("mmap_size", std::to_string(profile.mmapSize));
+    }
+
+    // A negative cache size is a number of KiB rather than a number of pages
+    if (profile.cacheSizeKiB > 0) {
+        setPragma("cache_size", std::to_string(-profile.cacheSizeKiB));
+    }
 }
 
 DatabaseConnection::~DatabaseConnection() {
+
+    // Statements must be finalised before the connection can be closed
+    for (auto &cachedStatements : statementCache) {
+        for (auto &cachedStatement : cachedStatements.second) {
+            delete cachedStatement;
+        }
+    }
+
     sqlite3_close(db);
 }
 
@@ -44,215 +77,337 @@ DatabaseConnection::~DatabaseConnection() {
  * @param destinationDataSet [A result set in which to save the results from the query]
  */
 void DatabaseConnection::executeQuery(const std::string& query, DataSet *destinationDataSet) {
+    PreparedStatement statement(db, query);
+    statement.execute(destinationDataSet);
+}
 
-    sqlite3_stmt *statement;
+/**
+ * [DatabaseConnection::executeQuery Execute a query with no result data - this should be used for writing data]
+ * @param query [Query string]
+ * @return last insert ID
+ */
+int DatabaseConnection::executeQuery(const std::string& query) {
+    PreparedStatement statement(db, query);
+    statement.execute();
+    return this->getLastInsertId();
+}
 
-#ifdef DATABASE_DEBUG
-    std::cout<<"Execute SQL statement: "<<query<<std::endl;
-#endif
+/**
+ * [DatabaseConnection::prepare Returns a compiled statement for the given query, compiling it only the first time it is seen]
+ * @param query [A query string, using ? for any values which change between executions]
+ * @return      [The cached statement, owned by this connection]
+ */
+PreparedStatement *DatabaseConnection::prepare(const std::string &query) {
 
-    char *queryString = new char[query.length() + 1];
-    std::strcpy(queryString, query.c_str());
+    std::vector<PreparedStatement *> &cachedStatements = statementCache[query];
 
-    if (sqlite3_prepare_v2(db, queryString, -1, &statement, nullptr) == SQLITE_OK) {
+    // A statement which a cursor is still reading from can't be re-run, so nested reads of the same query get their own
+    for (auto &cachedStatement : cachedStatements) {
+        if (!cachedStatement->isBusy()) {
+            return cachedStatement;
+        }
+    }
 
-        // Clear the data set, and populate it with the results of the query
-        destinationDataSet->clear();
+    auto *statement = new PreparedStatement(db, query);
+    cachedStatements.push_back(statement);
+    return statement;
+}
 
-        int columns = sqlite3_column_count(statement);
-        int result = 0;
-        int rows = 0;
+int DatabaseConnection::getLastInsertId() {
+    return static_cast<int>(sqlite3_last_insert_rowid(db));
+}
 
-        // Loop until we have run out of rows
-        while (true) {
+/**
+ * [DatabaseConnection::insert Inserts a row into the database]
+ * @param tableName [The name of the table]
+ * @param columns   [Array of strings with column names]
+ * @param values    [Array of strings containing the values]
+ * @param valuesCount [The number of values to insert]
+ * @return last insert ID
+ */
+int DatabaseConnection::insert(const std::string &tableName, const std::vector<std::string>& columns,
+                               std::vector<std::string>& values, std::vector<int> types) {
 
-            result = sqlite3_step(statement);
+    if (columns.size() != values.size() || types.size() != columns.size()) {
+        throw DatabaseException("The number of given columns and the number of given values does not match.");
+    }
 
-            if (result == SQLITE_ROW) {
+    std::vector<std::string> placeholders(values.size(), "?");
+
+    std::vector<std::string> query = {
+            "INSERT INTO `", tableName, "` (", Utils::implodeString(columns, ", ", 0), ") VALUES (",
+            Utils::implodeString(placeholders, ", ", 0), ");"
+    };
 
-                // Add a row to the data set
-                DataSetRow *row = destinationDataSet->addRow();
+    PreparedStatement *statement = prepare(Utils::implodeString(query));
 
-                for (int col = 0; col < columns; col++) {
+    for (unsigned int i = 0; i < values.size(); i++) {
+        bindValue(statement, i + 1, values[i], types[i]);
+    }
 
-                    bool isNull = sqlite3_column_type(statement, col) == SQLITE_NULL;
+#ifdef PRINT_QUERIES
+    std::cout<<statement->getQuery()<<std::endl;
+#endif
 
-                    if (sqlite3_column_text(statement, col)) {
-                        // Add a column to the row
+    return statement->execute();
 
-                        const char *cName = sqlite3_column_name(statement, col);
-                        const char *cData = reinterpret_cast<const char *>(sqlite3_column_text(statement, col));
+}
 
-                        std::string columnName((cName ? cName : ""));
-                        std::string data(cData ? cData : "");
+/**
+ * [DatabaseConnection::insert Inserts many rows into the database, using as few statements as possible]
+ * @param tableName [The name of the table]
+ * @param columns   [Array of strings with column names]
+ * @param rows      [Array of rows, each containing one value for each of the columns]
+ * @param types     [The data type of each column]
+ * @return          [Last insert ID, this is the ID of the last row given. Within a transaction the rows will have consecutive IDs]
+ */
+int DatabaseConnection::insert(const std::string &tableName, const std::vector<std::string> &columns,
+                               std::vector<std::vector<std::string>> &rows, std::vector<int> types) {
 
-                        row->addColumn(columnName, data, false);
-                    } else if (isNull) {
-                        const char *cName = sqlite3_column_name(statement, col);
-                        std::string columnName = (cName ? cName : "");
-                        std::string data;
-                        row->addColumn(columnName, data, true);
-                    }
-                }
+    if (types.size() != columns.size() || columns.empty()) {
+        throw DatabaseException("The number of given columns and the number of given types does not match.");
+    }
 
-                rows++;
+    for (auto &row : rows) {
+        if (row.size() != columns.size()) {
+            throw DatabaseException("The number of given columns and the number of given values does not match.");
+        }
+    }
 
-            } else {
-                break;
-            }
+    // SQLite limits the number of parameters in a statement, the limit on rows also keeps the number of cached statements small
+    int maxParameters = sqlite3_limit(db, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+    unsigned int rowsPerStatement = std::max(1, std::min(INSERT_MAX_ROWS_PER_STATEMENT,
+                                                         maxParameters / static_cast<int>(columns.size())));
 
+    std::vector<std::string> placeholders(columns.size(), "?");
+    std::string rowPlaceholder = Utils::implodeString(std::vector<std::string> {
+            "(", Utils::implodeString(placeholders, ", ", 0), ")"
+    });
+
+    int lastInsertId = getLastInsertId();
+
+    for (unsigned int firstRow = 0; firstRow < rows.size(); firstRow += rowsPerStatement) {
+
+        unsigned int rowsInStatement = std::min(rowsPerStatement, static_cast<unsigned int>(rows.size()) - firstRow);
+
+        std::vector<std::string> rowPlaceholders(rowsInStatement, rowPlaceholder);
+        std::vector<std::string> query = {
+                "INSERT INTO `", tableName, "` (", Utils::implodeString(columns, ", ", 0), ") VALUES ",
+                Utils::implodeString(rowPlaceholders, ", ", 0), ";"
+        };
+
+        PreparedStatement *statement = prepare(Utils::implodeString(query));
+
+        int index = 1;
+
+        for (unsigned int i = firstRow; i < firstRow + rowsInStatement; i++) {
+            for (unsigned int j = 0; j < columns.size(); j++) {
+                bindValue(statement, index++, rows[i][j], types[j]);
+            }
         }
 
-#ifdef DATABASE_DEBUG
-        destinationDataSet->debugOutputContents();
+#ifdef PRINT_QUERIES
+        std::cout<<statement->getQuery()<<std::endl;
 #endif
 
-        sqlite3_finalize(statement);
-        delete[](queryString);
-        return;
+        lastInsertId = statement->execute();
     }
 
-    std::string error = sqlite3_errmsg(db);
+    return lastInsertId;
+}
 
-    if (error != "not an error") {
-        std::vector<std::string> errorVector = {
-                "An SQL error has occurred:\n",
-                error,
-                "\n\n",
-                query
-        };
+int DatabaseConnection::insert(const std::string& tableName) {
+    std::vector<std::string> query = {
+            "INSERT INTO `",
+            tableName,
+            "` DEFAULT VALUES"
+    };
 
-        throw DatabaseException(Utils::implodeString(errorVector));
-    }
+    return executeQuery(Utils::implodeString(query, ""));
 }
 
 /**
- * [DatabaseConnection::executeQuery Execute a query with no result data - this should be used for writing data]
- * @param query [Query string]
- * @return last insert ID
+ * [DatabaseConnection::beginTransaction Starts a transaction, nothing is written to disk until it is committed.
+ * Transactions can be nested, only the outermost one is sent to the database]
  */
-int DatabaseConnection::executeQuery(const std::string& query) {
-    sqlite3_stmt *statement;
-
-#ifdef DATABASE_DEBUG
-    std::cout<<"Execute SQL statement: "<<query<<std::endl;
-#endif
-
-    char *queryString = new char[query.length() + 1];
-    std::strcpy(queryString, query.c_str());
+void DatabaseConnection::beginTransaction() {
 
-    if (sqlite3_prepare_v2(db, queryString, -1, &statement, nullptr) == SQLITE_OK) {
-        sqlite3_step(statement);
-        sqlite3_finalize(statement);
-        return this->getLastInsertId();
+    if (transactionDepth == 0) {
+        prepare("BEGIN TRANSACTION;")->execute();
     }
 
-    std::string error = sqlite3_errmsg(db);
+    transactionDepth++;
+}
 
-    if (error != "not an error") {
-        std::vector<std::string> errorVector = {
-                "An SQL error has occurred:\n",
-                error,
-                "\n\n",
-                query
-        };
+/**
+ * [DatabaseConnection::commitTransaction Commits the current transaction, or leaves it open if this was a nested one]
+ */
+void DatabaseConnection::commitTransaction() {
 
-        throw DatabaseException(Utils::implodeString(errorVector));
+    if (transactionDepth == 0) {
+        throw DatabaseException("Unable to commit: there is no open transaction");
     }
 
-    return 0;
+    if (transactionDepth == 1) {
+        prepare("COMMIT TRANSACTION;")->execute();
+    }
 
+    transactionDepth--;
 }
 
-int DatabaseConnection::getLastInsertId() {
-
-    auto *dataSet = new DataSet();
-    this->executeQuery("SELECT last_insert_rowid() as last_insert_id", dataSet);
+/**
+ * [DatabaseConnection::rollbackTransaction Discards every change made since the outermost transaction began.
+ * This never throws, as it is usually called while an exception is already being handled]
+ */
+void DatabaseConnection::rollbackTransaction() {
 
-    if (!dataSet->getRow(0)->doesColumnExist("last_insert_id")) {
-        throw DatabaseException("Failed to get the last insert ID");
+    if (transactionDepth == 0) {
+        return;
     }
 
-    int lastInsertId = std::stoi(dataSet->getRow(0)->getColumn("last_insert_id")->getRawData());
-    delete (dataSet);
-    return lastInsertId;
+    transactionDepth = 0;
 
+    // SQLite may have already rolled back by itself after certain errors
+    if (!sqlite3_get_autocommit(db)) {
+        sqlite3_exec(db, "ROLLBACK TRANSACTION;", nullptr, nullptr, nullptr);
+    }
 }
 
 /**
- * [DatabaseConnection::insert Inserts a row into the database]
- * @param tableName [The name of the table]
- * @param columns   [Array of strings with column names]
- * @param values    [Array of strings containing the values]
- * @param valuesCount [The number of values to insert]
- * @return last insert ID
+ * [DatabaseConnection::setPragma Changes a setting on this connection. Values can't be bound for pragmas, so these
+ * must never come from user input]
+ * @param pragma [Name of the pragma, e.g. synchronous]
+ * @param value  [The value to set it to]
  */
-int DatabaseConnection::insert(const std::string &tableName, const std::vector<std::string>& columns,
-                               std::vector<std::string>& values, std::vector<int> types) {
+void DatabaseConnection::setPragma(const std::string &pragma, const std::string &value) {
 
-    if (columns.size() != values.size() || types.size() != columns.size()) {
-        throw DatabaseException("The number of given columns and the number of given values does not match.");
-    }
-
-    for (unsigned int i = 0; i < values.size(); i++) {
+    std::vector<std::string> query = {
+            "PRAGMA ", pragma, " = ", value, ";"
+    };
 
-        std::stringstream ss;
+    PreparedStatement statement(db, Utils::implodeString(query));
+    statement.execute();
+}
 
-        switch (types[i]) {
-            case DATA_TYPE_STRING:
+/**
+ * [DatabaseConnection::openReadOnly Opens a file read-only and immutable, which tells SQLite that nothing else will
+ * change it so that no locks are taken and the journal is never checked]
+ * @param  filename   [Path to the database file]
+ * @param  connection [Set to the opened connection]
+ * @return            [SQLite result code]
+ */
+int DatabaseConnection::openReadOnly(const std::string &filename, sqlite3 **connection) {
 
-                // If we actually want to set a string column to null...
-                if (values[i] == "NULL") {
-                    continue;
-                }
+    // Characters with a meaning in URIs must be escaped
+    std::string uri = "file:";
 
-                ss << "'" << sanitizeString(values[i]) << "'";
-                values[i] = ss.str();
+    for (char character : filename) {
+        switch (character) {
+            case '%':
+                uri.append("%25");
                 break;
-            default:
+            case '?':
+                uri.append("%3f");
+                break;
+            case '#':
+                uri.append("%23");
                 break;
+            default:
+                uri += character;
         }
     }
 
-    std::string queryPortionColumns = Utils::implodeString(columns, ", ", 0);
-    std::ostringstream columnsStream;
-    columnsStream << "(" << queryPortionColumns << ")";
-    queryPortionColumns = columnsStream.str();
+    uri.append("?immutable=1");
 
-    // TODO: Create an overloaded function which can handle inserting multiple rows at once
-    std::string queryPortionValues = Utils::implodeString(values, ", ", 0);
-    std::ostringstream valuesStream;
-    valuesStream << "VALUES (" << queryPortionValues << ")";
-    queryPortionValues = valuesStream.str();
+    return sqlite3_open_v2(uri.c_str(), connection, SQLITE_OPEN_READONLY | SQLITE_OPEN_URI, nullptr);
+}
 
-    std::ostringstream ss;
-    ss << "INSERT INTO `" << tableName << "` " << queryPortionColumns << " " << queryPortionValues << ";";
+/**
+ * [DatabaseConnection::openInMemory Copies a database file into an in-memory database using the backup API, the file
+ * is closed again once it has been copied]
+ * @param  filename [Path to the database file]
+ * @return          [SQLite result code]
+ */
+int DatabaseConnection::openInMemory(const std::string &filename) {
 
-#ifdef PRINT_QUERIES
-    std::cout<<ss.str()<<std::endl;
-#endif
+    sqlite3 *source = nullptr;
+    int result = openReadOnly(filename, &source);
 
-    return this->executeQuery(ss.str());
+    if (result == SQLITE_OK) {
+        result = sqlite3_open(":memory:", &db);
+    }
 
-}
+    if (result == SQLITE_OK) {
+        sqlite3_backup *backup = sqlite3_backup_init(db, "main", source, "main");
 
-int DatabaseConnection::insert(const std::string& tableName) {
-    std::vector<std::string> query = {
-            "INSERT INTO `",
-            tableName,
-            "` DEFAULT VALUES"
-    };
+        if (backup) {
+            sqlite3_backup_step(backup, -1);
+            sqlite3_backup_finish(backup);
+        }
 
-    return executeQuery(Utils::implodeString(query, ""));
+        result = sqlite3_errcode(db);
+    }
+
+    sqlite3_close(source);
+    return result;
 }
 
 /**
- * [DatabaseConnection::sanitizeString Remove any offending characters and escape things that need it]
- * @param  string [The string]
- * @return        [The sanitized string]
+ * [DatabaseConnection::bindValue Binds a value given as a string onto a statement using the most appropriate SQLite type]
+ * @param statement [The statement to bind to]
+ * @param index     [Index of the parameter, starting at 1]
+ * @param value     [The value, the string NULL will bind a null value]
+ * @param type      [One of the DATA_TYPE_ constants]
  */
-std::string DatabaseConnection::sanitizeString(const std::string &string) {
-    // TODO: There are probably more things that I need to put here.
-    std::regex apostropheRegex = std::regex("\'");
-    return regex_replace(string, apostropheRegex, "''");
+void DatabaseConnection::bindValue(PreparedStatement *statement, int index, const std::string &value, int type) {
+
+    if (value == "NULL") {
+        statement->bindNull(index);
+        return;
+    }
+
+    switch (type) {
+        case DATA_TYPE_STRING:
+        case DATA_TYPE_DATE:
+        case DATA_TYPE_DATE_TIME:
+            statement->bind(index, value);
+            return;
+        case DATA_TYPE_BOOLEAN:
+            if (value == "TRUE" || value == "true" || value == "1") {
+                statement->bind(index, 1);
+                return;
+            }
+
+            if (value == "FALSE" || value == "false" || value == "0") {
+                statement->bind(index, 0);
+                return;
+            }
+
+            break;
+        case DATA_TYPE_NUMBER: {
+            char *end = nullptr;
+            const char *start = value.c_str();
+
+            long long integerValue = std::strtoll(start, &end, 10);
+
+            if (!value.empty() && *end == '\0') {
+                statement->bind(index, static_cast<sqlite3_int64>(integerValue));
+                return;
+            }
+
+            double doubleValue = std::strtod(start, &end);
+
+            if (!value.empty() && *end == '\0') {
+                statement->bind(index, doubleValue);
+                return;
+            }
+
+            break;
+        }
+        default:
+            break;
+    }
+
+    // Anything that doesn't look like the type it claims to be gets stored as-is, SQLite's column affinity will deal with it
+    statement->bind(index, value);
 }
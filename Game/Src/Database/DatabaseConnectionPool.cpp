@@ -0,0 +1,160 @@
+#include <memory>
+#include <algorithm>
+#include "Database/DatabaseConnectionPool.hpp"
+#include "Misc/Utils.hpp"
+#include <Exceptions/DatabaseException.hpp>
+
+PooledConnection::PooledConnection(DatabaseConnectionPool *ownerPool, DatabaseConnection *pooledConnection) {
+    pool = ownerPool;
+    connection = pooledConnection;
+}
+
+PooledConnection::PooledConnection(PooledConnection &&other) noexcept {
+    pool = other.pool;
+    connection = other.connection;
+
+    other.connection = nullptr;
+}
+
+PooledConnection::~PooledConnection() {
+
+    if (!connection) {
+        return;
+    }
+
+    pool->release(connection);
+}
+
+/**
+ * [DatabaseConnectionPool::DatabaseConnectionPool Creates an empty pool, connections are opened as they are needed]
+ * @param databaseName       [Name of the database file in the db folder]
+ * @param connectionProfile  [Profile used to open the read connections, its poolSize limits how many are opened]
+ */
+DatabaseConnectionPool::DatabaseConnectionPool(const std::string &databaseName,
+                                               const DatabaseConnectionProfile &connectionProfile) {
+    name = databaseName;
+    profile = connectionProfile;
+    maxConnections = std::max(1, profile.poolSize);
+
+    // Without a thread safe build of SQLite, connections can't be used from more than one thread at once. Every
+    // in-memory connection holds a whole copy of the database, so only one is kept
+    if (!sqlite3_threadsafe() || profile.mode == DatabaseOpenMode::Memory) {
+        maxConnections = 1;
+    }
+}
+
+DatabaseConnectionPool::~DatabaseConnectionPool() {
+
+    for (auto &connection : connections) {
+        delete connection;
+    }
+}
+
+/**
+ * [DatabaseConnectionPool::getRuntimePool Returns the pool the runner uses for a database, creating it with the runtime profile the first time]
+ * @param  databaseName [novel or resource]
+ * @return              [The pool, which lives until the program exits]
+ */
+DatabaseConnectionPool *DatabaseConnectionPool::getRuntimePool(const std::string &databaseName) {
+
+    static std::mutex runtimePoolsMutex;
+    static std::unordered_map<std::string, std::unique_ptr<DatabaseConnectionPool>> runtimePools;
+
+    std::lock_guard<std::mutex> lock(runtimePoolsMutex);
+
+    std::unique_ptr<DatabaseConnectionPool> &pool = runtimePools[databaseName];
+
+    if (!pool) {
+        pool.reset(new DatabaseConnectionPool(databaseName, *DatabaseConnectionProfile::getRuntimeProfile()));
+    }
+
+    return pool.get();
+}
+
+/**
+ * [DatabaseConnectionPool::checkout Checks out a read connection for the current scope]
+ * @return [The connection, returned to the pool when it goes out of scope]
+ */
+PooledConnection DatabaseConnectionPool::checkout() {
+    return PooledConnection(this, acquire());
+}
+
+/**
+ * [DatabaseConnectionPool::tryCheckout Checks out a read connection for the current scope, without waiting for one]
+ * @return [The connection, its get() is nullptr if every connection the pool may open is already checked out]
+ */
+PooledConnection DatabaseConnectionPool::tryCheckout() {
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    if (!idleConnections.empty()) {
+        DatabaseConnection *connection = idleConnections.back();
+        idleConnections.pop_back();
+
+        return PooledConnection(this, connection);
+    }
+
+    if (static_cast<int>(connections.size()) < maxConnections) {
+        return PooledConnection(this, openConnection());
+    }
+
+    return PooledConnection(this, nullptr);
+}
+
+/**
+ * [DatabaseConnectionPool::acquire Takes a read connection out of the pool until release is called, for objects which
+ * keep a connection for their whole lifetime. checkout should be used otherwise]
+ * @return [The connection]
+ */
+DatabaseConnection *DatabaseConnectionPool::acquire() {
+
+    std::unique_lock<std::mutex> lock(poolMutex);
+
+    if (idleConnections.empty() && static_cast<int>(connections.size()) < maxConnections) {
+        return openConnection();
+    }
+
+    connectionReturned.wait(lock, [this] {
+        return !idleConnections.empty();
+    });
+
+    DatabaseConnection *connection = idleConnections.back();
+    idleConnections.pop_back();
+
+    return connection;
+}
+
+/**
+ * [DatabaseConnectionPool::release Returns a connection taken with acquire to the pool]
+ * @param connection [The connection]
+ */
+void DatabaseConnectionPool::release(DatabaseConnection *connection) {
+
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        idleConnections.push_back(connection);
+    }
+
+    connectionReturned.notify_one();
+}
+
+/**
+ * [DatabaseConnectionPool::openConnection Opens a new read connection for the pool, poolMutex must be held]
+ * @return [The connection, which is already counted as checked out]
+ */
+DatabaseConnection *DatabaseConnectionPool::openConnection() {
+
+    auto *connection = new DatabaseConnection(name, profile);
+
+    if (!connection->isUsable()) {
+        delete connection;
+
+        std::vector<std::string> error = {
+                "Unable to open the database '", name, "'"
+        };
+        throw DatabaseException(Utils::implodeString(error));
+    }
+
+    connections.push_back(connection);
+    return connection;
+}
@@ -0,0 +1,75 @@
+#include "Database/DatabaseConnectionProfile.hpp"
+
+bool DatabaseConnectionProfile::modeOverridden = false;
+
+/**
+ * [DatabaseConnectionProfile::getRuntimeProfile The profile used by the runner for the novel and resource databases]
+ * @return [The profile, it is read-only and memory-mapped unless something else has been set]
+ */
+DatabaseConnectionProfile *DatabaseConnectionProfile::getRuntimeProfile() {
+
+    static DatabaseConnectionProfile runtimeProfile = {
+            DatabaseOpenMode::ReadOnly, DATABASE_DEFAULT_MMAP_SIZE, DATABASE_DEFAULT_CACHE_SIZE_KIB,
+            DATABASE_DEFAULT_POOL_SIZE
+    };
+
+    return &runtimeProfile;
+}
+
+/**
+ * [DatabaseConnectionProfile::setRuntimeProfile Sets the runtime profile from the config file]
+ * @param profile [The new profile, its mode is ignored if one was given on the command line]
+ */
+void DatabaseConnectionProfile::setRuntimeProfile(const DatabaseConnectionProfile &profile) {
+
+    DatabaseConnectionProfile *runtimeProfile = getRuntimeProfile();
+    DatabaseOpenMode currentMode = runtimeProfile->mode;
+
+    *runtimeProfile = profile;
+
+    if (modeOverridden) {
+        runtimeProfile->mode = currentMode;
+    }
+}
+
+/**
+ * [DatabaseConnectionProfile::overrideRuntimeMode Sets the runtime mode from the command line, this takes priority over the config file]
+ * @param mode [The mode to open the databases in]
+ */
+void DatabaseConnectionProfile::overrideRuntimeMode(DatabaseOpenMode mode) {
+    getRuntimeProfile()->mode = mode;
+    modeOverridden = true;
+}
+
+/**
+ * [DatabaseConnectionProfile::parseMode Converts the name of a mode, as used in config.json and on the command line]
+ * @param  name [readwrite, readonly or memory]
+ * @param  mode [Set to the matching mode]
+ * @return      [False if the name is not a known mode]
+ */
+bool DatabaseConnectionProfile::parseMode(const std::string &name, DatabaseOpenMode &mode) {
+
+    if (name == "readwrite") {
+        mode = DatabaseOpenMode::ReadWrite;
+    } else if (name == "readonly") {
+        mode = DatabaseOpenMode::ReadOnly;
+    } else if (name == "memory") {
+        mode = DatabaseOpenMode::Memory;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+std::string DatabaseConnectionProfile::getModeName(DatabaseOpenMode mode) {
+
+    switch (mode) {
+        case DatabaseOpenMode::ReadOnly:
+            return "readonly";
+        case DatabaseOpenMode::Memory:
+            return "memory";
+        default:
+            return "readwrite";
+    }
+}
@@ -49,7 +49,9 @@ bool DatabaseSchema::createDatabase() {
         std::cout << "Database created/opened" << std::endl;
     }
 
-    // Create all of the tables
+    // Create all of the tables in a single transaction so that the file is only synced once
+    sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+
     for (auto &currentTable : table) {
         if (currentTable) {
 
@@ -88,9 +90,23 @@ bool DatabaseSchema::createDatabase() {
             } else {
                 std::cout << "Table " << currentTable->getName() << " created successfully." << std::endl;
             }
+
+            // Create the indexes for the table
+            for (auto &indexQuery : currentTable->getIndexCreationQueries()) {
+                rc = sqlite3_exec(db, indexQuery.c_str(), nullptr, nullptr, &zErrMsg);
+
+                if (rc != SQLITE_OK) {
+                    std::cout << "-----------" << std::endl << "Sql error:" << std::endl << zErrMsg << std::endl;
+                    std::cout << std::endl << "---------------------" << std::endl;
+                    std::cout << indexQuery << std::endl;
+                    sqlite3_free(zErrMsg);
+                }
+            }
         }
     }
 
+    sqlite3_exec(db, "COMMIT TRANSACTION;", nullptr, nullptr, nullptr);
+
     sqlite3_close(db);
     return true;
 }
@@ -155,10 +171,32 @@ DatabaseColumn *DatabaseTable::addPrimaryKey() {
     return addColumnInternal("id", ColumnType::tInteger, true, "", true);
 }
 
+/**
+ * [DatabaseTable::addForeignKey Adds an integer column which refers to a row in another table]
+ * @param  cName            [Name of the column]
+ * @param  foreignTableName [The table being referred to]
+ * @param  foreignTableId   [The column being referred to in the other table]
+ * @param  cNotNull         [Not null restriction on column]
+ * @return                  [Success: Pointer to column object, failure: nullptr]
+ */
 DatabaseColumn *DatabaseTable::addForeignKey(const std::string &cName, const std::string &foreignTableName,
-                                             const std::string &foreignTableId) {
-    // TODO: Implement this to enforce strict relations
-    return nullptr;
+                                             const std::string &foreignTableId, bool cNotNull) {
+
+    DatabaseColumn *foreignKeyColumn = addColumnInternal(cName, ColumnType::tInteger, cNotNull, "", false);
+
+    if (foreignKeyColumn) {
+        foreignKeyColumn->setForeignKey(foreignTableName, foreignTableId);
+    }
+
+    return foreignKeyColumn;
+}
+
+/**
+ * [DatabaseTable::addIndex Adds an index to the table, this should be done for any columns which rows are looked up by]
+ * @param columnNames [The columns to index, in order]
+ */
+void DatabaseTable::addIndex(const std::vector<std::string> &columnNames) {
+    indexes.push_back(columnNames);
 }
 
 /**
@@ -209,6 +247,35 @@ std::string DatabaseTable::getCreationQuery() {
     return ss.str();
 }
 
+/**
+ * [DatabaseTable::getIndexCreationQueries Creates a query string for each index on this table]
+ * @return [Query strings]
+ */
+std::vector<std::string> DatabaseTable::getIndexCreationQueries() {
+
+    std::vector<std::string> queries;
+
+    for (auto &index : indexes) {
+        std::stringstream indexName;
+        std::stringstream indexColumns;
+
+        indexName << name;
+
+        for (unsigned int i = 0; i < index.size(); i++) {
+            indexName << "_" << index[i];
+            indexColumns << (i == 0 ? "" : ", ") << index[i];
+        }
+
+        indexName << "_index";
+
+        std::stringstream ss;
+        ss << "CREATE INDEX " << indexName.str() << " ON " << name << " (" << indexColumns.str() << ");";
+        queries.push_back(ss.str());
+    }
+
+    return queries;
+}
+
 /**
  * [DatabaseTable::outputTableInfo Outputs the table information to the console]
  */
@@ -274,9 +341,23 @@ std::string DatabaseColumn::getCreationQuery() {
             << (notNull ? " NOT NULL " : "")
             << "DEFAULT NULL";
 
+    if (!foreignTable.empty()) {
+        ss << " REFERENCES " << foreignTable << "(" << foreignColumn << ")";
+    }
+
     return ss.str();
 }
 
+/**
+ * [DatabaseColumn::setForeignKey Makes this column refer to a column in another table]
+ * @param foreignTableName  [The table being referred to]
+ * @param foreignColumnName [The column being referred to]
+ */
+void DatabaseColumn::setForeignKey(const std::string &foreignTableName, const std::string &foreignColumnName) {
+    foreignTable = foreignTableName;
+    foreignColumn = foreignColumnName;
+}
+
 // DatabaseSchemaUtils class
 std::string DatabaseSchemaUtils::getType(ColumnType columnType) {
 
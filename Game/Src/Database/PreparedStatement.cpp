@@ -0,0 +1,229 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "Database/DatabaseConnection.hpp"
+#include "Database/PreparedStatement.hpp"
+#include "Database/QueryProfiler.hpp"
+#include "Misc/Utils.hpp"
+#include <Exceptions/DatabaseException.hpp>
+
+/**
+ * [PreparedStatement::PreparedStatement Compiles the given query so that it can be executed]
+ * @param database    [The database connection to compile the query against]
+ * @param queryString [The query, using ? for any parameters]
+ */
+PreparedStatement::PreparedStatement(sqlite3 *database, const std::string &queryString) {
+    db = database;
+    query = queryString;
+    statement = nullptr;
+    inUse = false;
+
+    if (sqlite3_prepare_v2(db, query.c_str(), static_cast<int>(query.length() + 1), &statement, nullptr) != SQLITE_OK) {
+        throwError();
+    }
+}
+
+PreparedStatement::~PreparedStatement() {
+    sqlite3_finalize(statement);
+}
+
+PreparedStatement *PreparedStatement::bind(int index, int value) {
+    checkBindResult(sqlite3_bind_int(statement, index, value), index);
+    return this;
+}
+
+PreparedStatement *PreparedStatement::bind(int index, sqlite3_int64 value) {
+    checkBindResult(sqlite3_bind_int64(statement, index, value), index);
+    return this;
+}
+
+PreparedStatement *PreparedStatement::bind(int index, double value) {
+    checkBindResult(sqlite3_bind_double(statement, index, value), index);
+    return this;
+}
+
+PreparedStatement *PreparedStatement::bind(int index, const std::string &value) {
+    checkBindResult(sqlite3_bind_text(statement, index, value.c_str(), static_cast<int>(value.length()), SQLITE_TRANSIENT),
+                    index);
+    return this;
+}
+
+PreparedStatement *PreparedStatement::bind(int index, const char *value) {
+    return bind(index, std::string(value));
+}
+
+PreparedStatement *PreparedStatement::bindNull(int index) {
+    checkBindResult(sqlite3_bind_null(statement, index), index);
+    return this;
+}
+
+/**
+ * [PreparedStatement::execute Executes the statement with the currently-bound parameters]
+ * @param destinationDataSet [A result set in which to save the results from the query]
+ */
+void PreparedStatement::execute(DataSet *destinationDataSet) {
+
+#ifdef DATABASE_DEBUG
+    std::cout<<"Execute SQL statement: "<<query<<std::endl;
+#endif
+
+    // Clear the data set, and populate it with the results of the query
+    destinationDataSet->clear();
+
+    // An empty query compiles to no statement at all, so there is nothing to run
+    if (!statement) {
+        return;
+    }
+
+    bool profiling = QueryProfiler::isEnabled();
+    auto startTime = profiling ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    int columns = sqlite3_column_count(statement);
+    int result;
+
+    // Column names are only stored once for the whole result
+    std::vector<std::string> columnNames;
+
+    for (int col = 0; col < columns; col++) {
+        const char *cName = sqlite3_column_name(statement, col);
+        columnNames.emplace_back(cName ? cName : "");
+    }
+
+    destinationDataSet->setColumns(columnNames);
+
+    // Loop until we have run out of rows
+    while ((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+        // Add a row to the data set
+        destinationDataSet->addRow();
+
+        // Values are kept in the storage class SQLite returned them in, so numbers are never converted to text
+        for (int col = 0; col < columns; col++) {
+
+            switch (sqlite3_column_type(statement, col)) {
+                case SQLITE_INTEGER:
+                    destinationDataSet->addInteger(sqlite3_column_int64(statement, col));
+                    break;
+                case SQLITE_FLOAT:
+                    destinationDataSet->addFloat(sqlite3_column_double(statement, col));
+                    break;
+                case SQLITE_BLOB: {
+                    const void *blob = sqlite3_column_blob(statement, col);
+                    destinationDataSet->addBlob(blob, static_cast<unsigned int>(sqlite3_column_bytes(statement, col)));
+                    break;
+                }
+                case SQLITE_NULL:
+                    destinationDataSet->addNull();
+                    break;
+                default: {
+                    const char *cData = reinterpret_cast<const char *>(sqlite3_column_text(statement, col));
+                    destinationDataSet->addText(cData, static_cast<unsigned int>(sqlite3_column_bytes(statement, col)));
+                    break;
+                }
+            }
+        }
+    }
+
+    if (result != SQLITE_DONE) {
+        throwError();
+    }
+
+#ifdef DATABASE_DEBUG
+    destinationDataSet->debugOutputContents();
+#endif
+
+    reset();
+
+    if (profiling) {
+        recordExecution(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count(),
+                        destinationDataSet->getRowCount());
+    }
+}
+
+/**
+ * [PreparedStatement::execute Executes a statement with no result data - this should be used for writing data]
+ * @return [The last insert ID on this connection]
+ */
+int PreparedStatement::execute() {
+
+#ifdef DATABASE_DEBUG
+    std::cout<<"Execute SQL statement: "<<query<<std::endl;
+#endif
+
+    if (!statement) {
+        return 0;
+    }
+
+    bool profiling = QueryProfiler::isEnabled();
+    auto startTime = profiling ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    int result;
+
+    while ((result = sqlite3_step(statement)) == SQLITE_ROW) {
+        // Ignore any returned rows, the caller didn't ask for them
+    }
+
+    if (result != SQLITE_DONE) {
+        throwError();
+    }
+
+    reset();
+
+    if (profiling) {
+        recordExecution(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count(), 0);
+    }
+
+    return static_cast<int>(sqlite3_last_insert_rowid(db));
+}
+
+/**
+ * [PreparedStatement::reset Makes the statement ready to be executed again with a fresh set of parameters]
+ */
+void PreparedStatement::reset() {
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+}
+
+/**
+ * [PreparedStatement::recordExecution Passes the timing of an execution of this statement on to the query profiler]
+ * @param milliseconds [Time spent executing the statement]
+ * @param rows         [Number of rows returned]
+ */
+void PreparedStatement::recordExecution(double milliseconds, int rows) {
+    QueryProfiler::getInstance()->record(db, query, milliseconds, rows);
+}
+
+void PreparedStatement::checkBindResult(int result, int index) {
+
+    if (result == SQLITE_OK) {
+        return;
+    }
+
+    std::vector<std::string> errorVector = {
+            "Unable to bind parameter ", std::to_string(index), ":\n",
+            sqlite3_errmsg(db),
+            "\n\n",
+            query
+    };
+
+    throw DatabaseException(Utils::implodeString(errorVector));
+}
+
+void PreparedStatement::throwError() {
+
+    std::string error = sqlite3_errmsg(db);
+
+    if (statement) {
+        reset();
+    }
+
+    std::vector<std::string> errorVector = {
+            "An SQL error has occurred:\n",
+            error,
+            "\n\n",
+            query
+    };
+
+    throw DatabaseException(Utils::implodeString(errorVector));
+}
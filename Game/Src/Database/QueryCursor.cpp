@@ -0,0 +1,329 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+#include <limits>
+#include <cctype>
+#include <charconv>
+#include "Database/QueryCursor.hpp"
+#include "Database/QueryProfiler.hpp"
+#include "Misc/Utils.hpp"
+#include <Exceptions/DatabaseException.hpp>
+#include <Exceptions/DataSetException.hpp>
+
+/**
+ * [QueryCursor::QueryCursor Opens a cursor over a statement which has already had its parameters bound]
+ * @param preparedStatement [The statement to read rows from]
+ */
+QueryCursor::QueryCursor(PreparedStatement *preparedStatement) {
+    statement = preparedStatement;
+    handle = statement->statement;
+    hasRow = false;
+    finished = (handle == nullptr); // An empty query has nothing to step through
+    rowCount = 0;
+    stepMilliseconds = 0;
+    profiling = QueryProfiler::isEnabled();
+
+    // Stop the connection from handing this statement out again while it is being read
+    statement->inUse = true;
+
+#ifdef DATABASE_DEBUG
+    std::cout<<"Open cursor for SQL statement: "<<statement->getQuery()<<std::endl;
+#endif
+
+    if (!handle) {
+        return;
+    }
+
+    int columns = sqlite3_column_count(handle);
+
+    for (int col = 0; col < columns; col++) {
+        const char *cName = sqlite3_column_name(handle, col);
+
+        // When names are repeated, the first column with that name wins
+        columnIndexes.emplace(std::string(cName ? cName : ""), col);
+    }
+}
+
+QueryCursor::~QueryCursor() {
+
+    if (handle) {
+        statement->reset();
+
+        // Only the time spent inside SQLite is counted, not the time the caller spent with each row
+        if (profiling) {
+            statement->recordExecution(stepMilliseconds, rowCount);
+        }
+    }
+
+    statement->inUse = false;
+}
+
+/**
+ * [QueryCursor::next Moves to the next row of the result]
+ * @return [True if there is a row to read, false once the end of the results has been reached]
+ */
+bool QueryCursor::next() {
+
+    if (finished) {
+        return false;
+    }
+
+    auto startTime = profiling ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    int result = sqlite3_step(handle);
+
+    if (profiling) {
+        stepMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    if (result == SQLITE_ROW) {
+        hasRow = true;
+        rowCount++;
+        return true;
+    }
+
+    hasRow = false;
+    finished = true;
+
+    if (result != SQLITE_DONE) {
+        statement->throwError();
+    }
+
+    return false;
+}
+
+/**
+ * [QueryCursor::getColumnIndex Finds the index of a column, this should be called once before looping over the rows]
+ * @param  name [Name of the column]
+ * @return      [Index of the column, -1 if there is no column with that name]
+ */
+int QueryCursor::getColumnIndex(const std::string &name) {
+
+    auto column = columnIndexes.find(name);
+
+    if (column == columnIndexes.end()) {
+        return -1;
+    }
+
+    return column->second;
+}
+
+bool QueryCursor::doesColumnExist(const std::string &name) {
+    return getColumnIndex(name) != -1;
+}
+
+bool QueryCursor::isNull(int column) {
+    checkRow(column);
+    return sqlite3_column_type(handle, column) == SQLITE_NULL;
+}
+
+bool QueryCursor::isNull(const std::string &name) {
+    return isNull(requireColumn(name));
+}
+
+/**
+ * [QueryCursor::getInteger64 Reads a column from the current row as a 64 bit integer, null values are returned as 0]
+ * @param  column [Index of the column]
+ * @return        [The value]
+ */
+long long QueryCursor::getInteger64(int column) {
+    checkRow(column);
+
+    int type = sqlite3_column_type(handle, column);
+
+    if (type == SQLITE_INTEGER || type == SQLITE_NULL) {
+        return sqlite3_column_int64(handle, column);
+    }
+
+    if (type == SQLITE_FLOAT) {
+        return static_cast<long long>(sqlite3_column_double(handle, column));
+    }
+
+    // Values stored as text are parsed in the same way as DataContainer.asInteger64() does
+    std::string_view data = getText(column);
+    const char *begin = data.data();
+    const char *end = begin + data.size();
+
+    // Leading whitespace and trailing characters are allowed, as they were with std::stoi
+    while (begin != end && std::isspace(static_cast<unsigned char>(*begin))) {
+        begin++;
+    }
+
+    if (data.empty()) {
+        return 0;
+    }
+
+    if (begin != end && *begin == '+') {
+        begin++;
+    }
+
+    long long value = 0;
+    auto result = std::from_chars(begin, end, value);
+
+    if (result.ec != std::errc()) {
+        std::vector<std::string> error = {
+                "QueryCursor.getInteger() called on a column which does not contain an integer.\n\n",
+                "Column name: '", sqlite3_column_name(handle, column), "' \n",
+                "Value: '", std::string(data), "'"
+        };
+        throw DataSetException(Utils::implodeString(error));
+    }
+
+    return value;
+}
+
+long long QueryCursor::getInteger64(const std::string &name) {
+    return getInteger64(requireColumn(name));
+}
+
+/**
+ * [QueryCursor::getInteger Reads a column from the current row as an integer, null values are returned as 0. Values
+ * which don't fit in an int are refused rather than truncated, as DataContainer.asInteger() does]
+ * @param  column [Index of the column]
+ * @return        [The value]
+ */
+int QueryCursor::getInteger(int column) {
+
+    long long value = getInteger64(column);
+
+    if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+        std::vector<std::string> error = {
+                "QueryCursor.getInteger() called on a column which is too large for an integer.\n\n",
+                "Column name: '", sqlite3_column_name(handle, column), "' \n",
+                "Value: '", std::to_string(value), "'"
+        };
+        throw DataSetException(Utils::implodeString(error));
+    }
+
+    return static_cast<int>(value);
+}
+
+int QueryCursor::getInteger(const std::string &name) {
+    return getInteger(requireColumn(name));
+}
+
+float QueryCursor::getFloat(int column) {
+    checkRow(column);
+
+    int type = sqlite3_column_type(handle, column);
+
+    if (type == SQLITE_INTEGER || type == SQLITE_FLOAT || type == SQLITE_NULL) {
+        return static_cast<float>(sqlite3_column_double(handle, column));
+    }
+
+    std::string data = getString(column);
+
+    if (data.empty()) {
+        return 0;
+    }
+
+    try {
+        return std::stof(data);
+    } catch (std::exception &e) {
+        std::vector<std::string> error = {
+                "QueryCursor.getFloat() called on a column which does not contain a float value.\n\n",
+                "Column name: '", sqlite3_column_name(handle, column), "' \n",
+                "Value: '", data, "'"
+        };
+        throw DataSetException(Utils::implodeString(error));
+    }
+}
+
+float QueryCursor::getFloat(const std::string &name) {
+    return getFloat(requireColumn(name));
+}
+
+/**
+ * [QueryCursor::getBoolean Reads a column from the current row as a boolean, booleans are stored as 1 or 0]
+ * @param  column [Index of the column]
+ * @return        [The value]
+ */
+bool QueryCursor::getBoolean(int column) {
+    checkRow(column);
+
+    if (sqlite3_column_type(handle, column) == SQLITE_NULL) {
+        return false;
+    }
+
+    std::string_view data = getText(column);
+
+    if (data != "1" && data != "0") {
+        std::vector<std::string> error {
+                "QueryCursor.getBoolean() called on a column which does not contain a boolean. \n\n",
+                "Column name: '", sqlite3_column_name(handle, column), "' \n",
+                "Value: '", std::string(data), "'"
+        };
+        throw DataSetException(Utils::implodeString(error));
+    }
+
+    return data == "1";
+}
+
+bool QueryCursor::getBoolean(const std::string &name) {
+    return getBoolean(requireColumn(name));
+}
+
+/**
+ * [QueryCursor::getText Reads a column from the current row without copying it]
+ * @param  column [Index of the column]
+ * @return        [The value, only valid until the cursor moves on. Null values are returned as an empty string]
+ */
+std::string_view QueryCursor::getText(int column) {
+    checkRow(column);
+
+    const char *data = reinterpret_cast<const char *>(sqlite3_column_text(handle, column));
+
+    if (!data) {
+        return std::string_view();
+    }
+
+    return std::string_view(data, static_cast<size_t>(sqlite3_column_bytes(handle, column)));
+}
+
+std::string_view QueryCursor::getText(const std::string &name) {
+    return getText(requireColumn(name));
+}
+
+std::string QueryCursor::getString(int column) {
+    return std::string(getText(column));
+}
+
+std::string QueryCursor::getString(const std::string &name) {
+    return getString(requireColumn(name));
+}
+
+int QueryCursor::requireColumn(const std::string &name) {
+
+    int index = getColumnIndex(name);
+
+    if (index != -1) {
+        return index;
+    }
+
+    // No column with this name found - throw an error.
+    std::vector<std::string> errorVector = {
+            "No column with name '",
+            name,
+            "' was found"
+    };
+
+    throw DataSetException(Utils::implodeString(errorVector));
+}
+
+void QueryCursor::checkRow(int column) {
+
+    if (!hasRow) {
+        throw DataSetException("QueryCursor was read from without being on a row, next() must return true first");
+    }
+
+    if (column < 0 || column >= sqlite3_column_count(handle)) {
+        std::vector<std::string> errorVector = {
+                "No column with index ",
+                std::to_string(column),
+                " was found"
+        };
+        throw DataSetException(Utils::implodeString(errorVector));
+    }
+}
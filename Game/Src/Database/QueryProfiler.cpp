@@ -0,0 +1,222 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <cctype>
+#include "Database/QueryProfiler.hpp"
+
+std::atomic<bool> QueryProfiler::enabled(false);
+
+QueryProfiler::QueryProfiler() {
+    explainQueries = false;
+    reportWritten = false;
+}
+
+/**
+ * [QueryProfiler::~QueryProfiler The profiler lives until the program exits, so this is where the report is written on shutdown]
+ */
+QueryProfiler::~QueryProfiler() {
+    if (enabled && !reportWritten) {
+        writeReport();
+    }
+}
+
+QueryProfiler *QueryProfiler::getInstance() {
+    static QueryProfiler instance;
+    return &instance;
+}
+
+/**
+ * [QueryProfiler::enable Starts recording queries]
+ * @param captureQueryPlans [Also store the output of EXPLAIN QUERY PLAN the first time each query is seen]
+ */
+void QueryProfiler::enable(bool captureQueryPlans) {
+    explainQueries = captureQueryPlans;
+    enabled = true;
+}
+
+/**
+ * [QueryProfiler::record Adds one execution of a query to the profile]
+ * @param db           [The connection the query was run on, used to capture the query plan]
+ * @param query        [The query as it was run]
+ * @param milliseconds [Time spent running the query]
+ * @param rows         [Number of rows the query returned]
+ */
+void QueryProfiler::record(sqlite3 *db, const std::string &query, double milliseconds, int rows) {
+
+    std::string normalisedQuery = normaliseQuery(query);
+
+    std::lock_guard<std::mutex> lock(profileMutex);
+
+    QueryProfile &profile = profiles[normalisedQuery];
+
+    if (profile.count == 0) {
+        profile.query = normalisedQuery;
+
+        if (explainQueries) {
+            profile.queryPlan = getQueryPlan(db, query);
+        }
+    }
+
+    profile.count++;
+    profile.totalMilliseconds += milliseconds;
+    profile.maxMilliseconds = std::max(profile.maxMilliseconds, milliseconds);
+    profile.rows += rows;
+}
+
+/**
+ * [QueryProfiler::writeReport Writes the report to query_profile.log]
+ */
+void QueryProfiler::writeReport() {
+    std::ofstream file(QUERY_PROFILER_REPORT_FILE, std::ios::trunc);
+    writeReport(file);
+    file.close();
+
+    reportWritten = true;
+    std::cout << "Query profile written to " << QUERY_PROFILER_REPORT_FILE << std::endl;
+}
+
+/**
+ * [QueryProfiler::writeReport Writes every query that has been recorded, slowest in total first]
+ * @param output [Stream to write the report to]
+ */
+void QueryProfiler::writeReport(std::ostream &output) {
+
+    std::vector<QueryProfile> sortedProfiles;
+    {
+        std::lock_guard<std::mutex> lock(profileMutex);
+
+        for (auto &profile : profiles) {
+            sortedProfiles.push_back(profile.second);
+        }
+    }
+
+    std::sort(sortedProfiles.begin(), sortedProfiles.end(), [](const QueryProfile &a, const QueryProfile &b) {
+        return a.totalMilliseconds > b.totalMilliseconds;
+    });
+
+    int totalCount = 0;
+    double totalMilliseconds = 0;
+
+    for (auto &profile : sortedProfiles) {
+        totalCount += profile.count;
+        totalMilliseconds += profile.totalMilliseconds;
+    }
+
+    output << std::fixed << std::setprecision(3);
+    output << "Query profile - " << totalCount << " queries, " << sortedProfiles.size() << " distinct, "
+           << totalMilliseconds << "ms in total" << std::endl << std::endl;
+
+    for (auto &profile : sortedProfiles) {
+        output << profile.query << std::endl
+               << "    Count: " << profile.count
+               << " | Total: " << profile.totalMilliseconds << "ms"
+               << " | Max: " << profile.maxMilliseconds << "ms"
+               << " | Rows: " << profile.rows << std::endl;
+
+        if (profile.count >= QUERY_PROFILER_N_PLUS_ONE_THRESHOLD) {
+            output << "    Possible N+1: this query was run " << profile.count
+                   << " times, consider loading these rows with a single query" << std::endl;
+        }
+
+        if (!profile.queryPlan.empty()) {
+            output << "    Query plan:" << std::endl << profile.queryPlan;
+        }
+
+        output << std::endl;
+    }
+}
+
+/**
+ * [QueryProfiler::normaliseQuery Replaces literal values in a query with ? and collapses whitespace, so that queries
+ * with the same shape are grouped together]
+ * @param  query [The query]
+ * @return       [The normalised query]
+ */
+std::string QueryProfiler::normaliseQuery(const std::string &query) {
+
+    std::string normalised;
+    normalised.reserve(query.length());
+
+    for (unsigned int i = 0; i < query.length(); i++) {
+        char current = query[i];
+
+        // String literals
+        if (current == '\'') {
+            i++;
+
+            while (i < query.length()) {
+                if (query[i] == '\'') {
+                    // Two apostrophes is an escaped apostrophe rather than the end of the string
+                    if (i + 1 < query.length() && query[i + 1] == '\'') {
+                        i += 2;
+                        continue;
+                    }
+                    break;
+                }
+                i++;
+            }
+
+            normalised += '?';
+            continue;
+        }
+
+        // Numeric literals, as long as they aren't part of a name such as argument0
+        bool partOfName = !normalised.empty() && (std::isalnum(static_cast<unsigned char>(normalised.back()))
+                                                  || normalised.back() == '_');
+
+        if (std::isdigit(static_cast<unsigned char>(current)) && !partOfName) {
+            while (i + 1 < query.length() && (std::isdigit(static_cast<unsigned char>(query[i + 1])) || query[i + 1] == '.')) {
+                i++;
+            }
+
+            normalised += '?';
+            continue;
+        }
+
+        if (std::isspace(static_cast<unsigned char>(current))) {
+            if (!normalised.empty() && normalised.back() != ' ') {
+                normalised += ' ';
+            }
+            continue;
+        }
+
+        normalised += current;
+    }
+
+    while (!normalised.empty() && normalised.back() == ' ') {
+        normalised.pop_back();
+    }
+
+    return normalised;
+}
+
+/**
+ * [QueryProfiler::getQueryPlan Runs EXPLAIN QUERY PLAN on a query, any parameters are left unbound]
+ * @param  db    [The connection to run it on]
+ * @param  query [The query]
+ * @return       [Each step of the plan, one per line]
+ */
+std::string QueryProfiler::getQueryPlan(sqlite3 *db, const std::string &query) {
+
+    std::string explainQuery = "EXPLAIN QUERY PLAN " + query;
+    sqlite3_stmt *statement = nullptr;
+
+    if (sqlite3_prepare_v2(db, explainQuery.c_str(), -1, &statement, nullptr) != SQLITE_OK || !statement) {
+        sqlite3_finalize(statement);
+        return "";
+    }
+
+    std::string plan;
+
+    // The last column of each row contains the description of that step
+    int detailColumn = sqlite3_column_count(statement) - 1;
+
+    while (sqlite3_step(statement) == SQLITE_ROW) {
+        const char *detail = reinterpret_cast<const char *>(sqlite3_column_text(statement, detailColumn));
+        plan.append("        ").append(detail ? detail : "").append("\n");
+    }
+
+    sqlite3_finalize(statement);
+    return plan;
+}
@@ -18,7 +18,15 @@ using json = nlohmann::json;
 #include <fstream>
 #include "Database/TypeCaster.hpp"
 
-ChapterBuilder::ChapterBuilder(const std::string &fileName, DatabaseConnection *novelDb, JsonHandler *fileHandler) {
+/**
+ * @param fileName      Path of the chapter file
+ * @param novelDb       The novel database being written
+ * @param fileHandler   Used to read the chapter file
+ * @param stateGroupIds The character state groups written so far, shared by every chapter so that groups are only written once
+ * @param requirements  Compiles the requirements and flag changes of the chapter
+ */
+ChapterBuilder::ChapterBuilder(const std::string &fileName, DatabaseConnection *novelDb, JsonHandler *fileHandler,
+                               std::unordered_map<std::string, int> *stateGroupIds, RequirementCompiler *requirements) {
 
     if (!Utils::fileExists(fileName)) {
 
@@ -33,6 +41,8 @@ ChapterBuilder::ChapterBuilder(const std::string &fileName, DatabaseConnection *
     fHandler = fileHandler;
     chapterFileName = fileName;
     novel = novelDb;
+    characterStateGroupIds = stateGroupIds;
+    requirementCompiler = requirements;
 
 }
 
@@ -48,6 +58,8 @@ void ChapterBuilder::process() {
     std::string hidden;
     std::string requirementId;
     std::string description;
+    std::string label = "NULL";
+    std::string nextLabel = "NULL";
 
     // Validate that we have everything we need. Substitute or throw errors where needed.
     if (chapterJson.find("title") == chapterJson.end()) {
@@ -64,10 +76,19 @@ void ChapterBuilder::process() {
         accessibleName = JsonHandler::getString(chapterJson,"accessibleName");
     }
 
-    if (chapterJson.find("requirementId") == chapterJson.end()) {
+    // The id 'requirementId' held never referred to anything, a requirement is now written out in full
+    if (chapterJson.find("requirementId") != chapterJson.end()) {
+        std::vector<std::string> error = {
+                "The chapter '", title, "' has a 'requirementId', which is no longer supported. ",
+                "Use the 'requirement' attribute to give the flags and counters the chapter requires"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    if (chapterJson.find("requirement") == chapterJson.end()) {
         requirementId = "0";
     } else {
-        requirementId = TypeCaster::cast(JsonHandler::getInteger(chapterJson, "requirementId"));
+        requirementId = std::to_string(requirementCompiler->compile(chapterJson["requirement"], "the chapter '" + title + "'"));
     }
 
     if (chapterJson.find("hidden") == chapterJson.end()) {
@@ -82,10 +103,20 @@ void ChapterBuilder::process() {
         description = JsonHandler::getString(chapterJson,"description");
     }
 
-    std::vector<std::string> columns = {"title", "accessible_name", "description", "hidden", "requirement_id"};
-    std::vector<std::string> values = {title, accessibleName, description, hidden, requirementId};
+    // Jumps are resolved by SceneGraphBuilder once every chapter has been written, as they can lead to a later chapter
+    if (chapterJson.find("label") != chapterJson.end()) {
+        label = JsonHandler::getString(chapterJson, "label");
+    }
+
+    if (chapterJson.find("next") != chapterJson.end()) {
+        nextLabel = JsonHandler::getString(chapterJson, "next");
+    }
+
+    std::vector<std::string> columns = {"title", "accessible_name", "description", "hidden", "requirement_id", "label",
+                                        "next_label"};
+    std::vector<std::string> values = {title, accessibleName, description, hidden, requirementId, label, nextLabel};
     std::vector<int> types = {DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_BOOLEAN,
-                              DATA_TYPE_NUMBER};
+                              DATA_TYPE_NUMBER, DATA_TYPE_STRING, DATA_TYPE_STRING};
     int chapterId = novel->insert("chapters", columns, values, types);
 
     // Process each scene
@@ -117,6 +148,8 @@ void ChapterBuilder::processScene(json sceneJson, int chapterId) {
     std::string endTransitionColourId;
     std::string startTransitionTypeId;
     std::string endTransitionTypeId;
+    std::string label = "NULL";
+    std::string nextLabel = "NULL";
 
     // Could use ternaries for this, but this is easier to follow I suppose.
     if (sceneJson.find("backgroundImageName") != sceneJson.end()) {
@@ -177,6 +210,14 @@ void ChapterBuilder::processScene(json sceneJson, int chapterId) {
         endTransitionTypeId = "NULL";
     }
 
+    if (sceneJson.find("label") != sceneJson.end()) {
+        label = JsonHandler::getString(sceneJson, "label");
+    }
+
+    if (sceneJson.find("next") != sceneJson.end()) {
+        nextLabel = JsonHandler::getString(sceneJson, "next");
+    }
+
     // Insert the data into the database...
     std::vector<std::string> columns = {
             "chapter_id",
@@ -185,7 +226,9 @@ void ChapterBuilder::processScene(json sceneJson, int chapterId) {
             "start_transition_colour_id",
             "end_transition_colour_id",
             "start_transition_type_id",
-            "end_transition_type_id"
+            "end_transition_type_id",
+            "label",
+            "next_label"
     };
 
     std::vector<std::string> values = {
@@ -195,7 +238,9 @@ void ChapterBuilder::processScene(json sceneJson, int chapterId) {
             startTransitionColourId,
             endTransitionColourId,
             startTransitionTypeId,
-            endTransitionTypeId
+            endTransitionTypeId,
+            label,
+            nextLabel
     };
 
     std::vector<int> types = {
@@ -205,7 +250,9 @@ void ChapterBuilder::processScene(json sceneJson, int chapterId) {
             DATA_TYPE_NUMBER,
             DATA_TYPE_NUMBER,
             DATA_TYPE_NUMBER,
-            DATA_TYPE_NUMBER
+            DATA_TYPE_NUMBER,
+            DATA_TYPE_STRING,
+            DATA_TYPE_STRING
     };
 
     int sceneId = novel->insert("scenes", columns, values, types);
@@ -246,6 +293,8 @@ void ChapterBuilder::processSceneSegment(json sceneSegmentJson, int sceneId) {
 
     std::string musicPlaybackRequestId = "NULL";
     std::string visualEffectName;
+    std::string label = "NULL";
+    std::string nextLabel = "NULL";
 
     if (sceneSegmentJson.find("music") != sceneSegmentJson.end()) {
 
@@ -349,12 +398,60 @@ void ChapterBuilder::processSceneSegment(json sceneSegmentJson, int sceneId) {
         visualEffectName = "NULL";
     }
 
-    std::vector<std::string> columns = {"scene_id", "music_playback_request_id", "visual_effect_name"};
-    std::vector<std::string> values = {std::to_string(sceneId), musicPlaybackRequestId, visualEffectName};
-    std::vector<int> types = {DATA_TYPE_NUMBER, DATA_TYPE_STRING, DATA_TYPE_STRING};
+    if (sceneSegmentJson.find("label") != sceneSegmentJson.end()) {
+        label = JsonHandler::getString(sceneSegmentJson, "label");
+    }
+
+    if (sceneSegmentJson.find("next") != sceneSegmentJson.end()) {
+        nextLabel = JsonHandler::getString(sceneSegmentJson, "next");
+    }
+
+    std::vector<std::string> columns = {"scene_id", "music_playback_request_id", "visual_effect_name", "label",
+                                        "next_label"};
+    std::vector<std::string> values = {std::to_string(sceneId), musicPlaybackRequestId, visualEffectName, label,
+                                       nextLabel};
+    std::vector<int> types = {DATA_TYPE_NUMBER, DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_STRING};
 
     int sceneSegmentId = novel->insert("scene_segments", columns, values, types);
 
+    std::string owner = "scene segment " + std::to_string(sceneSegmentId);
+    requirementCompiler->compileFlagChanges(sceneSegmentId, sceneSegmentJson, owner);
+
+    // The script is checked against the compiled scripts once every chapter has been written
+    if (sceneSegmentJson.find("script") != sceneSegmentJson.end()) {
+        std::vector<std::string> scriptColumns = {"scene_segment_id", "script_name"};
+        std::vector<std::string> scriptValues = {std::to_string(sceneSegmentId),
+                                                 JsonHandler::getString(sceneSegmentJson, "script")};
+        std::vector<int> scriptTypes = {DATA_TYPE_NUMBER, DATA_TYPE_STRING};
+        novel->insert("scene_segment_scripts", scriptColumns, scriptValues, scriptTypes);
+    }
+
+    // Where each branch leads is resolved by SceneGraphBuilder along with the jumps
+    if (sceneSegmentJson.find("branches") != sceneSegmentJson.end()) {
+        std::vector<std::vector<std::string>> branchRows;
+
+        for (auto &element : sceneSegmentJson["branches"].items()) {
+            json branch = element.value();
+
+            if (branch.find("requirement") == branch.end() || branch.find("next") == branch.end()) {
+                std::vector<std::string> error = {
+                        "Every branch of ", owner, " must have a 'requirement' and a 'next' attribute"
+                };
+                throw ProjectBuilderException(Utils::implodeString(error));
+            }
+
+            int requirementId = requirementCompiler->compile(branch["requirement"], "a branch of " + owner);
+            branchRows.push_back({std::to_string(sceneSegmentId), std::to_string(requirementId),
+                                  JsonHandler::getString(branch, "next")});
+        }
+
+        if (!branchRows.empty()) {
+            std::vector<std::string> branchColumns = {"scene_segment_id", "requirement_id", "next_label"};
+            std::vector<int> branchTypes = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_STRING};
+            novel->insert("scene_segment_branches", branchColumns, branchRows, branchTypes);
+        }
+    }
+
     // Process each line
     json lines;
 
@@ -371,9 +468,12 @@ void ChapterBuilder::processSceneSegment(json sceneSegmentJson, int sceneId) {
 
     int numberOfLines = 0;
 
+    // Lines are written together once the whole segment has been read
+    std::vector<std::vector<std::string>> lineRows;
+
     for (auto &line : lines.items()) {
         numberOfLines++;
-        processLine(line.value(), sceneSegmentId);
+        processLine(line.value(), sceneSegmentId, lineRows);
     }
 
     if (numberOfLines == 0) {
@@ -384,16 +484,25 @@ void ChapterBuilder::processSceneSegment(json sceneSegmentJson, int sceneId) {
         };
         throw ProjectBuilderException(Utils::implodeString(errorVector));
     }
+
+    std::vector<std::string> lineColumns = {"scene_segment_id", "language_id", "character_id",
+                                            "override_character_name", "text", "character_state_group_id",
+                                            "string_key", "spoken"};
+    std::vector<int> lineTypes = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_STRING,
+                                  DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_BOOLEAN};
+    novel->insert("segment_lines", lineColumns, lineRows, lineTypes);
 }
 
-void ChapterBuilder::processLine(json lineJson, int sceneSegmentId) {
+void ChapterBuilder::processLine(json lineJson, int sceneSegmentId, std::vector<std::vector<std::string>> &lineRows) {
 
-    // TODO: Support multiple languages in one distribution, on second thought it might be better to do this at a chapter level.
+    // Translations are kept in string packs rather than in this table, see GameCompiler::createNovelDatabase
     std::string languageId = "1";
     std::string overrideCharacterName = "NULL";
     std::string characterId = "NULL";
     std::string text = "NULL";
     std::string characterStateGroupId = "NULL";
+    std::string stringKey;
+    std::string spoken = "FALSE";
 
     if (lineJson.find("characterName") != lineJson.end()) {
         // TODO: Validate that the character exists in the database
@@ -422,8 +531,20 @@ void ChapterBuilder::processLine(json lineJson, int sceneSegmentId) {
 
     }
 
+    // Taken before the text is quoted, so that translations don't need to quote themselves
+    if (lineJson.find("lineId") != lineJson.end()) {
+        stringKey = JsonHandler::getString(lineJson, "lineId");
+
+        if (stringKey.empty()) {
+            throw ProjectBuilderException("A line's 'lineId' must not be empty");
+        }
+    } else {
+        stringKey = makeStringKey(text);
+    }
+
     if (lineJson.find("spoken") != lineJson.end()) {
         if (JsonHandler::getBoolean(lineJson, "spoken")) {
+            spoken = "TRUE";
             text = Utils::implodeString(std::vector<std::string> {
                "\"",text,"\""
             });
@@ -432,11 +553,9 @@ void ChapterBuilder::processLine(json lineJson, int sceneSegmentId) {
 
     // See if any character state changes are on this line, add them to the database if they are
     if (lineJson.find("characterStates") != lineJson.end()) {
-        // Create a character state group
-        // TODO: If one which looks the same already exists, use it rather than creating a new one.
-        characterStateGroupId = std::to_string(novel->insert("character_state_groups"));
 
         json characterStates = lineJson["characterStates"];
+        std::vector<std::string> characterSpriteIds;
 
         for (auto &element : characterStates.items()) {
             json characterState = element.value();
@@ -455,13 +574,9 @@ void ChapterBuilder::processLine(json lineJson, int sceneSegmentId) {
 
                     auto *dataSet = new DataSet();
 
-                    std::vector<std::string> query = {
-                            "SELECT * FROM characters WHERE first_name = '",
-                            characterFirstName,
-                            "';"
-                    };
-
-                    novel->executeQuery(Utils::implodeString(query, ""), dataSet);
+                    novel->prepare("SELECT * FROM characters WHERE first_name = ?;")
+                            ->bind(1, characterFirstName)
+                            ->execute(dataSet);
 
                     if (dataSet->getRowCount() == 0) {
                         std::vector<std::string> error = {
@@ -505,15 +620,10 @@ void ChapterBuilder::processLine(json lineJson, int sceneSegmentId) {
 
             auto *dataSet = new DataSet();
 
-            std::vector<std::string> query = {
-                    "SELECT * FROM character_sprites WHERE character_id = ",
-                    characterId,
-                    " AND name = '",
-                    spriteName,
-                    "';"
-            };
-
-            novel->executeQuery(Utils::implodeString(query, ""), dataSet);
+            novel->prepare("SELECT * FROM character_sprites WHERE character_id = ? AND name = ?;")
+                    ->bind(1, std::stoi(characterId))
+                    ->bind(2, spriteName)
+                    ->execute(dataSet);
 
             if (dataSet->getRowCount() == 0) {
                 std::vector<std::string> error = {
@@ -529,19 +639,61 @@ void ChapterBuilder::processLine(json lineJson, int sceneSegmentId) {
 
             characterSpriteId = dataSet->getRow(0)->getColumn("id")->getRawData();
 
+            characterSpriteIds.push_back(characterSpriteId);
+        }
+
+        // Lines which show the same sprites in the same order share a group, rather than each line creating its own
+        std::string stateGroupKey = Utils::implodeString(characterSpriteIds, ",", 0);
+        auto existingGroup = characterStateGroupIds->find(stateGroupKey);
+
+        if (existingGroup != characterStateGroupIds->end()) {
+            characterStateGroupId = std::to_string(existingGroup->second);
+        } else {
+            int newGroupId = novel->insert("character_state_groups");
+            characterStateGroupId = std::to_string(newGroupId);
+            (*characterStateGroupIds)[stateGroupKey] = newGroupId;
+
+            std::vector<std::vector<std::string>> characterStateRows;
+
+            for (auto &spriteId : characterSpriteIds) {
+                characterStateRows.push_back({spriteId, characterStateGroupId});
+            }
+
             std::vector<std::string> columns = {"character_sprite_id", "character_state_group_id"};
-            std::vector<std::string> values = {characterSpriteId, characterStateGroupId};
             std::vector<int> types = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER};
-            novel->insert("character_states", columns, values, types);
+            novel->insert("character_states", columns, characterStateRows, types);
         }
     }
 
-    std::vector<std::string> columns = {"scene_segment_id", "language_id", "character_id", "override_character_name",
-                                        "text", "character_state_group_id"};
-    std::vector<std::string> values = {std::to_string(sceneSegmentId), languageId, characterId, overrideCharacterName,
-                                       text, characterStateGroupId};
-    std::vector<int> types = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_STRING, DATA_TYPE_STRING,
-                              DATA_TYPE_STRING};
-    novel->insert("segment_lines", columns, values, types);
+    // The line itself is inserted by processSceneSegment along with the rest of the segment
+    lineRows.push_back({std::to_string(sceneSegmentId), languageId, characterId, overrideCharacterName, text,
+                        characterStateGroupId, stringKey, spoken});
+
+}
+
+/**
+ * [ChapterBuilder::makeStringKey Makes the key a line is translated by when it isn't given a lineId. The key only
+ * depends on the line's text, so it stays the same when lines are added or moved around it, and lines with the same
+ * text share a translation]
+ * @param  text [The line's text, as written in the chapter]
+ * @return      [The key, a 64 bit FNV-1a hash of the text in hexadecimal]
+ */
+std::string ChapterBuilder::makeStringKey(const std::string &text) {
+
+    uint64_t hash = 14695981039346656037ull;
+
+    for (unsigned char character : text) {
+        hash ^= character;
+        hash *= 1099511628211ull;
+    }
+
+    static const char digits[] = "0123456789abcdef";
+    std::string key(16, '0');
+
+    for (int i = 15; i >= 0; i--) {
+        key[i] = digits[hash & 0xF];
+        hash >>= 4;
+    }
 
+    return key;
 }
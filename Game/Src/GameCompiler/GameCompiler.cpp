@@ -2,9 +2,12 @@
 #include "Misc/Utils.hpp"
 #include "Database/DatabaseSchema.hpp"
 #include "Database/DatabaseConnection.hpp"
+#include "Database/DatabaseTransaction.hpp"
 #include "Exceptions/ProjectBuilderException.hpp"
 #include "Misc/JsonHandler.hpp"
 #include "GameCompiler/ProjectBuilder.hpp"
+#include "GameCompiler/NovelImageBuilder.hpp"
+#include "GameCompiler/StringPackBuilder.hpp"
 #include "GameCompiler/GameCompiler.hpp"
 
 GameCompiler::GameCompiler(GameCompilerOptions *gameCompilerOptions, JsonHandler *fileHandler) {
@@ -45,9 +48,36 @@ bool GameCompiler::process() {
     throw ProjectBuilderException("GameCompiler: Unable to continue - could not open Resource database.");
   }
 
+  // The databases are rebuilt from scratch on every compile, so there is nothing to lose by not syncing each write
+  // to disk. A failed compile has to be run again anyway.
+  for (DatabaseConnection *database : {novel, resource}) {
+    database->setPragma("journal_mode", "MEMORY");
+    database->setPragma("synchronous", "OFF");
+  }
+
+  // Everything is written in one transaction per database, rather than one per row
+  DatabaseTransaction novelTransaction(novel);
+  DatabaseTransaction resourceTransaction(resource);
+
   // Create an instance of ProjectBuilder to read the main project.json file
   ProjectBuilder *projectBuilder = new ProjectBuilder(compilerOptions->getProjectFilePath(), novel, resource, fHandler);
   projectBuilder->process();
+
+  resourceTransaction.commit();
+  novelTransaction.commit();
+
+  // Gather statistics on the indexes so that the runner's queries use them
+  novel->executeQuery("ANALYZE;");
+  resource->executeQuery("ANALYZE;");
+
+  // The runner can read the story from this instead of the novel database
+  NovelImageBuilder novelImageBuilder(novel);
+  novelImageBuilder.write(NOVEL_IMAGE_PATH);
+
+  // The runner reads the text of the locale being played from these
+  StringPackBuilder stringPackBuilder(novel, fHandler, projectBuilder->getProjectDirectory());
+  stringPackBuilder.write(STRING_PACK_DIRECTORY);
+
   return false;
 }
 
@@ -89,12 +119,13 @@ void GameCompiler::createResourceDatabase() {
 
     DatabaseTable *backgroundImageAttributesTable = resourceDb->addTable("background_image_attributes");
     backgroundImageAttributesTable->addPrimaryKey();
-    backgroundImageAttributesTable->addColumn("background_image_id", ColumnType::tInteger, false, "");
+    backgroundImageAttributesTable->addForeignKey("background_image_id", "background_images", "id", false);
     backgroundImageAttributesTable->addColumn("enabled", ColumnType::tBoolean, false, "");
     backgroundImageAttributesTable->addColumn("max_height", ColumnType::tInteger, false, "");
     backgroundImageAttributesTable->addColumn("max_width", ColumnType::tInteger, false, "");
     backgroundImageAttributesTable->addColumn("offset_left", ColumnType::tInteger, false, "");
     backgroundImageAttributesTable->addColumn("offset_top", ColumnType::tInteger, false, "");
+    backgroundImageAttributesTable->addIndex({"background_image_id"});
 
     // Create textures table
     DatabaseTable *texturesTable = resourceDb->addTable("textures");
@@ -103,12 +134,37 @@ void GameCompiler::createResourceDatabase() {
     texturesTable->addColumn("filename", ColumnType::tText, false, "");
     texturesTable->addColumn("enabled", ColumnType::tBoolean, false, "");
 
-    // TODO: Pull in the Lua library to allow the script system to work
+    /*
+      Scripts are compiled to bytecode for the runner's script machine (see ScriptBytecodeFormat.hpp).
+      Each script's instructions, the constants too large to fit in an instruction and the
+      resources it names are kept in order of their id.
+     */
     DatabaseTable *scriptsTable = resourceDb->addTable("scripts");
     scriptsTable->addPrimaryKey();
     scriptsTable->addColumn("name", ColumnType::tText, false, "");
     scriptsTable->addColumn("filename", ColumnType::tText, false, "");
     scriptsTable->addColumn("enabled", ColumnType::tBoolean, false, "");
+    scriptsTable->addColumn("register_count", ColumnType::tInteger, false, "0");
+
+    DatabaseTable *scriptInstructionsTable = resourceDb->addTable("script_instructions");
+    scriptInstructionsTable->addPrimaryKey();
+    scriptInstructionsTable->addForeignKey("script_id", "scripts", "id", true);
+    scriptInstructionsTable->addColumn("instruction", ColumnType::tInteger, true, "");
+    scriptInstructionsTable->addIndex({"script_id"});
+
+    DatabaseTable *scriptConstantsTable = resourceDb->addTable("script_constants");
+    scriptConstantsTable->addPrimaryKey();
+    scriptConstantsTable->addForeignKey("script_id", "scripts", "id", true);
+    scriptConstantsTable->addColumn("value", ColumnType::tInteger, true, "");
+    scriptConstantsTable->addIndex({"script_id"});
+
+    DatabaseTable *scriptOperandsTable = resourceDb->addTable("script_operands");
+    scriptOperandsTable->addPrimaryKey();
+    scriptOperandsTable->addForeignKey("script_id", "scripts", "id", true);
+    scriptOperandsTable->addColumn("kind", ColumnType::tInteger, true, "");
+    scriptOperandsTable->addColumn("value", ColumnType::tInteger, true, "");
+    scriptOperandsTable->addColumn("name", ColumnType::tText, true, "");
+    scriptOperandsTable->addIndex({"script_id"});
 
     // Create the Database
     resourceDb->createDatabase();
@@ -143,6 +199,9 @@ void GameCompiler::createNovelDatabase() {
     used is the TIPs from Higurashi.
 
     Hidden chapters could also be used for end-game extra content or special features.
+
+    A chapter with a requirement_id other than 0 is only available once its requirement
+    is met (see the requirements table).
    */
   DatabaseTable *chaptersTable = novelDb->addTable("chapters");
   chaptersTable->addPrimaryKey();
@@ -151,6 +210,8 @@ void GameCompiler::createNovelDatabase() {
   chaptersTable->addColumn("description", ColumnType::tText, false, "");
   chaptersTable->addColumn("hidden", ColumnType::tBoolean, false, "");
   chaptersTable->addColumn("requirement_id", ColumnType::tInteger, false, "");
+  chaptersTable->addColumn("label", ColumnType::tText, false, "");
+  chaptersTable->addColumn("next_label", ColumnType::tText, false, "");
 
   /*
     The scenes table is a way to group scene_segments together.
@@ -160,13 +221,16 @@ void GameCompiler::createNovelDatabase() {
    */
   DatabaseTable *scenesTable = novelDb->addTable("scenes");
   scenesTable->addPrimaryKey();
-  scenesTable->addColumn("chapter_id", ColumnType::tInteger, false, "");
+  scenesTable->addForeignKey("chapter_id", "chapters", "id", false);
   scenesTable->addColumn("background_image_name", ColumnType::tText, false, "");
   scenesTable->addColumn("background_colour_id", ColumnType::tInteger, false, "");
   scenesTable->addColumn("start_transition_colour_id", ColumnType::tInteger, false, "");
   scenesTable->addColumn("end_transition_colour_id", ColumnType::tInteger, false, "");
   scenesTable->addColumn("start_transition_type_id", ColumnType::tInteger, false, "");
   scenesTable->addColumn("end_transition_type_id", ColumnType::tInteger, false, "");
+  scenesTable->addColumn("label", ColumnType::tText, false, "");
+  scenesTable->addColumn("next_label", ColumnType::tText, false, "");
+  scenesTable->addIndex({"chapter_id"});
 
   /*
     The scene_segments table links a scene to actual text content represented
@@ -180,26 +244,118 @@ void GameCompiler::createNovelDatabase() {
    */
   DatabaseTable *sceneSegmentsTable = novelDb->addTable("scene_segments");
   sceneSegmentsTable->addPrimaryKey();
-  sceneSegmentsTable->addColumn("scene_id", ColumnType::tInteger, false, "");
-  sceneSegmentsTable->addColumn("music_playback_request_id", ColumnType::tInteger, false, "");
+  sceneSegmentsTable->addForeignKey("scene_id", "scenes", "id", false);
+  sceneSegmentsTable->addForeignKey("music_playback_request_id", "music_playback_requests", "id", false);
   sceneSegmentsTable->addColumn("visual_effect_name", ColumnType::tText, false, "");
+  sceneSegmentsTable->addColumn("label", ColumnType::tText, false, "");
+  sceneSegmentsTable->addColumn("next_label", ColumnType::tText, false, "");
+  sceneSegmentsTable->addIndex({"scene_id"});
+
+  /*
+    The scene_segment_jumps table holds where the story goes once each scene segment
+    has finished, resolved by the compiler from the label and next_label columns of
+    the chapters, scenes and segments. The target is the position of a segment: the
+    index of its chapter, of its scene within that chapter and of the segment within
+    that scene. A chapter_index of -1 is the end of the story.
+   */
+  DatabaseTable *sceneSegmentJumpsTable = novelDb->addTable("scene_segment_jumps");
+  sceneSegmentJumpsTable->addPrimaryKey();
+  sceneSegmentJumpsTable->addForeignKey("scene_segment_id", "scene_segments", "id", true);
+  sceneSegmentJumpsTable->addColumn("chapter_index", ColumnType::tInteger, true, "");
+  sceneSegmentJumpsTable->addColumn("scene_index", ColumnType::tInteger, true, "");
+  sceneSegmentJumpsTable->addColumn("scene_segment_index", ColumnType::tInteger, true, "");
+
+  /*
+    A scene segment can have branches, which are taken instead of its jump when their
+    requirement is met. The first branch of a segment whose requirement is met is the
+    one taken. The position they lead to is resolved in the same way as the jumps.
+   */
+  DatabaseTable *sceneSegmentBranchesTable = novelDb->addTable("scene_segment_branches");
+  sceneSegmentBranchesTable->addPrimaryKey();
+  sceneSegmentBranchesTable->addForeignKey("scene_segment_id", "scene_segments", "id", true);
+  sceneSegmentBranchesTable->addForeignKey("requirement_id", "requirements", "id", true);
+  sceneSegmentBranchesTable->addColumn("next_label", ColumnType::tText, true, "");
+  sceneSegmentBranchesTable->addColumn("chapter_index", ColumnType::tInteger, false, "");
+  sceneSegmentBranchesTable->addColumn("scene_index", ColumnType::tInteger, false, "");
+  sceneSegmentBranchesTable->addColumn("scene_segment_index", ColumnType::tInteger, false, "");
+  sceneSegmentBranchesTable->addIndex({"scene_segment_id"});
+
+  /*
+    The story flags and counters declared in project.json. Flags and counters are each
+    numbered from 0 by flag_index, which is how everything else refers to them.
+   */
+  DatabaseTable *flagsTable = novelDb->addTable("flags");
+  flagsTable->addPrimaryKey();
+  flagsTable->addColumn("name", ColumnType::tText, true, "");
+  flagsTable->addColumn("counter", ColumnType::tBoolean, true, "");
+  flagsTable->addColumn("flag_index", ColumnType::tInteger, true, "");
+  flagsTable->addColumn("default_value", ColumnType::tInteger, true, "");
+
+  /*
+    A requirement is a condition on the flags and counters, compiled into a list of terms
+    in postfix order which the runner evaluates without looking anything up by name
+    (see NovelRequirementFormat.hpp).
+   */
+  DatabaseTable *requirementsTable = novelDb->addTable("requirements");
+  requirementsTable->addPrimaryKey();
+  requirementsTable->addColumn("term_count", ColumnType::tInteger, true, "");
+
+  DatabaseTable *requirementTermsTable = novelDb->addTable("requirement_terms");
+  requirementTermsTable->addPrimaryKey();
+  requirementTermsTable->addForeignKey("requirement_id", "requirements", "id", true);
+  requirementTermsTable->addColumn("opcode", ColumnType::tInteger, true, "");
+  requirementTermsTable->addColumn("operand", ColumnType::tInteger, true, "");
+  requirementTermsTable->addColumn("value", ColumnType::tInteger, true, "");
+  requirementTermsTable->addIndex({"requirement_id"});
+
+  // The flags and counters changed when a scene segment starts, in the order they are changed
+  DatabaseTable *sceneSegmentFlagChangesTable = novelDb->addTable("scene_segment_flag_changes");
+  sceneSegmentFlagChangesTable->addPrimaryKey();
+  sceneSegmentFlagChangesTable->addForeignKey("scene_segment_id", "scene_segments", "id", true);
+  sceneSegmentFlagChangesTable->addColumn("operation", ColumnType::tInteger, true, "");
+  sceneSegmentFlagChangesTable->addColumn("operand", ColumnType::tInteger, true, "");
+  sceneSegmentFlagChangesTable->addColumn("value", ColumnType::tInteger, true, "");
+  sceneSegmentFlagChangesTable->addIndex({"scene_segment_id"});
+
+  // The script a scene segment starts, by the name it has in the resource database's scripts table
+  DatabaseTable *sceneSegmentScriptsTable = novelDb->addTable("scene_segment_scripts");
+  sceneSegmentScriptsTable->addPrimaryKey();
+  sceneSegmentScriptsTable->addForeignKey("scene_segment_id", "scene_segments", "id", true);
+  sceneSegmentScriptsTable->addColumn("script_name", ColumnType::tText, true, "");
+  sceneSegmentScriptsTable->addIndex({"scene_segment_id"});
 
   /*
     The segment_lines table contains the actual novel's text.
     Each entry in this represents a piece of text which will be drawn to the screen
     These will be displayed sequentially until we hit the end of a scene segment.
 
-    TODO: Add support for multiple languages using the language_id column to allow for
-    one visual novel distribution to support many languages.
+    The text is in the locale the chapters are written in. Each line has a string_key,
+    which stays the same while its text does (or is given in the chapter as 'lineId'),
+    and is what translations refer to it by. The runner reads the text of the locale
+    being played from that locale's string pack (see StringPackFormat.hpp) when the
+    novel has locales. A spoken line's text is stored within quotation marks, which
+    are added to its translations as well.
    */
   DatabaseTable *segmentLinesTable = novelDb->addTable("segment_lines");
   segmentLinesTable->addPrimaryKey();
-  segmentLinesTable->addColumn("scene_segment_id", ColumnType::tInteger, true, "");
+  segmentLinesTable->addForeignKey("scene_segment_id", "scene_segments", "id", true);
   segmentLinesTable->addColumn("language_id", ColumnType::tInteger, true, "");
   segmentLinesTable->addColumn("character_id", ColumnType::tInteger, false, "");
   segmentLinesTable->addColumn("override_character_name", ColumnType::tText, false, "");
   segmentLinesTable->addColumn("text", ColumnType::tText, true, "");
-  segmentLinesTable->addColumn("character_state_group_id", ColumnType::tInteger, false, "");
+  segmentLinesTable->addColumn("string_key", ColumnType::tText, true, "");
+  segmentLinesTable->addColumn("spoken", ColumnType::tBoolean, false, "");
+  segmentLinesTable->addForeignKey("character_state_group_id", "character_state_groups", "id", false);
+  segmentLinesTable->addIndex({"scene_segment_id"});
+
+  /*
+    The locales listed in project.json, each of which has a string pack written for it.
+    The first is the locale the novel is written in, translations into the others are
+    read from Locales/<name>.json in the project directory.
+   */
+  DatabaseTable *localesTable = novelDb->addTable("locales");
+  localesTable->addPrimaryKey();
+  localesTable->addColumn("name", ColumnType::tText, true, "");
 
   /*
     When a row in this table is linked to a segment line, the given action will happen with the given argument
@@ -245,18 +401,21 @@ void GameCompiler::createNovelDatabase() {
   charactersTable->addColumn("bio", ColumnType::tText, false, "");
   charactersTable->addColumn("age", ColumnType::tText, false, "");
   charactersTable->addColumn("showOnCharacterMenu", ColumnType::tBoolean, false, "TRUE");
+  charactersTable->addIndex({"first_name"});
 
   DatabaseTable *characterSpritesTable = novelDb->addTable("character_sprites");
   characterSpritesTable->addPrimaryKey();
-  characterSpritesTable->addColumn("character_id", ColumnType::tInteger, true, "");
+  characterSpritesTable->addForeignKey("character_id", "characters", "id", true);
   characterSpritesTable->addColumn("name", ColumnType::tText, false, "");
   characterSpritesTable->addColumn("texture_id", ColumnType::tInteger, true, "");
+  characterSpritesTable->addIndex({"character_id", "name"});
 
   // Create Character States table - This refers to the appearance of one character at any point within a group
   DatabaseTable *characterStatesTable = novelDb->addTable("character_states");
   characterStatesTable->addPrimaryKey();
-  characterStatesTable->addColumn("character_sprite_id", ColumnType::tInteger, true, "");
-  characterStatesTable->addColumn("character_state_group_id", ColumnType::tInteger, true, "");
+  characterStatesTable->addForeignKey("character_sprite_id", "character_sprites", "id", true);
+  characterStatesTable->addForeignKey("character_state_group_id", "character_state_groups", "id", true);
+  characterStatesTable->addIndex({"character_state_group_id"});
 
   /*
     Create Character State Groups table. This table links a segment_line to many character_states.
@@ -270,7 +429,7 @@ void GameCompiler::createNovelDatabase() {
     DatabaseTable *musicPlaybackRequestTable = novelDb->addTable("music_playback_requests");
     musicPlaybackRequestTable->addPrimaryKey();
     musicPlaybackRequestTable->addColumn("music_name", ColumnType::tText, false, "");
-    musicPlaybackRequestTable->addColumn("music_playback_request_metadata_id", ColumnType::tInteger, false, "");
+    musicPlaybackRequestTable->addForeignKey("music_playback_request_metadata_id", "music_playback_request_metadata", "id", false);
 
     // Create audio effect table
     DatabaseTable *musicPlaybackRequestMetadataTable = novelDb->addTable("music_playback_request_metadata");
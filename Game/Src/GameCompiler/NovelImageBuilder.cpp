@@ -0,0 +1,399 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "Misc/Utils.hpp"
+#include "Database/QueryCursor.hpp"
+#include "GameCompiler/NovelImageBuilder.hpp"
+#include "Exceptions/ProjectBuilderException.hpp"
+
+/**
+ * [NovelImageBuilder::NovelImageBuilder Prepares to write the image of a novel]
+ * @param novelDb [The compiled novel database, everything in it must already be committed]
+ */
+NovelImageBuilder::NovelImageBuilder(DatabaseConnection *novelDb) {
+    novel = novelDb;
+}
+
+NovelImageBuilder::~NovelImageBuilder() = default;
+
+/**
+ * [NovelImageBuilder::write Reads the novel and writes its image, replacing any previous image]
+ * @param path [Path of the image file]
+ */
+void NovelImageBuilder::write(const std::string &path) {
+
+    // Lines refer to groups and segments to music requests, so these are read first
+    readCharacterStateGroups();
+    readMusicPlaybackRequests();
+    readChapters();
+    readScenes();
+    readSceneSegments();
+    readSegmentLines();
+    readSceneSegmentJumps();
+
+    NovelImageHeader header = {};
+    std::memcpy(header.magic, NOVEL_IMAGE_MAGIC, NOVEL_IMAGE_MAGIC_LENGTH);
+    header.version = NOVEL_IMAGE_VERSION;
+    header.byteOrderMark = NOVEL_IMAGE_BYTE_ORDER_MARK;
+    header.headerSize = sizeof(NovelImageHeader);
+
+    // Tables are laid out one after another, each starting on an aligned offset
+    uint64_t fileSize = sizeof(NovelImageHeader);
+
+    auto placeTable = [&fileSize](NovelImageTable &table, size_t count, size_t recordSize) {
+        fileSize = (fileSize + NOVEL_IMAGE_TABLE_ALIGNMENT - 1) / NOVEL_IMAGE_TABLE_ALIGNMENT * NOVEL_IMAGE_TABLE_ALIGNMENT;
+        table.offset = static_cast<uint32_t>(fileSize);
+        table.count = static_cast<uint32_t>(count);
+        fileSize += static_cast<uint64_t>(count) * recordSize;
+    };
+
+    placeTable(header.chapters, chapters.size(), sizeof(NovelImageChapter));
+    placeTable(header.scenes, scenes.size(), sizeof(NovelImageScene));
+    placeTable(header.sceneSegments, sceneSegments.size(), sizeof(NovelImageSceneSegment));
+    placeTable(header.segmentLines, segmentLines.size(), sizeof(NovelImageSegmentLine));
+    placeTable(header.segmentLineIndexById, segmentLineIndexById.size(), sizeof(uint32_t));
+    placeTable(header.characterStateGroups, characterStateGroups.size(), sizeof(NovelImageCharacterStateGroup));
+    placeTable(header.characterStates, characterStates.size(), sizeof(NovelImageCharacterState));
+    placeTable(header.musicPlaybackRequests, musicPlaybackRequests.size(), sizeof(NovelImageMusicPlaybackRequest));
+    placeTable(header.sceneSegmentJumps, sceneSegmentJumps.size(), sizeof(NovelImageSceneSegmentJump));
+    placeTable(header.strings, strings.size(), 1);
+
+    if (fileSize > UINT32_MAX) {
+        throw ProjectBuilderException("The novel is too large to be written to a novel image");
+    }
+
+    header.fileSize = static_cast<uint32_t>(fileSize);
+
+    // Written to a temporary file first so that a failed compile never leaves half of an image behind
+    std::string temporaryPath = path + ".tmp";
+    std::ofstream image(temporaryPath, std::ios::binary | std::ios::trunc);
+
+    if (!image.is_open()) {
+        std::vector<std::string> error = {
+                "Unable to open '", temporaryPath, "' to write the novel image"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    auto writeTable = [&image](const NovelImageTable &table, const void *records, size_t length) {
+        while (static_cast<uint64_t>(image.tellp()) < table.offset) {
+            image.put('\0');
+        }
+
+        if (length) {
+            image.write(static_cast<const char *>(records), static_cast<std::streamsize>(length));
+        }
+    };
+
+    image.write(reinterpret_cast<const char *>(&header), sizeof(NovelImageHeader));
+    writeTable(header.chapters, chapters.data(), chapters.size() * sizeof(NovelImageChapter));
+    writeTable(header.scenes, scenes.data(), scenes.size() * sizeof(NovelImageScene));
+    writeTable(header.sceneSegments, sceneSegments.data(), sceneSegments.size() * sizeof(NovelImageSceneSegment));
+    writeTable(header.segmentLines, segmentLines.data(), segmentLines.size() * sizeof(NovelImageSegmentLine));
+    writeTable(header.segmentLineIndexById, segmentLineIndexById.data(), segmentLineIndexById.size() * sizeof(uint32_t));
+    writeTable(header.characterStateGroups, characterStateGroups.data(),
+               characterStateGroups.size() * sizeof(NovelImageCharacterStateGroup));
+    writeTable(header.characterStates, characterStates.data(),
+               characterStates.size() * sizeof(NovelImageCharacterState));
+    writeTable(header.musicPlaybackRequests, musicPlaybackRequests.data(),
+               musicPlaybackRequests.size() * sizeof(NovelImageMusicPlaybackRequest));
+    writeTable(header.sceneSegmentJumps, sceneSegmentJumps.data(),
+               sceneSegmentJumps.size() * sizeof(NovelImageSceneSegmentJump));
+    writeTable(header.strings, strings.data(), strings.size());
+
+    image.close();
+
+    if (image.fail()) {
+        std::vector<std::string> error = {
+                "Unable to write the novel image to '", temporaryPath, "'"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    std::remove(path.c_str());
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::vector<std::string> error = {
+                "Unable to move the novel image from '", temporaryPath, "' to '", path, "'"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+}
+
+void NovelImageBuilder::readCharacterStateGroups() {
+
+    QueryCursor groupData(novel->prepare("SELECT id FROM character_state_groups ORDER BY id;"));
+
+    while (groupData.next()) {
+        NovelImageCharacterStateGroup group = {};
+        group.id = groupData.getInteger(0);
+
+        characterStateGroupIndex[group.id] = static_cast<uint32_t>(characterStateGroups.size());
+        characterStateGroups.push_back(group);
+    }
+
+    // The sprite is joined to each state, a missing sprite is only an error if the runner reaches it
+    QueryCursor stateData(novel->prepare(
+            "SELECT character_states.id, character_states.character_state_group_id, character_states.character_sprite_id, "
+            "character_sprites.id, character_sprites.character_id, character_sprites.name "
+            "FROM character_states "
+            "LEFT JOIN character_sprites ON character_sprites.id = character_states.character_sprite_id "
+            "ORDER BY character_states.character_state_group_id, character_states.id;"));
+
+    while (stateData.next()) {
+
+        auto group = characterStateGroupIndex.find(stateData.getInteger(1));
+
+        if (group == characterStateGroupIndex.end()) {
+            continue;
+        }
+
+        NovelImageCharacterStateGroup &imageGroup = characterStateGroups[group->second];
+
+        if (!imageGroup.characterStateCount) {
+            imageGroup.firstCharacterState = static_cast<uint32_t>(characterStates.size());
+        }
+
+        imageGroup.characterStateCount++;
+
+        NovelImageCharacterState state = {};
+        state.id = stateData.getInteger(0);
+        state.characterSpriteId = stateData.getInteger(2);
+        state.characterId = stateData.isNull(3) ? 0 : stateData.getInteger(4);
+        state.spriteName = addString(stateData.isNull(3) ? "" : stateData.getString(5));
+
+        characterStates.push_back(state);
+    }
+}
+
+void NovelImageBuilder::readMusicPlaybackRequests() {
+
+    QueryCursor requestData(novel->prepare(
+            "SELECT music_playback_requests.id, music_playback_requests.music_name, "
+            "music_playback_request_metadata.id, music_playback_request_metadata.pitch, "
+            "music_playback_request_metadata.volume, music_playback_request_metadata.loop, "
+            "music_playback_request_metadata.startTime, music_playback_request_metadata.endTime, "
+            "music_playback_request_metadata.muted "
+            "FROM music_playback_requests "
+            "LEFT JOIN music_playback_request_metadata "
+            "ON music_playback_request_metadata.id = music_playback_requests.music_playback_request_metadata_id "
+            "ORDER BY music_playback_requests.id;"));
+
+    while (requestData.next()) {
+        NovelImageMusicPlaybackRequest request = {};
+        request.id = requestData.getInteger(0);
+        request.musicName = addString(requestData.getString(1));
+
+        if (!requestData.isNull(2)) {
+            request.hasMetadata = 1;
+            request.metadataId = requestData.getInteger(2);
+            request.pitch = requestData.getFloat(3);
+            request.volume = requestData.getInteger(4);
+            request.loop = requestData.getBoolean(5) ? 1 : 0;
+            request.startTime = requestData.getInteger(6);
+            request.endTime = requestData.getInteger(7);
+            request.muted = requestData.getBoolean(8) ? 1 : 0;
+        }
+
+        musicPlaybackRequestIndex[request.id] = static_cast<uint32_t>(musicPlaybackRequests.size());
+        musicPlaybackRequests.push_back(request);
+    }
+}
+
+void NovelImageBuilder::readChapters() {
+
+    QueryCursor chapterData(novel->prepare("SELECT id, title FROM chapters ORDER BY id;"));
+
+    while (chapterData.next()) {
+        NovelImageChapter chapter = {};
+        chapter.id = chapterData.getInteger(0);
+        chapter.title = addString(chapterData.getString(1));
+
+        chapters.push_back(chapter);
+    }
+}
+
+void NovelImageBuilder::readScenes() {
+
+    // Chapters are ordered by id, so ordering by chapter id keeps each chapter's scenes together and in chapter order
+    QueryCursor sceneData(novel->prepare(
+            "SELECT scenes.* FROM scenes "
+            "JOIN chapters ON chapters.id = scenes.chapter_id "
+            "ORDER BY scenes.chapter_id, scenes.id;"));
+
+    int chapterIdColumn = sceneData.getColumnIndex("chapter_id");
+    size_t chapterIndex = 0;
+
+    while (sceneData.next()) {
+
+        int chapterId = sceneData.getInteger(chapterIdColumn);
+
+        while (chapters[chapterIndex].id != chapterId) {
+            chapterIndex++;
+        }
+
+        NovelImageChapter &chapter = chapters[chapterIndex];
+
+        if (!chapter.sceneCount) {
+            chapter.firstScene = static_cast<uint32_t>(scenes.size());
+        }
+
+        chapter.sceneCount++;
+
+        NovelImageScene scene = {};
+        scene.id = sceneData.getInteger("id");
+        scene.backgroundImageName = addString(sceneData.getString("background_image_name"));
+        scene.backgroundColourId = sceneData.getInteger("background_colour_id");
+        scene.startTransitionColourId = sceneData.getInteger("start_transition_colour_id");
+        scene.endTransitionColourId = sceneData.getInteger("end_transition_colour_id");
+        scene.startTransitionTypeId = sceneData.getInteger("start_transition_type_id");
+        scene.endTransitionTypeId = sceneData.getInteger("end_transition_type_id");
+
+        scenes.push_back(scene);
+    }
+}
+
+void NovelImageBuilder::readSceneSegments() {
+
+    QueryCursor segmentData(novel->prepare(
+            "SELECT scene_segments.* FROM scene_segments "
+            "JOIN scenes ON scenes.id = scene_segments.scene_id "
+            "JOIN chapters ON chapters.id = scenes.chapter_id "
+            "ORDER BY scenes.chapter_id, scene_segments.scene_id, scene_segments.id;"));
+
+    int idColumn = segmentData.getColumnIndex("id");
+    int sceneIdColumn = segmentData.getColumnIndex("scene_id");
+    int visualEffectNameColumn = segmentData.getColumnIndex("visual_effect_name");
+    int musicPlaybackRequestIdColumn = segmentData.getColumnIndex("music_playback_request_id");
+    size_t sceneIndex = 0;
+
+    while (segmentData.next()) {
+
+        int sceneId = segmentData.getInteger(sceneIdColumn);
+
+        while (scenes[sceneIndex].id != sceneId) {
+            sceneIndex++;
+        }
+
+        NovelImageScene &scene = scenes[sceneIndex];
+
+        if (!scene.sceneSegmentCount) {
+            scene.firstSceneSegment = static_cast<uint32_t>(sceneSegments.size());
+        }
+
+        scene.sceneSegmentCount++;
+
+        NovelImageSceneSegment segment = {};
+        segment.id = segmentData.getInteger(idColumn);
+        segment.visualEffectName = addString(segmentData.getString(visualEffectNameColumn));
+        segment.musicPlaybackRequest = NOVEL_IMAGE_NO_INDEX;
+
+        auto request = musicPlaybackRequestIndex.find(segmentData.getInteger(musicPlaybackRequestIdColumn));
+
+        if (request != musicPlaybackRequestIndex.end()) {
+            segment.musicPlaybackRequest = request->second;
+        }
+
+        sceneSegments.push_back(segment);
+    }
+}
+
+void NovelImageBuilder::readSegmentLines() {
+
+    QueryCursor lineData(novel->prepare(
+            "SELECT segment_lines.* FROM segment_lines "
+            "JOIN scene_segments ON scene_segments.id = segment_lines.scene_segment_id "
+            "JOIN scenes ON scenes.id = scene_segments.scene_id "
+            "JOIN chapters ON chapters.id = scenes.chapter_id "
+            "ORDER BY scenes.chapter_id, scene_segments.scene_id, segment_lines.scene_segment_id, segment_lines.id;"));
+
+    int idColumn = lineData.getColumnIndex("id");
+    int segmentIdColumn = lineData.getColumnIndex("scene_segment_id");
+    int textColumn = lineData.getColumnIndex("text");
+    int characterIdColumn = lineData.getColumnIndex("character_id");
+    int characterStateGroupIdColumn = lineData.getColumnIndex("character_state_group_id");
+    int overrideCharacterNameColumn = lineData.getColumnIndex("override_character_name");
+    size_t segmentIndex = 0;
+
+    while (lineData.next()) {
+
+        int segmentId = lineData.getInteger(segmentIdColumn);
+
+        while (sceneSegments[segmentIndex].id != segmentId) {
+            segmentIndex++;
+        }
+
+        NovelImageSceneSegment &segment = sceneSegments[segmentIndex];
+
+        if (!segment.segmentLineCount) {
+            segment.firstSegmentLine = static_cast<uint32_t>(segmentLines.size());
+        }
+
+        segment.segmentLineCount++;
+
+        NovelImageSegmentLine line = {};
+        line.id = lineData.getInteger(idColumn);
+        line.characterId = lineData.getInteger(characterIdColumn);
+        line.text = addString(lineData.getString(textColumn));
+        line.overrideCharacterName = addString(lineData.getString(overrideCharacterNameColumn));
+        line.characterStateGroup = NOVEL_IMAGE_NO_INDEX;
+
+        auto group = characterStateGroupIndex.find(lineData.getInteger(characterStateGroupIdColumn));
+
+        if (group != characterStateGroupIndex.end()) {
+            line.characterStateGroup = group->second;
+        }
+
+        if (line.id >= 0) {
+            if (line.id >= static_cast<int>(segmentLineIndexById.size())) {
+                segmentLineIndexById.resize(line.id + 1, NOVEL_IMAGE_NO_INDEX);
+            }
+
+            segmentLineIndexById[line.id] = static_cast<uint32_t>(segmentLines.size());
+        }
+
+        segmentLines.push_back(line);
+    }
+}
+
+void NovelImageBuilder::readSceneSegmentJumps() {
+
+    QueryCursor jumpData(novel->prepare(
+            "SELECT scene_segment_id, chapter_index, scene_index, scene_segment_index FROM scene_segment_jumps "
+            "ORDER BY scene_segment_id;"));
+
+    while (jumpData.next()) {
+        int sceneSegmentId = jumpData.getInteger(0);
+
+        if (sceneSegmentId < 0) {
+            continue;
+        }
+
+        if (sceneSegmentId >= static_cast<int>(sceneSegmentJumps.size())) {
+            sceneSegmentJumps.resize(sceneSegmentId + 1, {-1, -1, -1});
+        }
+
+        sceneSegmentJumps[sceneSegmentId] = {jumpData.getInteger(1), jumpData.getInteger(2), jumpData.getInteger(3)};
+    }
+}
+
+/**
+ * [NovelImageBuilder::addString Adds a string to the string blob, strings which have already been added are shared]
+ * @param  value [The string]
+ * @return       [Where the string is within the blob]
+ */
+NovelImageString NovelImageBuilder::addString(const std::string &value) {
+
+    auto existing = stringIndex.find(value);
+
+    if (existing != stringIndex.end()) {
+        return existing->second;
+    }
+
+    NovelImageString imageString = {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(value.size())};
+
+    strings.append(value);
+    stringIndex[value] = imageString;
+
+    return imageString;
+}
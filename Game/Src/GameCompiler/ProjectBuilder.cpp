@@ -7,10 +7,15 @@
 #include "GameCompiler/ProjectBuilder.hpp"
 #include "GameCompiler/ResourceBuilder.hpp"
 #include "GameCompiler/ChapterBuilder.hpp"
+#include "GameCompiler/SceneGraphBuilder.hpp"
+#include "GameCompiler/RequirementCompiler.hpp"
+#include "GameCompiler/ScriptCompiler.hpp"
 #include "Exceptions/ProjectBuilderException.hpp"
 #include <fstream>
 #include <regex>
+#include <unordered_set>
 #include "Misc/Utils.hpp"
+#include "Misc/StringPackFormat.hpp"
 
 #define VERBOSE_PROJECT_BUILDER_MESSAGES
 
@@ -123,6 +128,22 @@ void ProjectBuilder::process() {
   // Process all of the characters
   processCharacters();
 
+  // The string packs themselves are written once the novel has been compiled, see StringPackBuilder
+  if (projectJson.find("locales") != projectJson.end()) {
+    processLocales(projectJson["locales"]);
+  }
+
+  // Flags are numbered before any chapter is read, as chapters refer to them by name
+  RequirementCompiler requirementCompiler(novel);
+
+  if (projectJson.find("flags") != projectJson.end()) {
+    requirementCompiler.processFlags(projectJson["flags"]);
+  }
+
+  // Scripts refer to flags and characters by name, so they are compiled once both have been written
+  ScriptCompiler scriptCompiler(resource, novel, projectDirectory, &requirementCompiler);
+  scriptCompiler.process();
+
   json chapters = projectJson["chapters"];
   int numberOfChapters = 0;
 
@@ -137,7 +158,7 @@ void ProjectBuilder::process() {
 
     std::string chapterFilePath = Utils::implodeString(explodedFilePath, "", 0);
 
-    auto *chapterBuilder = new ChapterBuilder(chapterFilePath, novel, fHandler);
+    auto *chapterBuilder = new ChapterBuilder(chapterFilePath, novel, fHandler, &characterStateGroupIds, &requirementCompiler);
     chapterBuilder->process();
     delete(chapterBuilder);
   }
@@ -145,6 +166,56 @@ void ProjectBuilder::process() {
   if (numberOfChapters == 0) {
     throw ProjectBuilderException("No chapters were listed to be processed in the 'chapters' attribute of project.json.");
   }
+
+  // Jumps can lead anywhere in the project, so they are resolved once every chapter has been written
+  SceneGraphBuilder sceneGraphBuilder(novel);
+  sceneGraphBuilder.process();
+
+  scriptCompiler.checkSegmentScripts();
+}
+
+/**
+ * [ProjectBuilder::processLocales Writes the locales the novel is played in, the first being the one it is written in]
+ * @param localesJson [The 'locales' attribute of project.json, a list of locale names]
+ */
+void ProjectBuilder::processLocales(json localesJson) {
+
+  if (!localesJson.is_array() || localesJson.empty()) {
+    throw ProjectBuilderException("The 'locales' attribute of project.json must be a list of at least one locale name");
+  }
+
+  std::vector<std::vector<std::string>> localeRows;
+  std::unordered_set<std::string> localeNames;
+
+  for (auto &element : localesJson) {
+
+    if (!element.is_string()) {
+      throw ProjectBuilderException("Each locale in the 'locales' attribute of project.json must be a name");
+    }
+
+    std::string name = element.get<std::string>();
+
+    // Names become file names, so they are kept to characters which are safe in one
+    if (name.empty() || name.size() >= STRING_PACK_LOCALE_LENGTH
+        || name.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-") != std::string::npos) {
+      std::vector<std::string> error = {
+        "'", name, "' is not a valid locale name, it must be made of letters, digits, '_' and '-' and be at most ",
+        std::to_string(STRING_PACK_LOCALE_LENGTH - 1), " characters long"
+      };
+      throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    if (!localeNames.insert(name).second) {
+      std::vector<std::string> error = {"The locale '", name, "' is listed more than once in project.json"};
+      throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    localeRows.push_back({name});
+  }
+
+  std::vector<std::string> columns = {"name"};
+  std::vector<int> types = {DATA_TYPE_STRING};
+  novel->insert("locales", columns, localeRows, types);
 }
 
 void ProjectBuilder::processCharacters() {
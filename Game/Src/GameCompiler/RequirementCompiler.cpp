@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <iostream>
+#include "Misc/Utils.hpp"
+#include "Misc/JsonHandler.hpp"
+#include "Misc/NovelRequirementFormat.hpp"
+#include "GameCompiler/RequirementCompiler.hpp"
+#include "Exceptions/ProjectBuilderException.hpp"
+
+/**
+ * [RequirementCompiler::RequirementCompiler Prepares to compile requirements, no flags or counters are declared yet]
+ * @param novelDb [The novel database being written]
+ */
+RequirementCompiler::RequirementCompiler(DatabaseConnection *novelDb) {
+    novel = novelDb;
+    flagCount = 0;
+    counterCount = 0;
+}
+
+RequirementCompiler::~RequirementCompiler() = default;
+
+/**
+ * [RequirementCompiler::processFlags Numbers the flags and counters declared in project.json and writes them to the
+ * flags table. Flags and counters are numbered separately, in the order they are declared]
+ * @param flagsJson [The 'flags' attribute of project.json]
+ */
+void RequirementCompiler::processFlags(const nlohmann::json &flagsJson) {
+
+    std::cout << "Processing flags..." << std::endl;
+
+    std::vector<std::vector<std::string>> flagRows;
+
+    for (auto &element : flagsJson.items()) {
+        nlohmann::json flagJson = element.value();
+
+        if (flagJson.find("name") == flagJson.end()) {
+            throw ProjectBuilderException("Every flag in the 'flags' attribute of project.json must have a name");
+        }
+
+        std::string name = JsonHandler::getString(flagJson, "name");
+        bool counter = false;
+        int defaultValue = 0;
+
+        if (name.empty() || flags.count(name)) {
+            std::vector<std::string> error = {
+                    "The flag '", name, "' has already been declared, flag names must be unique and not empty"
+            };
+            throw ProjectBuilderException(Utils::implodeString(error));
+        }
+
+        if (flagJson.find("counter") != flagJson.end()) {
+            counter = JsonHandler::getBoolean(flagJson, "counter");
+        }
+
+        if (flagJson.find("default") != flagJson.end()) {
+            defaultValue = counter ? JsonHandler::getInteger(flagJson, "default")
+                                   : (JsonHandler::getBoolean(flagJson, "default") ? 1 : 0);
+        }
+
+        DeclaredFlag flag = {counter, counter ? counterCount++ : flagCount++};
+        flags[name] = flag;
+
+        flagRows.push_back({name, counter ? "TRUE" : "FALSE", std::to_string(flag.index), std::to_string(defaultValue)});
+    }
+
+    if (flagRows.empty()) {
+        return;
+    }
+
+    std::vector<std::string> columns = {"name", "counter", "flag_index", "default_value"};
+    std::vector<int> types = {DATA_TYPE_STRING, DATA_TYPE_BOOLEAN, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER};
+    novel->insert("flags", columns, flagRows, types);
+}
+
+/**
+ * [RequirementCompiler::compile Compiles a requirement and writes it to the requirements and requirement_terms tables]
+ * @param  requirementJson [The requirement]
+ * @param  owner           [Description of what has the requirement, used in error messages]
+ * @return                 [Id of the requirement]
+ */
+int RequirementCompiler::compile(const nlohmann::json &requirementJson, const std::string &owner) {
+
+    std::vector<CompiledTerm> terms;
+    int depth = compileTerms(requirementJson, owner, terms);
+
+    if (depth > NOVEL_REQUIREMENT_MAX_DEPTH) {
+        std::vector<std::string> error = {
+                "The requirement of ", owner, " is nested too deeply, it can be at most ",
+                std::to_string(NOVEL_REQUIREMENT_MAX_DEPTH), " levels deep"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    std::vector<std::string> columns = {"term_count"};
+    std::vector<std::string> values = {std::to_string(terms.size())};
+    std::vector<int> types = {DATA_TYPE_NUMBER};
+    int requirementId = novel->insert("requirements", columns, values, types);
+
+    std::vector<std::vector<std::string>> termRows;
+
+    for (auto &term : terms) {
+        termRows.push_back({std::to_string(requirementId), std::to_string(term.opcode), std::to_string(term.operand),
+                            std::to_string(term.value)});
+    }
+
+    std::vector<std::string> termColumns = {"requirement_id", "opcode", "operand", "value"};
+    std::vector<int> termTypes = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER};
+    novel->insert("requirement_terms", termColumns, termRows, termTypes);
+
+    return requirementId;
+}
+
+/**
+ * [RequirementCompiler::compileFlagChanges Writes the flags and counters a scene segment changes when it starts to the
+ * scene_segment_flag_changes table. 'set' gives flags and counters their value, then 'add' adds to counters]
+ * @param sceneSegmentId   [Id of the segment]
+ * @param sceneSegmentJson [The segment]
+ * @param owner            [Description of the segment, used in error messages]
+ */
+void RequirementCompiler::compileFlagChanges(int sceneSegmentId, const nlohmann::json &sceneSegmentJson,
+                                             const std::string &owner) {
+
+    std::vector<std::vector<std::string>> changeRows;
+
+    auto addChange = [&](int operation, int operand, int value) {
+        changeRows.push_back({std::to_string(sceneSegmentId), std::to_string(operation), std::to_string(operand),
+                              std::to_string(value)});
+    };
+
+    if (sceneSegmentJson.find("set") != sceneSegmentJson.end()) {
+        for (auto &element : sceneSegmentJson["set"].items()) {
+
+            // Both flags and counters can be set, only an undeclared name is an error
+            auto declared = flags.find(element.key());
+            DeclaredFlag flag = declared != flags.end() ? declared->second : findFlag(element.key(), false, owner);
+
+            if (flag.counter) {
+                addChange(NOVEL_FLAG_CHANGE_SET_COUNTER, flag.index,
+                          JsonHandler::getInteger(sceneSegmentJson["set"], element.key()));
+            } else {
+                addChange(NOVEL_FLAG_CHANGE_SET_FLAG, flag.index,
+                          JsonHandler::getBoolean(sceneSegmentJson["set"], element.key()) ? 1 : 0);
+            }
+        }
+    }
+
+    if (sceneSegmentJson.find("add") != sceneSegmentJson.end()) {
+        for (auto &element : sceneSegmentJson["add"].items()) {
+            DeclaredFlag counter = findFlag(element.key(), true, owner);
+            addChange(NOVEL_FLAG_CHANGE_ADD_COUNTER, counter.index,
+                      JsonHandler::getInteger(sceneSegmentJson["add"], element.key()));
+        }
+    }
+
+    if (changeRows.empty()) {
+        return;
+    }
+
+    std::vector<std::string> columns = {"scene_segment_id", "operation", "operand", "value"};
+    std::vector<int> types = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER};
+    novel->insert("scene_segment_flag_changes", columns, changeRows, types);
+}
+
+/**
+ * [RequirementCompiler::getFlagIndex Finds the index the runner knows a flag or counter by]
+ * @param  name    [Name of the flag or counter]
+ * @param  counter [Whether it must be a counter rather than a flag]
+ * @param  owner   [Description of what refers to it, used in error messages]
+ * @return         [Its index, flags and counters are numbered separately]
+ */
+int RequirementCompiler::getFlagIndex(const std::string &name, bool counter, const std::string &owner) {
+    return findFlag(name, counter, owner).index;
+}
+
+/**
+ * [RequirementCompiler::compileTerms Appends the terms of a requirement in postfix order]
+ * @param  requirementJson [The requirement]
+ * @param  owner           [Description of what has the requirement, used in error messages]
+ * @param  terms           [Where the terms are appended]
+ * @return                 [How many results the runner has to hold at once to evaluate it]
+ */
+int RequirementCompiler::compileTerms(const nlohmann::json &requirementJson, const std::string &owner,
+                                      std::vector<CompiledTerm> &terms) {
+
+    if (requirementJson.is_boolean()) {
+        terms.push_back({requirementJson.get<bool>() ? NOVEL_REQUIREMENT_TRUE : NOVEL_REQUIREMENT_FALSE, 0, 0});
+        return 1;
+    }
+
+    if (requirementJson.is_string()) {
+        terms.push_back({NOVEL_REQUIREMENT_FLAG, findFlag(requirementJson.get<std::string>(), false, owner).index, 0});
+        return 1;
+    }
+
+    if (!requirementJson.is_object()) {
+        std::vector<std::string> error = {
+                "The requirement of ", owner, " must be the name of a flag, true, false or an object"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    if (requirementJson.find("not") != requirementJson.end()) {
+        int depth = compileTerms(requirementJson["not"], owner, terms);
+        terms.push_back({NOVEL_REQUIREMENT_NOT, 0, 0});
+
+        return depth;
+    }
+
+    bool all = requirementJson.find("all") != requirementJson.end();
+
+    if (all || requirementJson.find("any") != requirementJson.end()) {
+        nlohmann::json operands = requirementJson[all ? "all" : "any"];
+
+        if (!operands.is_array()) {
+            std::vector<std::string> error = {
+                    "The '", all ? "all" : "any", "' requirement of ", owner, " must be an array of requirements"
+            };
+            throw ProjectBuilderException(Utils::implodeString(error));
+        }
+
+        // Nothing to check is met by 'all' and not by 'any'
+        if (operands.empty()) {
+            terms.push_back({all ? NOVEL_REQUIREMENT_TRUE : NOVEL_REQUIREMENT_FALSE, 0, 0});
+            return 1;
+        }
+
+        int depth = 0;
+
+        for (size_t i = 0; i < operands.size(); i++) {
+            // Every operand after the first is evaluated while the result of those before it is held
+            depth = std::max(depth, compileTerms(operands[i], owner, terms) + (i > 0 ? 1 : 0));
+
+            if (i > 0) {
+                terms.push_back({all ? NOVEL_REQUIREMENT_AND : NOVEL_REQUIREMENT_OR, 0, 0});
+            }
+        }
+
+        return depth;
+    }
+
+    if (requirementJson.find("counter") != requirementJson.end()) {
+        DeclaredFlag counter = findFlag(JsonHandler::getString(requirementJson, "counter"), true, owner);
+
+        std::vector<std::pair<std::string, int>> comparisons = {
+                {"atLeast", NOVEL_REQUIREMENT_COUNTER_AT_LEAST},
+                {"atMost", NOVEL_REQUIREMENT_COUNTER_AT_MOST},
+                {"equals", NOVEL_REQUIREMENT_COUNTER_EQUALS}
+        };
+
+        int comparisonCount = 0;
+
+        for (auto &comparison : comparisons) {
+            if (requirementJson.find(comparison.first) == requirementJson.end()) {
+                continue;
+            }
+
+            terms.push_back({comparison.second, counter.index, JsonHandler::getInteger(requirementJson, comparison.first)});
+
+            if (++comparisonCount > 1) {
+                terms.push_back({NOVEL_REQUIREMENT_AND, 0, 0});
+            }
+        }
+
+        if (comparisonCount == 0) {
+            std::vector<std::string> error = {
+                    "The counter requirement of ", owner, " must have 'atLeast', 'atMost' or 'equals'"
+            };
+            throw ProjectBuilderException(Utils::implodeString(error));
+        }
+
+        return comparisonCount > 1 ? 2 : 1;
+    }
+
+    std::vector<std::string> error = {
+            "The requirement of ", owner, " must have one of 'not', 'all', 'any' or 'counter'"
+    };
+    throw ProjectBuilderException(Utils::implodeString(error));
+}
+
+/**
+ * [RequirementCompiler::findFlag Finds a flag or counter declared in project.json]
+ * @param  name    [Name of the flag or counter]
+ * @param  counter [Whether it must be a counter rather than a flag]
+ * @param  owner   [Description of what refers to it, used in error messages]
+ * @return         [The flag or counter]
+ */
+RequirementCompiler::DeclaredFlag RequirementCompiler::findFlag(const std::string &name, bool counter,
+                                                                const std::string &owner) {
+
+    auto flag = flags.find(name);
+
+    if (flag == flags.end()) {
+        std::vector<std::string> error = {
+                "The ", counter ? "counter" : "flag", " '", name, "' used by ", owner,
+                " is not declared in the 'flags' attribute of project.json"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    if (flag->second.counter != counter) {
+        std::vector<std::string> error = {
+                "'", name, "' is used as a ", counter ? "counter" : "flag", " by ", owner, ", but it is declared as a ",
+                counter ? "flag" : "counter"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    return flag->second;
+}
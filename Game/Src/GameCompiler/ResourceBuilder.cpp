@@ -46,6 +46,7 @@ void ResourceBuilder::process() {
     processSprites();
     processFonts();
     processMusic();
+    processScripts();
 }
 
 void ResourceBuilder::processBackgroundImages() {
@@ -67,7 +68,7 @@ void ResourceBuilder::processBackgroundImages() {
 
         std::string name;
         std::string fileName;
-        std::string enabled;
+        bool enabled;
 
         // Some error handling...
         if (backgroundImage.find("name") == backgroundImage.end()) {
@@ -79,19 +80,15 @@ void ResourceBuilder::processBackgroundImages() {
         }
 
         if (backgroundImage.find("enabled") != backgroundImage.end()) {
-            enabled = TypeCaster::cast(JsonHandler::getBoolean(backgroundImage,"enabled"));
+            enabled = JsonHandler::getBoolean(backgroundImage,"enabled");
         } else {
-            enabled = "TRUE"; // If not stated otherwise, assume that it is enabled
+            enabled = true; // If not stated otherwise, assume that it is enabled
         }
 
         name = JsonHandler::getString(backgroundImage,"name");
         fileName = JsonHandler::getString(backgroundImage,"fileName");
 
-        std::vector<std::string> columns = {"name", "filename", "enabled"};
-        std::vector<std::string> values = {name, fileName, enabled};
-        std::vector<int> types = {DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_BOOLEAN};
-
-        int backgroundImageIdFromInsert = resource->insert("background_images", columns, values, types);
+        int backgroundImageIdFromInsert = insertResource("background_images", name, fileName, enabled);
 
         numberOfBackgroundImages++;
 
@@ -168,7 +165,7 @@ void ResourceBuilder::processTextures() {
 
         std::string name;
         std::string fileName;
-        std::string enabled;
+        bool enabled;
 
         // Some error handling...
         if (texture.find("name") == texture.end()) {
@@ -180,24 +177,84 @@ void ResourceBuilder::processTextures() {
         }
 
         if (texture.find("enabled") != texture.end()) {
-            enabled = TypeCaster::cast(JsonHandler::getBoolean(texture,"enabled"));
+            enabled = JsonHandler::getBoolean(texture,"enabled");
         } else {
-            enabled = "TRUE"; // If not stated otherwise, assume that it is enabled
+            enabled = true; // If not stated otherwise, assume that it is enabled
         }
 
         name = JsonHandler::getString(texture,"name");
         fileName = JsonHandler::getString(texture,"fileName");
 
-        std::vector<std::string> columns = {"name", "filename", "enabled"};
-        std::vector<std::string> values = {name, fileName, enabled};
-        std::vector<int> types = {DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_BOOLEAN};
-
-        resource->insert("textures", columns, values, types);
+        insertResource("textures", name, fileName, enabled);
 
         numberOfTextureEntries++;
     }
 }
 
+/**
+ * [ResourceBuilder::processScripts Lists the scripts in Scripts.json, which are compiled once the flags and characters
+ * they refer to are known (see ScriptCompiler). A project doesn't need to have any scripts]
+ */
+void ResourceBuilder::processScripts() {
+
+    std::string scriptDirectory = resourceDirectory;
+    scriptDirectory.append("Scripts/");
+
+    std::string scriptJsonFileName = scriptDirectory;
+    scriptJsonFileName.append("Scripts.json");
+
+    if (!Utils::fileExists(scriptJsonFileName)) {
+        return;
+    }
+
+    std::cout << "Processing Scripts..." << std::endl;
+
+    json scriptJson = fHandler->parseJsonFile(scriptJsonFileName);
+
+    for (auto &element : scriptJson.items()) {
+        json script = element.value();
+
+        bool enabled = true; // If not stated otherwise, assume that it is enabled
+
+        if (script.find("name") == script.end()) {
+            throw ProjectBuilderException("Each script must have a 'name' attribute");
+        }
+
+        if (script.find("fileName") == script.end()) {
+            throw ProjectBuilderException("Each script must have a 'fileName' attribute");
+        }
+
+        if (script.find("enabled") != script.end()) {
+            enabled = JsonHandler::getBoolean(script, "enabled");
+        }
+
+        insertResource("scripts", JsonHandler::getString(script, "name"), JsonHandler::getString(script, "fileName"),
+                       enabled);
+    }
+}
+
+/**
+ * [ResourceBuilder::insertResource Adds a row to one of the resource tables which share the name/filename/enabled layout]
+ * @param tableName [The table to insert into]
+ * @param name      [Accessible name of the resource]
+ * @param fileName  [File name of the resource]
+ * @param enabled   [Whether the resource is enabled]
+ * @return          [ID of the new row]
+ */
+int ResourceBuilder::insertResource(const std::string &tableName, const std::string &name, const std::string &fileName,
+                                    bool enabled) {
+
+    std::vector<std::string> query = {
+            "INSERT INTO `", tableName, "` (name, filename, enabled) VALUES (?, ?, ?);"
+    };
+
+    return resource->prepare(Utils::implodeString(query))
+            ->bind(1, name)
+            ->bind(2, fileName)
+            ->bind(3, enabled ? 1 : 0)
+            ->execute();
+}
+
 void ResourceBuilder::processSprites() {
 
 }
@@ -223,7 +280,7 @@ void ResourceBuilder::processFonts() {
 
         std::string name;
         std::string fileName;
-        std::string enabled;
+        bool enabled;
 
         // Some error handling...
         if (font.find("name") == font.end()) {
@@ -235,19 +292,15 @@ void ResourceBuilder::processFonts() {
         }
 
         if (font.find("enabled") != font.end()) {
-            enabled = TypeCaster::cast(JsonHandler::getBoolean(font,"enabled"));
+            enabled = JsonHandler::getBoolean(font,"enabled");
         } else {
-            enabled = "TRUE"; // If not stated otherwise, assume that it is enabled
+            enabled = true; // If not stated otherwise, assume that it is enabled
         }
 
         name = JsonHandler::getString(font,"name");
         fileName = JsonHandler::getString(font,"fileName");
 
-        std::vector<std::string> columns = {"name", "filename", "enabled"};
-        std::vector<std::string> values = {name, fileName, enabled};
-        std::vector<int> types = {DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_BOOLEAN};
-
-        resource->insert("fonts", columns, values, types);
+        insertResource("fonts", name, fileName, enabled);
 
         numberOfFontEntries++;
     }
@@ -278,7 +331,7 @@ void ResourceBuilder::processMusic() {
 
         std::string name;
         std::string fileName;
-        std::string enabled;
+        bool enabled;
 
         // Some error handling...
         if (music.find("name") == music.end()) {
@@ -290,19 +343,15 @@ void ResourceBuilder::processMusic() {
         }
 
         if (music.find("enabled") != music.end()) {
-            enabled = TypeCaster::cast(JsonHandler::getBoolean(music,"enabled"));
+            enabled = JsonHandler::getBoolean(music,"enabled");
         } else {
-            enabled = "TRUE"; // If not stated otherwise, assume that it is enabled
+            enabled = true; // If not stated otherwise, assume that it is enabled
         }
 
         name = JsonHandler::getString(music,"name");
         fileName = JsonHandler::getString(music,"fileName");
 
-        std::vector<std::string> columns = {"name", "filename", "enabled"};
-        std::vector<std::string> values = {name, fileName, enabled};
-        std::vector<int> types = {DATA_TYPE_STRING, DATA_TYPE_STRING, DATA_TYPE_BOOLEAN};
-
-        resource->insert("music", columns, values, types);
+        insertResource("music", name, fileName, enabled);
 
         numberOfMusicEntries++;
 
@@ -0,0 +1,269 @@
+#include <iostream>
+#include "Misc/Utils.hpp"
+#include "Database/QueryCursor.hpp"
+#include "GameCompiler/SceneGraphBuilder.hpp"
+#include "Exceptions/ProjectBuilderException.hpp"
+
+/**
+ * [SceneGraphBuilder::SceneGraphBuilder Prepares to resolve the jumps of a novel]
+ * @param novelDb [The novel database, every chapter must already have been written to it]
+ */
+SceneGraphBuilder::SceneGraphBuilder(DatabaseConnection *novelDb) {
+    novel = novelDb;
+}
+
+SceneGraphBuilder::~SceneGraphBuilder() = default;
+
+/**
+ * [SceneGraphBuilder::process Resolves the jump at the end of every scene segment and writes them to the database]
+ */
+void SceneGraphBuilder::process() {
+
+    std::cout << "Resolving scene jumps..." << std::endl;
+
+    readChapters();
+    readScenes();
+    readSceneSegments();
+
+    // Every label is known before any jump is resolved, as a jump can lead to a label further on in the project
+    for (int i = 0; i < static_cast<int>(chapters.size()); i++) {
+        GraphChapter &chapter = chapters[i];
+
+        if (!chapter.label.empty()) {
+            if (chapter.scenes.empty()) {
+                std::vector<std::string> error = {
+                        "The chapter '", chapter.title, "' has the label '", chapter.label, "' but no scenes to jump to"
+                };
+                throw ProjectBuilderException(Utils::implodeString(error));
+            }
+
+            addLabel(chapter.label, {i, 0, 0}, "the chapter '" + chapter.title + "'");
+        }
+
+        for (int j = 0; j < static_cast<int>(chapter.scenes.size()); j++) {
+            GraphScene &scene = chapter.scenes[j];
+
+            if (!scene.label.empty()) {
+                addLabel(scene.label, {i, j, 0}, "scene " + std::to_string(scene.id));
+            }
+
+            for (int k = 0; k < static_cast<int>(scene.sceneSegments.size()); k++) {
+                GraphSceneSegment &sceneSegment = scene.sceneSegments[k];
+
+                if (!sceneSegment.label.empty()) {
+                    addLabel(sceneSegment.label, {i, j, k}, "scene segment " + std::to_string(sceneSegment.id));
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<std::string>> jumpRows;
+
+    for (int i = 0; i < static_cast<int>(chapters.size()); i++) {
+        for (int j = 0; j < static_cast<int>(chapters[i].scenes.size()); j++) {
+            GraphScene &scene = chapters[i].scenes[j];
+
+            for (int k = 0; k < static_cast<int>(scene.sceneSegments.size()); k++) {
+                GraphSceneSegment &sceneSegment = scene.sceneSegments[k];
+
+                GraphPosition target = sceneSegment.nextLabel.empty()
+                                       ? findFallThrough(i, j, k)
+                                       : findLabel(sceneSegment.nextLabel, "scene segment " + std::to_string(sceneSegment.id));
+
+                jumpRows.push_back({std::to_string(sceneSegment.id), std::to_string(target.chapter),
+                                    std::to_string(target.scene), std::to_string(target.sceneSegment)});
+            }
+        }
+    }
+
+    resolveBranches();
+
+    if (jumpRows.empty()) {
+        return;
+    }
+
+    std::vector<std::string> columns = {"scene_segment_id", "chapter_index", "scene_index", "scene_segment_index"};
+    std::vector<int> types = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER};
+    novel->insert("scene_segment_jumps", columns, jumpRows, types);
+}
+
+/**
+ * [SceneGraphBuilder::resolveBranches Writes the position each branch in scene_segment_branches leads to]
+ */
+void SceneGraphBuilder::resolveBranches() {
+
+    std::vector<std::pair<int, GraphPosition>> branches;
+
+    {
+        QueryCursor branchData(novel->prepare(
+                "SELECT id, scene_segment_id, next_label FROM scene_segment_branches ORDER BY id;"));
+
+        while (branchData.next()) {
+            std::string owner = "a branch of scene segment " + std::to_string(branchData.getInteger(1));
+            branches.emplace_back(branchData.getInteger(0), findLabel(branchData.getString(2), owner));
+        }
+    }
+
+    PreparedStatement *update = novel->prepare(
+            "UPDATE scene_segment_branches SET chapter_index = ?, scene_index = ?, scene_segment_index = ? WHERE id = ?;");
+
+    for (auto &branch : branches) {
+        update->bind(1, branch.second.chapter)->bind(2, branch.second.scene)->bind(3, branch.second.sceneSegment)
+              ->bind(4, branch.first)->execute();
+    }
+}
+
+void SceneGraphBuilder::readChapters() {
+
+    QueryCursor chapterData(novel->prepare("SELECT id, title, label, next_label FROM chapters ORDER BY id;"));
+
+    while (chapterData.next()) {
+        GraphChapter chapter;
+        chapter.id = chapterData.getInteger(0);
+        chapter.title = chapterData.getString(1);
+        chapter.label = chapterData.getString(2);
+        chapter.nextLabel = chapterData.getString(3);
+
+        chapters.push_back(chapter);
+    }
+}
+
+/**
+ * [SceneGraphBuilder::readScenes Reads the scenes of every chapter, in the order the runner loads them]
+ */
+void SceneGraphBuilder::readScenes() {
+
+    std::unordered_map<int, size_t> chapterIndex;
+
+    for (size_t i = 0; i < chapters.size(); i++) {
+        chapterIndex[chapters[i].id] = i;
+    }
+
+    QueryCursor sceneData(novel->prepare("SELECT id, chapter_id, label, next_label FROM scenes ORDER BY chapter_id, id;"));
+
+    while (sceneData.next()) {
+
+        auto chapter = chapterIndex.find(sceneData.getInteger(1));
+
+        if (chapter == chapterIndex.end()) {
+            continue;
+        }
+
+        GraphScene scene;
+        scene.id = sceneData.getInteger(0);
+        scene.label = sceneData.getString(2);
+        scene.nextLabel = sceneData.getString(3);
+
+        chapters[chapter->second].scenes.push_back(scene);
+    }
+}
+
+/**
+ * [SceneGraphBuilder::readSceneSegments Reads the segments of every scene, in the order the runner loads them]
+ */
+void SceneGraphBuilder::readSceneSegments() {
+
+    std::unordered_map<int, GraphScene *> scenesById;
+
+    for (auto &chapter : chapters) {
+        for (auto &scene : chapter.scenes) {
+            scenesById[scene.id] = &scene;
+        }
+    }
+
+    QueryCursor segmentData(novel->prepare(
+            "SELECT id, scene_id, label, next_label FROM scene_segments ORDER BY scene_id, id;"));
+
+    while (segmentData.next()) {
+
+        auto scene = scenesById.find(segmentData.getInteger(1));
+
+        if (scene == scenesById.end()) {
+            continue;
+        }
+
+        GraphSceneSegment sceneSegment;
+        sceneSegment.id = segmentData.getInteger(0);
+        sceneSegment.label = segmentData.getString(2);
+        sceneSegment.nextLabel = segmentData.getString(3);
+
+        scene->second->sceneSegments.push_back(sceneSegment);
+    }
+}
+
+/**
+ * [SceneGraphBuilder::addLabel Records where a label leads to, labels are shared by the whole project]
+ * @param label    [The label]
+ * @param position [The segment the label leads to]
+ * @param owner    [Description of what has the label, used in error messages]
+ */
+void SceneGraphBuilder::addLabel(const std::string &label, GraphPosition position, const std::string &owner) {
+
+    if (labels.count(label)) {
+        std::vector<std::string> error = {
+                "The label '", label, "' on ", owner, " has already been used, labels must be unique within the project"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    labels[label] = position;
+}
+
+/**
+ * [SceneGraphBuilder::findLabel Finds the segment a 'next' attribute jumps to]
+ * @param  label [The label named by 'next']
+ * @param  owner [Description of what has the 'next' attribute, used in error messages]
+ * @return       [The segment]
+ */
+SceneGraphBuilder::GraphPosition SceneGraphBuilder::findLabel(const std::string &label, const std::string &owner) {
+
+    auto position = labels.find(label);
+
+    if (position == labels.end()) {
+        std::vector<std::string> error = {
+                "The 'next' attribute of ", owner, " refers to the label '", label, "', which does not exist"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    return position->second;
+}
+
+/**
+ * [SceneGraphBuilder::findFallThrough Finds where the story goes after a segment without its own 'next' attribute.
+ * The end of a scene or chapter follows its 'next' attribute if it has one, and otherwise carries on to what follows it]
+ * @param  chapterIndex      [Index of the segment's chapter]
+ * @param  sceneIndex        [Index of the segment's scene within the chapter]
+ * @param  sceneSegmentIndex [Index of the segment within the scene]
+ * @return                   [The segment the story goes to, the chapter is -1 if the story ends]
+ */
+SceneGraphBuilder::GraphPosition SceneGraphBuilder::findFallThrough(int chapterIndex, int sceneIndex,
+                                                                    int sceneSegmentIndex) {
+
+    GraphChapter &chapter = chapters[chapterIndex];
+    GraphScene &scene = chapter.scenes[sceneIndex];
+
+    if (sceneSegmentIndex + 1 < static_cast<int>(scene.sceneSegments.size())) {
+        return {chapterIndex, sceneIndex, sceneSegmentIndex + 1};
+    }
+
+    if (!scene.nextLabel.empty()) {
+        return findLabel(scene.nextLabel, "scene " + std::to_string(scene.id));
+    }
+
+    if (sceneIndex + 1 < static_cast<int>(chapter.scenes.size())) {
+        return {chapterIndex, sceneIndex + 1, 0};
+    }
+
+    if (!chapter.nextLabel.empty()) {
+        return findLabel(chapter.nextLabel, "the chapter '" + chapter.title + "'");
+    }
+
+    for (int i = chapterIndex + 1; i < static_cast<int>(chapters.size()); i++) {
+        if (!chapters[i].scenes.empty()) {
+            return {i, 0, 0};
+        }
+    }
+
+    return {-1, -1, -1};
+}
@@ -0,0 +1,205 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include "Misc/Utils.hpp"
+#include "Database/QueryCursor.hpp"
+#include "GameCompiler/ScriptCompiler.hpp"
+#include "Exceptions/ProjectBuilderException.hpp"
+
+/**
+ * [ScriptCompiler::ScriptCompiler Prepares to compile the scripts of a project]
+ * @param resourceDb          [The resource database, which the scripts have been listed in]
+ * @param novelDb             [The novel database, which the characters have been written to]
+ * @param projectDirectory    [The working directory of the project]
+ * @param requirementCompiler [Knows the flags and counters scripts may refer to]
+ */
+ScriptCompiler::ScriptCompiler(DatabaseConnection *resourceDb, DatabaseConnection *novelDb,
+                               const std::string &projectDirectory, RequirementCompiler *requirementCompiler) {
+    resource = resourceDb;
+    novel = novelDb;
+    scriptDirectory = projectDirectory;
+    scriptDirectory.append("resource/Scripts/");
+    requirements = requirementCompiler;
+}
+
+ScriptCompiler::~ScriptCompiler() = default;
+
+/**
+ * [ScriptCompiler::process Compiles every enabled script]
+ */
+void ScriptCompiler::process() {
+
+    std::vector<std::tuple<int, std::string, std::string>> scripts;
+
+    // Read before anything is written, as the scripts table is updated as each script is compiled
+    {
+        QueryCursor scriptData(resource->prepare("SELECT id, name, filename FROM scripts WHERE enabled = 1 ORDER BY id;"));
+
+        while (scriptData.next()) {
+            scripts.emplace_back(scriptData.getInteger(0), scriptData.getString(1), scriptData.getString(2));
+        }
+    }
+
+    if (scripts.empty()) {
+        return;
+    }
+
+    std::cout << "Compiling scripts..." << std::endl;
+
+    for (auto &script : scripts) {
+        compile(std::get<0>(script), std::get<1>(script), std::get<2>(script));
+    }
+}
+
+/**
+ * [ScriptCompiler::checkSegmentScripts Checks that every scene segment which starts a script starts one which has been
+ * compiled. Called once every chapter has been written]
+ */
+void ScriptCompiler::checkSegmentScripts() {
+
+    QueryCursor segmentData(novel->prepare("SELECT scene_segment_id, script_name FROM scene_segment_scripts;"));
+
+    while (segmentData.next()) {
+        std::string name = segmentData.getString(1);
+
+        if (!scriptNames.count(name)) {
+            std::vector<std::string> error = {
+                    "Scene segment ", std::to_string(segmentData.getInteger(0)), " starts the script '", name,
+                    "', which is not an enabled script in Scripts.json"
+            };
+            throw ProjectBuilderException(Utils::implodeString(error));
+        }
+    }
+}
+
+/**
+ * [ScriptCompiler::compile Compiles a script and writes its bytecode to the resource database]
+ * @param scriptId [Id of the script in the scripts table]
+ * @param name     [Name of the script]
+ * @param fileName [File name of the script's source, within resource/Scripts/]
+ */
+void ScriptCompiler::compile(int scriptId, const std::string &name, const std::string &fileName) {
+
+    if (scriptNames.count(name)) {
+        std::vector<std::string> error = {"There is more than one script called '", name, "'"};
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    std::string sourceFileName = scriptDirectory + fileName;
+    std::ifstream sourceFile(sourceFileName);
+
+    if (!Utils::fileExists(sourceFileName) || !sourceFile) {
+        std::vector<std::string> error = {"Unable to read the script '", name, "' from ", sourceFileName};
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    std::stringstream source;
+    source << sourceFile.rdbuf();
+
+    ScriptParser parser(name, requirements);
+    CompiledScript script = parser.parse(source.str());
+
+    std::string id = std::to_string(scriptId);
+    std::vector<std::vector<std::string>> instructionRows;
+    std::vector<std::vector<std::string>> constantRows;
+    std::vector<std::vector<std::string>> operandRows;
+
+    // Instructions are stored as signed ints, as that is what SQLite reads back
+    for (auto &instruction : script.instructions) {
+        instructionRows.push_back({id, std::to_string(static_cast<int32_t>(instruction))});
+    }
+
+    for (auto &constant : script.constants) {
+        constantRows.push_back({id, std::to_string(constant)});
+    }
+
+    for (auto &operand : script.operands) {
+        operandRows.push_back({id, std::to_string(operand.kind), std::to_string(findOperandValue(operand, name)),
+                               operand.name});
+    }
+
+    if (!instructionRows.empty()) {
+        std::vector<std::string> columns = {"script_id", "instruction"};
+        std::vector<int> types = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER};
+        resource->insert("script_instructions", columns, instructionRows, types);
+    }
+
+    if (!constantRows.empty()) {
+        std::vector<std::string> columns = {"script_id", "value"};
+        std::vector<int> types = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER};
+        resource->insert("script_constants", columns, constantRows, types);
+    }
+
+    if (!operandRows.empty()) {
+        std::vector<std::string> columns = {"script_id", "kind", "value", "name"};
+        std::vector<int> types = {DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_NUMBER, DATA_TYPE_STRING};
+        resource->insert("script_operands", columns, operandRows, types);
+    }
+
+    resource->prepare("UPDATE scripts SET register_count = ? WHERE id = ?;")
+            ->bind(1, script.registerCount)
+            ->bind(2, scriptId)
+            ->execute();
+
+    scriptNames.insert(name);
+}
+
+/**
+ * [ScriptCompiler::findOperandValue Checks that something a script refers to by name exists]
+ * @param  operand [What the script refers to]
+ * @param  name    [Name of the script, used in error messages]
+ * @return         [The id of the character for a sprite, otherwise 0]
+ */
+int ScriptCompiler::findOperandValue(const CompiledScriptOperand &operand, const std::string &name) {
+
+    if (operand.kind == SCRIPT_OPERAND_SPRITE) {
+        std::vector<int> characterIds;
+
+        {
+            QueryCursor characterData(novel->prepare("SELECT id FROM characters WHERE first_name = ?;")
+                                              ->bind(1, operand.characterName));
+
+            while (characterData.next()) {
+                characterIds.push_back(characterData.getInteger(0));
+            }
+        }
+
+        if (characterIds.size() != 1) {
+            std::vector<std::string> error = {
+                    "The script '", name, "' shows a sprite of '", operand.characterName, "', but ",
+                    characterIds.empty() ? "no character has" : "more than one character has", " that first name"
+            };
+            throw ProjectBuilderException(Utils::implodeString(error));
+        }
+
+        QueryCursor spriteData(novel->prepare("SELECT id FROM character_sprites WHERE character_id = ? AND name = ?;")
+                                       ->bind(1, characterIds[0])
+                                       ->bind(2, operand.name));
+
+        if (!spriteData.next()) {
+            std::vector<std::string> error = {
+                    "The script '", name, "' shows the sprite '", operand.name, "' of '", operand.characterName,
+                    "', who has no sprite with that name"
+            };
+            throw ProjectBuilderException(Utils::implodeString(error));
+        }
+
+        return characterIds[0];
+    }
+
+    bool background = operand.kind == SCRIPT_OPERAND_BACKGROUND;
+    QueryCursor resourceData(resource->prepare(background ? "SELECT id FROM background_images WHERE name = ?;"
+                                                          : "SELECT id FROM music WHERE name = ?;")
+                                     ->bind(1, operand.name));
+
+    if (!resourceData.next()) {
+        std::vector<std::string> error = {
+                "The script '", name, "' uses the ", background ? "background image '" : "music track '",
+                operand.name, "', which is not listed in ", background ? "BackgroundImages.json" : "Music.json"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    return 0;
+}
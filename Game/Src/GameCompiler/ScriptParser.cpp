@@ -0,0 +1,728 @@
+#include <algorithm>
+#include <cctype>
+#include "Misc/Utils.hpp"
+#include "GameCompiler/ScriptParser.hpp"
+#include "Exceptions/ProjectBuilderException.hpp"
+
+/**
+ * [ScriptParser::ScriptParser Prepares to compile a script]
+ * @param name                [Name of the script, used in error messages]
+ * @param requirementCompiler [Knows the flags and counters the script may refer to]
+ */
+ScriptParser::ScriptParser(const std::string &name, RequirementCompiler *requirementCompiler) {
+    scriptName = name;
+    owner = "the script '" + name + "'";
+    requirements = requirementCompiler;
+    position = 0;
+    nextRegister = 0;
+    lastResult = -1;
+    script.registerCount = 0;
+}
+
+/**
+ * [ScriptParser::parse Compiles the source of the script. Throws a ProjectBuilderException giving the line of the first
+ * error found]
+ * @param  source [The source]
+ * @return        [The bytecode, and the constants and operands it refers to]
+ */
+CompiledScript ScriptParser::parse(const std::string &source) {
+
+    tokenize(source);
+
+    while (peek().type != TokenType::End) {
+        statement();
+    }
+
+    return script;
+}
+
+/**
+ * [ScriptParser::tokenize Splits the source into names, numbers, strings and symbols]
+ * @param source [The source]
+ */
+void ScriptParser::tokenize(const std::string &source) {
+
+    static const std::vector<std::string> symbols = {
+            "==", "!=", "<=", ">=", "+", "-", "*", "/", "%", "<", ">", "=", "(", ")", "{", "}", ","
+    };
+
+    size_t i = 0;
+    int line = 1;
+
+    while (i < source.size()) {
+        char character = source[i];
+
+        if (character == '\n') {
+            line++;
+            i++;
+            continue;
+        }
+
+        if (std::isspace(static_cast<unsigned char>(character))) {
+            i++;
+            continue;
+        }
+
+        if (source.compare(i, 2, "//") == 0) {
+            while (i < source.size() && source[i] != '\n') {
+                i++;
+            }
+            continue;
+        }
+
+        if (std::isdigit(static_cast<unsigned char>(character))) {
+            int64_t number = 0;
+            size_t start = i;
+
+            while (i < source.size() && std::isdigit(static_cast<unsigned char>(source[i]))) {
+                // One more than the largest int is allowed, as it may be negated
+                number = number * 10 + (source[i] - '0');
+
+                if (number > static_cast<int64_t>(INT32_MAX) + 1) {
+                    fail(line, "the number " + source.substr(start, i - start + 1) + "... is too large");
+                }
+
+                i++;
+            }
+
+            tokens.push_back({TokenType::Number, source.substr(start, i - start), number, line});
+            continue;
+        }
+
+        if (std::isalpha(static_cast<unsigned char>(character)) || character == '_') {
+            size_t start = i;
+
+            while (i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_')) {
+                i++;
+            }
+
+            tokens.push_back({TokenType::Identifier, source.substr(start, i - start), 0, line});
+            continue;
+        }
+
+        if (character == '"') {
+            size_t end = source.find_first_of("\"\n", i + 1);
+
+            if (end == std::string::npos || source[end] != '"') {
+                fail(line, "a string is missing its closing quotation mark");
+            }
+
+            tokens.push_back({TokenType::String, source.substr(i + 1, end - i - 1), 0, line});
+            i = end + 1;
+            continue;
+        }
+
+        bool matched = false;
+
+        for (auto &symbol : symbols) {
+            if (source.compare(i, symbol.size(), symbol) == 0) {
+                tokens.push_back({TokenType::Symbol, symbol, 0, line});
+                i += symbol.size();
+                matched = true;
+                break;
+            }
+        }
+
+        if (!matched) {
+            fail(line, std::string("'") + character + "' is not allowed here");
+        }
+    }
+
+    tokens.push_back({TokenType::End, "", 0, line});
+}
+
+const ScriptParser::Token &ScriptParser::peek() const {
+    return tokens[position];
+}
+
+const ScriptParser::Token &ScriptParser::next() {
+
+    const Token &token = tokens[position];
+
+    if (token.type != TokenType::End) {
+        position++;
+    }
+
+    return token;
+}
+
+/**
+ * [ScriptParser::accept Moves past the next token if it is the given keyword or symbol]
+ * @param  text [The keyword or symbol]
+ * @return      [Whether it was]
+ */
+bool ScriptParser::accept(const std::string &text) {
+
+    const Token &token = peek();
+
+    if ((token.type == TokenType::Identifier || token.type == TokenType::Symbol) && token.text == text) {
+        position++;
+        return true;
+    }
+
+    return false;
+}
+
+void ScriptParser::expect(const std::string &text) {
+
+    if (!accept(text)) {
+        const Token &token = peek();
+        fail(token.line, "expected '" + text + "' but found " +
+                         (token.type == TokenType::End ? "the end of the script" : "'" + token.text + "'"));
+    }
+}
+
+bool ScriptParser::isKeyword(const std::string &text) const {
+
+    static const std::vector<std::string> keywords = {
+            "var", "if", "else", "while", "yield", "stop", "and", "or", "not", "true", "false"
+    };
+
+    return std::find(keywords.begin(), keywords.end(), text) != keywords.end();
+}
+
+std::string ScriptParser::expectIdentifier() {
+
+    const Token &token = peek();
+
+    if (token.type != TokenType::Identifier || isKeyword(token.text)) {
+        fail(token.line, "expected a name but found '" + token.text + "'");
+    }
+
+    return next().text;
+}
+
+std::string ScriptParser::expectString() {
+
+    const Token &token = peek();
+
+    if (token.type != TokenType::String) {
+        fail(token.line, "expected a name in quotation marks but found '" + token.text + "'");
+    }
+
+    return next().text;
+}
+
+/**
+ * [ScriptParser::statement Compiles a single statement]
+ */
+void ScriptParser::statement() {
+
+    const Token &token = peek();
+    int line = token.line;
+    lastResult = -1;
+
+    if (accept("var")) {
+        std::string name = expectIdentifier();
+
+        if (variables.count(name)) {
+            fail(line, "the variable '" + name + "' has already been declared");
+        }
+
+        expect("=");
+
+        // The register the value is worked out in becomes the variable's, so it can't be used in its own value
+        int variable = allocateRegister();
+        int value = expression(variable);
+
+        if (value != variable) {
+            emit(SCRIPT_ENCODE_ABC(SCRIPT_OP_MOVE, variable, value, 0));
+        }
+
+        variables[name] = variable;
+        return;
+    }
+
+    if (accept("if")) {
+        int condition = expression(allocateRegister());
+        freeRegister();
+
+        int skip = emitJump(SCRIPT_OP_JMPIFNOT, condition);
+        block();
+
+        if (!accept("else")) {
+            patchJump(skip, static_cast<int>(script.instructions.size()));
+            return;
+        }
+
+        int end = emitJump(SCRIPT_OP_JMP, 0);
+        patchJump(skip, static_cast<int>(script.instructions.size()));
+
+        if (peek().text == "if" && peek().type == TokenType::Identifier) {
+            statement();
+        } else {
+            block();
+        }
+
+        patchJump(end, static_cast<int>(script.instructions.size()));
+        return;
+    }
+
+    if (accept("while")) {
+        int start = static_cast<int>(script.instructions.size());
+        int condition = expression(allocateRegister());
+        freeRegister();
+
+        int exit = emitJump(SCRIPT_OP_JMPIFNOT, condition);
+        block();
+
+        patchJump(emitJump(SCRIPT_OP_JMP, 0), start);
+        patchJump(exit, static_cast<int>(script.instructions.size()));
+        return;
+    }
+
+    if (accept("yield")) {
+        emit(SCRIPT_ENCODE_ABX(SCRIPT_OP_YIELD, 0, 0));
+        return;
+    }
+
+    if (accept("stop")) {
+        emit(SCRIPT_ENCODE_ABX(SCRIPT_OP_HALT, 0, 0));
+        return;
+    }
+
+    if (token.type == TokenType::Identifier && !isKeyword(token.text)) {
+        std::string name = next().text;
+
+        if (accept("(")) {
+            callStatement(name, line);
+            return;
+        }
+
+        auto variable = variables.find(name);
+
+        if (variable == variables.end()) {
+            fail(line, "the variable '" + name + "' has not been declared");
+        }
+
+        expect("=");
+
+        int temporary = allocateRegister();
+        int value = expression(temporary);
+        freeRegister();
+
+        // The value is written straight to the variable rather than being moved there
+        int last = static_cast<int>(script.instructions.size()) - 1;
+
+        if (value == temporary && lastResult == last && static_cast<int>(SCRIPT_DECODE_A(script.instructions[last])) == temporary) {
+            script.instructions[last] = (script.instructions[last] & ~0xFF00u) | (static_cast<uint32_t>(variable->second) << 8);
+        } else {
+            emit(SCRIPT_ENCODE_ABC(SCRIPT_OP_MOVE, variable->second, value, 0));
+        }
+
+        return;
+    }
+
+    fail(line, token.type == TokenType::End ? "the script ended in the middle of a statement"
+                                            : "expected a statement but found '" + token.text + "'");
+}
+
+void ScriptParser::block() {
+
+    expect("{");
+
+    while (!accept("}")) {
+        if (peek().type == TokenType::End) {
+            fail(peek().line, "a block is missing its closing '}'");
+        }
+
+        statement();
+    }
+}
+
+/**
+ * [ScriptParser::callStatement Compiles a call to one of the functions which act on the game, once its name and opening
+ * bracket have been read]
+ * @param function [Name of the function]
+ * @param line     [Line the call is on]
+ */
+void ScriptParser::callStatement(const std::string &function, int line) {
+
+    if (function == "background" || function == "music") {
+        bool background = function == "background";
+        std::string name = expectString();
+        expect(")");
+
+        int operand = addOperand(background ? SCRIPT_OPERAND_BACKGROUND : SCRIPT_OPERAND_MUSIC, name, "");
+        emit(SCRIPT_ENCODE_ABX(background ? SCRIPT_OP_BACKGROUND : SCRIPT_OP_MUSIC, 0, operand));
+        return;
+    }
+
+    if (function == "morph") {
+        int operand = addOperand(SCRIPT_OPERAND_BACKGROUND, expectString(), "");
+        expect(",");
+        int milliseconds = expression(allocateRegister());
+        expect(")");
+
+        emit(SCRIPT_ENCODE_ABX(SCRIPT_OP_MORPH, milliseconds, operand));
+        freeRegister();
+        return;
+    }
+
+    if (function == "fadeIn" || function == "fadeOut" || function == "clearSprite") {
+        int value = expression(allocateRegister());
+        expect(")");
+
+        int opcode = function == "fadeIn" ? SCRIPT_OP_FADEIN : (function == "fadeOut" ? SCRIPT_OP_FADEOUT
+                                                                                      : SCRIPT_OP_CLEARSPRITE);
+        emit(SCRIPT_ENCODE_ABX(opcode, value, 0));
+        freeRegister();
+        return;
+    }
+
+    if (function == "sprite") {
+        int slot = expression(allocateRegister());
+        expect(",");
+        std::string characterName = expectString();
+        expect(",");
+        std::string spriteName = expectString();
+        expect(")");
+
+        emit(SCRIPT_ENCODE_ABX(SCRIPT_OP_SPRITE, slot, addOperand(SCRIPT_OPERAND_SPRITE, spriteName, characterName)));
+        freeRegister();
+        return;
+    }
+
+    if (function == "stopMusic") {
+        expect(")");
+        emit(SCRIPT_ENCODE_ABX(SCRIPT_OP_STOPMUSIC, 0, 0));
+        return;
+    }
+
+    if (function == "setFlag" || function == "setCounter") {
+        bool counter = function == "setCounter";
+        int index = flagIndex(expectString(), counter);
+        expect(",");
+        int value = expression(allocateRegister());
+        expect(")");
+
+        emit(SCRIPT_ENCODE_ABX(counter ? SCRIPT_OP_SETCOUNTER : SCRIPT_OP_SETFLAG, value, index));
+        freeRegister();
+        return;
+    }
+
+    if (function == "flag" || function == "counter" || function == "transitioning") {
+        fail(line, "'" + function + "' only gives a value, so it can't be used as a statement");
+    }
+
+    fail(line, "there is no function called '" + function + "'");
+}
+
+/**
+ * [ScriptParser::expression Compiles an expression. Every level of expression works the same way, the value is
+ * worked out in the target register, unless it is already held in another register such as a variable's]
+ * @param  target [Register to use for the value, and the registers above it for the values it is worked out from]
+ * @return        [Register which holds the value]
+ */
+int ScriptParser::expression(int target) {
+    return orExpression(target);
+}
+
+int ScriptParser::orExpression(int target) {
+
+    int left = andExpression(target);
+
+    // Expressions can't change anything, so both sides are always worked out
+    while (accept("or")) {
+        int right = andExpression(allocateRegister());
+        emitResult(SCRIPT_ENCODE_ABC(SCRIPT_OP_OR, target, left, right));
+        freeRegister();
+        left = target;
+    }
+
+    return left;
+}
+
+int ScriptParser::andExpression(int target) {
+
+    int left = comparison(target);
+
+    while (accept("and")) {
+        int right = comparison(allocateRegister());
+        emitResult(SCRIPT_ENCODE_ABC(SCRIPT_OP_AND, target, left, right));
+        freeRegister();
+        left = target;
+    }
+
+    return left;
+}
+
+int ScriptParser::comparison(int target) {
+
+    int left = sum(target);
+    const Token &token = peek();
+
+    if (token.type != TokenType::Symbol) {
+        return left;
+    }
+
+    std::string symbol = token.text;
+
+    if (symbol != "==" && symbol != "!=" && symbol != "<" && symbol != "<=" && symbol != ">" && symbol != ">=") {
+        return left;
+    }
+
+    next();
+    int right = sum(allocateRegister());
+
+    // Greater than is less than with the sides swapped
+    if (symbol == "==" || symbol == "!=") {
+        emitResult(SCRIPT_ENCODE_ABC(symbol == "==" ? SCRIPT_OP_EQ : SCRIPT_OP_NE, target, left, right));
+    } else if (symbol == "<" || symbol == "<=") {
+        emitResult(SCRIPT_ENCODE_ABC(symbol == "<" ? SCRIPT_OP_LT : SCRIPT_OP_LE, target, left, right));
+    } else {
+        emitResult(SCRIPT_ENCODE_ABC(symbol == ">" ? SCRIPT_OP_LT : SCRIPT_OP_LE, target, right, left));
+    }
+
+    freeRegister();
+
+    return target;
+}
+
+int ScriptParser::sum(int target) {
+
+    int left = product(target);
+
+    while (peek().type == TokenType::Symbol && (peek().text == "+" || peek().text == "-")) {
+        int opcode = next().text == "+" ? SCRIPT_OP_ADD : SCRIPT_OP_SUB;
+        int right = product(allocateRegister());
+        emitResult(SCRIPT_ENCODE_ABC(opcode, target, left, right));
+        freeRegister();
+        left = target;
+    }
+
+    return left;
+}
+
+int ScriptParser::product(int target) {
+
+    int left = unary(target);
+
+    while (peek().type == TokenType::Symbol && (peek().text == "*" || peek().text == "/" || peek().text == "%")) {
+        std::string symbol = next().text;
+        int opcode = symbol == "*" ? SCRIPT_OP_MUL : (symbol == "/" ? SCRIPT_OP_DIV : SCRIPT_OP_MOD);
+        int right = unary(allocateRegister());
+        emitResult(SCRIPT_ENCODE_ABC(opcode, target, left, right));
+        freeRegister();
+        left = target;
+    }
+
+    return left;
+}
+
+int ScriptParser::unary(int target) {
+
+    if (accept("-")) {
+        // A negative number is loaded as it is, rather than being negated as the script runs
+        if (peek().type == TokenType::Number) {
+            loadNumber(target, -next().number);
+            return target;
+        }
+
+        int value = unary(target);
+        emitResult(SCRIPT_ENCODE_ABC(SCRIPT_OP_NEG, target, value, 0));
+        return target;
+    }
+
+    if (accept("not")) {
+        int value = unary(target);
+        emitResult(SCRIPT_ENCODE_ABC(SCRIPT_OP_NOT, target, value, 0));
+        return target;
+    }
+
+    return primary(target);
+}
+
+int ScriptParser::primary(int target) {
+
+    const Token &token = peek();
+    int line = token.line;
+
+    if (token.type == TokenType::Number) {
+        loadNumber(target, next().number);
+        return target;
+    }
+
+    if (accept("true") || accept("false")) {
+        loadNumber(target, tokens[position - 1].text == "true" ? 1 : 0);
+        return target;
+    }
+
+    if (accept("(")) {
+        int value = expression(target);
+        expect(")");
+        return value;
+    }
+
+    if (token.type == TokenType::Identifier && !isKeyword(token.text)) {
+        std::string name = next().text;
+
+        if (accept("(")) {
+            if (name == "flag" || name == "counter") {
+                int index = flagIndex(expectString(), name == "counter");
+                expect(")");
+                emitResult(SCRIPT_ENCODE_ABX(name == "counter" ? SCRIPT_OP_COUNTER : SCRIPT_OP_FLAG, target, index));
+                return target;
+            }
+
+            if (name == "transitioning") {
+                expect(")");
+                emitResult(SCRIPT_ENCODE_ABX(SCRIPT_OP_TRANSITIONING, target, 0));
+                return target;
+            }
+
+            fail(line, "'" + name + "' doesn't give a value, so it can't be used in an expression");
+        }
+
+        auto variable = variables.find(name);
+
+        if (variable == variables.end()) {
+            fail(line, "the variable '" + name + "' has not been declared");
+        }
+
+        return variable->second;
+    }
+
+    fail(line, token.type == TokenType::End ? "the script ended in the middle of an expression"
+                                            : "expected a value but found '" + token.text + "'");
+}
+
+int ScriptParser::allocateRegister() {
+
+    if (nextRegister >= SCRIPT_MAX_REGISTERS) {
+        fail(peek().line, "it needs more than " + std::to_string(SCRIPT_MAX_REGISTERS) +
+                          " variables and values at once");
+    }
+
+    script.registerCount = std::max(script.registerCount, nextRegister + 1);
+
+    return nextRegister++;
+}
+
+void ScriptParser::freeRegister() {
+    nextRegister--;
+}
+
+int ScriptParser::emit(uint32_t instruction) {
+    script.instructions.push_back(instruction);
+    return static_cast<int>(script.instructions.size()) - 1;
+}
+
+/**
+ * [ScriptParser::emitResult Adds an instruction which writes the value of an expression]
+ * @param  instruction [The instruction]
+ * @return             [Its index]
+ */
+int ScriptParser::emitResult(uint32_t instruction) {
+    lastResult = emit(instruction);
+    return lastResult;
+}
+
+/**
+ * [ScriptParser::emitJump Adds a jump, which goes nowhere until it is patched]
+ * @param  opcode [The kind of jump]
+ * @param  reg    [Register the jump tests, if it is conditional]
+ * @return        [Index of the jump]
+ */
+int ScriptParser::emitJump(int opcode, int reg) {
+    return emit(SCRIPT_ENCODE_ABX(opcode, reg, 0));
+}
+
+void ScriptParser::patchJump(int jump, int target) {
+
+    int offset = target - (jump + 1);
+
+    if (offset < INT16_MIN || offset > INT16_MAX) {
+        fail(peek().line, "a block is too long to jump over");
+    }
+
+    script.instructions[jump] = (script.instructions[jump] & 0xFFFFu) | ((static_cast<uint32_t>(offset) & 0xFFFFu) << 16);
+}
+
+/**
+ * [ScriptParser::loadNumber Loads a number into a register, from the instruction itself if it is small enough]
+ * @param target [The register]
+ * @param value  [The number]
+ */
+void ScriptParser::loadNumber(int target, int64_t value) {
+
+    if (value > INT32_MAX || value < INT32_MIN) {
+        fail(tokens[position - 1].line, "the number " + std::to_string(value) + " is too large");
+    }
+
+    if (value >= INT16_MIN && value <= INT16_MAX) {
+        emitResult(SCRIPT_ENCODE_ABX(SCRIPT_OP_LOADI, target, value));
+        return;
+    }
+
+    auto constant = constantIndices.find(static_cast<int32_t>(value));
+    int index;
+
+    if (constant != constantIndices.end()) {
+        index = constant->second;
+    } else {
+        index = static_cast<int>(script.constants.size());
+
+        if (index > SCRIPT_MAX_OPERAND) {
+            fail(tokens[position - 1].line, "it has too many large numbers");
+        }
+
+        script.constants.push_back(static_cast<int32_t>(value));
+        constantIndices[static_cast<int32_t>(value)] = index;
+    }
+
+    emitResult(SCRIPT_ENCODE_ABX(SCRIPT_OP_LOADK, target, index));
+}
+
+/**
+ * [ScriptParser::addOperand Finds the index of something the script refers to by name, adding it the first time]
+ * @param  kind          [What the name is of]
+ * @param  name          [The name]
+ * @param  characterName [First name of the character, sprites only]
+ * @return               [Index of the operand]
+ */
+int ScriptParser::addOperand(int kind, const std::string &name, const std::string &characterName) {
+
+    std::string key = std::to_string(kind) + '\n' + characterName + '\n' + name;
+    auto operand = operandIndices.find(key);
+
+    if (operand != operandIndices.end()) {
+        return operand->second;
+    }
+
+    int index = static_cast<int>(script.operands.size());
+
+    if (index > SCRIPT_MAX_OPERAND) {
+        fail(tokens[position - 1].line, "it refers to too many backgrounds, sprites and music tracks");
+    }
+
+    script.operands.push_back({kind, name, characterName});
+    operandIndices[key] = index;
+
+    return index;
+}
+
+int ScriptParser::flagIndex(const std::string &name, bool counter) {
+
+    int index = requirements->getFlagIndex(name, counter, owner);
+
+    if (index > SCRIPT_MAX_OPERAND) {
+        fail(tokens[position - 1].line, "the " + std::string(counter ? "counter '" : "flag '") + name +
+                                        "' can't be used by a script, as too many are declared before it");
+    }
+
+    return index;
+}
+
+/**
+ * [ScriptParser::fail Throws a ProjectBuilderException for an error in the script]
+ * @param line    [Line the error is on]
+ * @param message [What is wrong]
+ */
+void ScriptParser::fail(int line, const std::string &message) const {
+
+    std::vector<std::string> error = {
+            "The script '", scriptName, "' can't be compiled, line ", std::to_string(line), ": ", message
+    };
+    throw ProjectBuilderException(Utils::implodeString(error));
+}
@@ -0,0 +1,320 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include "Misc/Utils.hpp"
+#include "Database/QueryCursor.hpp"
+#include "GameCompiler/StringPackBuilder.hpp"
+#include "Exceptions/ProjectBuilderException.hpp"
+
+/**
+ * [StringPackBuilder::StringPackBuilder Prepares to write the string packs of a novel]
+ * @param novelDb          [The compiled novel database, everything in it must already be committed]
+ * @param fileHandler      [Reads the translations]
+ * @param projectDirectory [The working directory of the project, which the translations are read from]
+ */
+StringPackBuilder::StringPackBuilder(DatabaseConnection *novelDb, JsonHandler *fileHandler,
+                                     const std::string &projectDirectory) {
+    novel = novelDb;
+    fHandler = fileHandler;
+    localeDirectory = projectDirectory;
+    localeDirectory.append("Locales/");
+}
+
+StringPackBuilder::~StringPackBuilder() = default;
+
+/**
+ * [StringPackBuilder::write Writes the pack of every locale, replacing any previous packs. Nothing is written if the
+ * novel has no locales]
+ * @param directory [Directory the packs are written to]
+ */
+void StringPackBuilder::write(const std::string &directory) {
+
+    std::vector<std::string> locales;
+
+    {
+        QueryCursor localeData(novel->prepare("SELECT name FROM locales ORDER BY id;"));
+
+        while (localeData.next()) {
+            locales.push_back(localeData.getString(0));
+        }
+    }
+
+    if (locales.empty()) {
+        return;
+    }
+
+    std::cout << "Writing string packs..." << std::endl;
+
+    readSource();
+
+    std::error_code directoryError;
+    std::filesystem::create_directories(directory, directoryError);
+
+    for (size_t i = 0; i < locales.size(); i++) {
+
+        // The first locale is the one the novel is written in, so it has nothing to translate
+        json translation;
+
+        if (i > 0) {
+            std::string translationFileName = localeDirectory + locales[i] + ".json";
+
+            if (Utils::fileExists(translationFileName)) {
+                translation = fHandler->parseJsonFile(translationFileName);
+            } else {
+                std::cout << "No translation was found at " << translationFileName << ", the novel's own text is used for '"
+                          << locales[i] << "'" << std::endl;
+                translation = json::object();
+            }
+        }
+
+        json missing = json::object();
+        writePack(directory + locales[i] + STRING_PACK_EXTENSION, locales[i], translation, missing);
+
+        std::string missingFileName = directory + locales[i] + ".missing.json";
+        std::remove(missingFileName.c_str());
+
+        if (missing.empty()) {
+            continue;
+        }
+
+        size_t missingCount = 0;
+
+        for (auto &section : missing) {
+            missingCount += section.size();
+        }
+
+        std::ofstream missingFile(missingFileName, std::ios::trunc);
+        missingFile << missing.dump(4) << std::endl;
+
+        std::cout << "Warning: " << missingCount << " strings have not been translated into '" << locales[i]
+                  << "', they are listed in " << missingFileName << std::endl;
+    }
+}
+
+/**
+ * [StringPackBuilder::readSource Reads the text the novel is written in, and checks that lines which share a key
+ * share their text]
+ */
+void StringPackBuilder::readSource() {
+
+    std::unordered_map<std::string, int> lineIdByKey;
+
+    QueryCursor lineData(novel->prepare(
+            "SELECT id, string_key, text, spoken, override_character_name FROM segment_lines ORDER BY id;"));
+
+    while (lineData.next()) {
+        int id = lineData.getInteger(0);
+
+        SourceLine line;
+        line.key = lineData.getString(1);
+        line.text = lineData.getString(2);
+        line.spoken = lineData.getBoolean(3);
+        line.characterName = lineData.getString(4);
+
+        // Spoken lines are stored within quotation marks, which translations have added to them when they are written
+        if (line.spoken && line.text.size() >= 2) {
+            line.text = line.text.substr(1, line.text.size() - 2);
+        }
+
+        auto existing = lineIdByKey.find(line.key);
+
+        if (existing != lineIdByKey.end() && lines[existing->second].text != line.text) {
+            std::vector<std::string> error = {
+                    "The lineId '", line.key, "' is given to lines with different text: '", lines[existing->second].text,
+                    "' and '", line.text, "'"
+            };
+            throw ProjectBuilderException(Utils::implodeString(error));
+        }
+
+        lineIdByKey[line.key] = id;
+
+        if (id >= static_cast<int>(lines.size())) {
+            lines.resize(id + 1);
+        }
+
+        lines[id] = line;
+    }
+
+    QueryCursor characterData(novel->prepare("SELECT id, first_name FROM characters ORDER BY id;"));
+
+    while (characterData.next()) {
+        int id = characterData.getInteger(0);
+
+        if (id >= static_cast<int>(characterNames.size())) {
+            characterNames.resize(id + 1);
+        }
+
+        characterNames[id] = characterData.getString(1);
+    }
+
+    QueryCursor chapterData(novel->prepare("SELECT id, title FROM chapters ORDER BY id;"));
+
+    while (chapterData.next()) {
+        int id = chapterData.getInteger(0);
+
+        if (id >= static_cast<int>(chapterTitles.size())) {
+            chapterTitles.resize(id + 1);
+        }
+
+        chapterTitles[id] = chapterData.getString(1);
+    }
+}
+
+/**
+ * [StringPackBuilder::writePack Writes the pack of one locale]
+ * @param path        [Path of the pack]
+ * @param locale      [Name of the locale]
+ * @param translation [The locale's translation, null for the locale the novel is written in]
+ * @param missing     [Every string without a translation is added to this, by section and key]
+ */
+void StringPackBuilder::writePack(const std::string &path, const std::string &locale, const json &translation,
+                                  json &missing) {
+
+    std::vector<StringPackString> lineTexts;
+    std::vector<StringPackString> lineCharacterNames;
+    std::vector<StringPackString> packCharacterNames;
+    std::vector<StringPackString> packChapterTitles;
+    std::string strings;
+    std::unordered_map<std::string, StringPackString> stringIndex;
+
+    auto addString = [&strings, &stringIndex](const std::string &value) {
+        auto existing = stringIndex.find(value);
+
+        if (existing != stringIndex.end()) {
+            return existing->second;
+        }
+
+        StringPackString packString = {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(value.size())};
+
+        strings.append(value);
+        stringIndex[value] = packString;
+
+        return packString;
+    };
+
+    auto translate = [&translation, &missing, &locale](const char *section, const std::string &key,
+                                                       const std::string &source) {
+        if (translation.is_null() || source.empty()) {
+            return source;
+        }
+
+        auto translatedSection = translation.find(section);
+
+        if (translatedSection != translation.end() && translatedSection->is_object()) {
+            auto translated = translatedSection->find(key);
+
+            if (translated != translatedSection->end()) {
+                if (!translated->is_string()) {
+                    std::vector<std::string> error = {
+                            "The translation of '", key, "' in the '", section, "' of Locales/", locale,
+                            ".json must be a string"
+                    };
+                    throw ProjectBuilderException(Utils::implodeString(error));
+                }
+
+                return translated->get<std::string>();
+            }
+        }
+
+        missing[section][key] = source;
+
+        return source;
+    };
+
+    for (auto &line : lines) {
+        std::string text = translate("lines", line.key, line.text);
+
+        if (line.spoken) {
+            text = "\"" + text + "\"";
+        }
+
+        lineTexts.push_back(addString(text));
+        lineCharacterNames.push_back(addString(translate("characters", line.characterName, line.characterName)));
+    }
+
+    for (auto &characterName : characterNames) {
+        packCharacterNames.push_back(addString(translate("characters", characterName, characterName)));
+    }
+
+    for (auto &chapterTitle : chapterTitles) {
+        packChapterTitles.push_back(addString(translate("chapters", chapterTitle, chapterTitle)));
+    }
+
+    StringPackHeader header = {};
+    std::memcpy(header.magic, STRING_PACK_MAGIC, STRING_PACK_MAGIC_LENGTH);
+    std::strncpy(header.locale, locale.c_str(), STRING_PACK_LOCALE_LENGTH - 1);
+    header.version = STRING_PACK_VERSION;
+    header.byteOrderMark = STRING_PACK_BYTE_ORDER_MARK;
+    header.headerSize = sizeof(StringPackHeader);
+
+    // Tables are laid out one after another, each starting on an aligned offset
+    uint64_t fileSize = sizeof(StringPackHeader);
+
+    auto placeTable = [&fileSize](StringPackTable &table, size_t count, size_t recordSize) {
+        fileSize = (fileSize + STRING_PACK_TABLE_ALIGNMENT - 1) / STRING_PACK_TABLE_ALIGNMENT * STRING_PACK_TABLE_ALIGNMENT;
+        table.offset = static_cast<uint32_t>(fileSize);
+        table.count = static_cast<uint32_t>(count);
+        fileSize += static_cast<uint64_t>(count) * recordSize;
+    };
+
+    placeTable(header.lineTexts, lineTexts.size(), sizeof(StringPackString));
+    placeTable(header.lineCharacterNames, lineCharacterNames.size(), sizeof(StringPackString));
+    placeTable(header.characterNames, packCharacterNames.size(), sizeof(StringPackString));
+    placeTable(header.chapterTitles, packChapterTitles.size(), sizeof(StringPackString));
+    placeTable(header.strings, strings.size(), 1);
+
+    if (fileSize > UINT32_MAX) {
+        std::vector<std::string> error = {"The text of the locale '", locale, "' is too large to be written to a string pack"};
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    header.fileSize = static_cast<uint32_t>(fileSize);
+
+    // Written to a temporary file first so that a failed compile never leaves half of a pack behind
+    std::string temporaryPath = path + ".tmp";
+    std::ofstream pack(temporaryPath, std::ios::binary | std::ios::trunc);
+
+    if (!pack.is_open()) {
+        std::vector<std::string> error = {
+                "Unable to open '", temporaryPath, "' to write the string pack"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    auto writeTable = [&pack](const StringPackTable &table, const void *records, size_t length) {
+        while (static_cast<uint64_t>(pack.tellp()) < table.offset) {
+            pack.put('\0');
+        }
+
+        if (length) {
+            pack.write(static_cast<const char *>(records), static_cast<std::streamsize>(length));
+        }
+    };
+
+    pack.write(reinterpret_cast<const char *>(&header), sizeof(StringPackHeader));
+    writeTable(header.lineTexts, lineTexts.data(), lineTexts.size() * sizeof(StringPackString));
+    writeTable(header.lineCharacterNames, lineCharacterNames.data(), lineCharacterNames.size() * sizeof(StringPackString));
+    writeTable(header.characterNames, packCharacterNames.data(), packCharacterNames.size() * sizeof(StringPackString));
+    writeTable(header.chapterTitles, packChapterTitles.data(), packChapterTitles.size() * sizeof(StringPackString));
+    writeTable(header.strings, strings.data(), strings.size());
+
+    pack.close();
+
+    if (pack.fail()) {
+        std::vector<std::string> error = {
+                "Unable to write the string pack to '", temporaryPath, "'"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+
+    std::remove(path.c_str());
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::vector<std::string> error = {
+                "Unable to move the string pack from '", temporaryPath, "' to '", path, "'"
+        };
+        throw ProjectBuilderException(Utils::implodeString(error));
+    }
+}
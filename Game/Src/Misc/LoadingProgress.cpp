@@ -0,0 +1,57 @@
+#include "Misc/LoadingProgress.hpp"
+
+LoadingProgress::LoadingProgress() {
+    totalSteps = 0;
+    completedSteps = 0;
+    startTime = std::chrono::steady_clock::now();
+}
+
+/**
+ * [LoadingProgress::addSteps Adds to the number of steps that the load will take]
+ * @param count [Number of steps]
+ */
+void LoadingProgress::addSteps(int count) {
+    totalSteps += count;
+}
+
+/**
+ * [LoadingProgress::beginStep Sets the description shown while a step is carried out]
+ * @param stepDescription [What is being loaded]
+ */
+void LoadingProgress::beginStep(const std::string &stepDescription) {
+    std::lock_guard<std::mutex> lock(descriptionMutex);
+    description = stepDescription;
+}
+
+void LoadingProgress::completeStep() {
+    completedSteps++;
+}
+
+/**
+ * [LoadingProgress::getFraction Returns how much of the load has been completed]
+ * @return [Between 0 and 1]
+ */
+float LoadingProgress::getFraction() {
+    int total = totalSteps;
+
+    if (total == 0) {
+        return 0;
+    }
+
+    int completed = completedSteps;
+
+    return completed >= total ? 1.0f : static_cast<float>(completed) / static_cast<float>(total);
+}
+
+std::string LoadingProgress::getDescription() {
+    std::lock_guard<std::mutex> lock(descriptionMutex);
+    return description;
+}
+
+/**
+ * [LoadingProgress::getElapsedMilliseconds Returns the time since the progress was created]
+ * @return [Milliseconds]
+ */
+long long LoadingProgress::getElapsedMilliseconds() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
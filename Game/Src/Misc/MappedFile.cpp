@@ -0,0 +1,114 @@
+#include <vector>
+#include "Misc/Utils.hpp"
+#include "Misc/MappedFile.hpp"
+#include <Exceptions/ResourceException.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * [MappedFile::MappedFile Maps a file into memory, throwing a ResourceException if it can't be mapped or is empty]
+ * @param path [Path of the file]
+ */
+MappedFile::MappedFile(const std::string &path) {
+    filePath = path;
+    data = nullptr;
+    size = 0;
+
+    std::vector<std::string> error = {
+            "Unable to map '", filePath, "' into memory"
+    };
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr);
+    mappingHandle = nullptr;
+
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        fileHandle = nullptr;
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        unmap();
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    size = static_cast<size_t>(fileSize.QuadPart);
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mappingHandle) {
+        data = static_cast<const char *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+
+    if (!data) {
+        unmap();
+        throw ResourceException(Utils::implodeString(error));
+    }
+#else
+    int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+
+    if (fileDescriptor == -1) {
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    struct stat fileStatus = {};
+
+    if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0) {
+        close(fileDescriptor);
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    size = static_cast<size_t>(fileStatus.st_size);
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+    // The mapping keeps the file open on its own
+    close(fileDescriptor);
+
+    if (mapping == MAP_FAILED) {
+        size = 0;
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    data = static_cast<const char *>(mapping);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+void MappedFile::unmap() {
+
+#ifdef _WIN32
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+    }
+
+    if (fileHandle) {
+        CloseHandle(fileHandle);
+    }
+
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    if (data) {
+        munmap(const_cast<char *>(data), size);
+    }
+#endif
+
+    data = nullptr;
+    size = 0;
+}
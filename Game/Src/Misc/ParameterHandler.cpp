@@ -1,7 +1,23 @@
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include "Misc/ParameterHandler.hpp"
 #include "Misc/ProjectInfo.hpp"
 #include "Misc/Utils.hpp"
+#include "Database/QueryProfiler.hpp"
+#include "Database/DatabaseConnectionProfile.hpp"
+#include "Config/ConfigHandler.hpp"
+#include "Database/DatabaseConnection.hpp"
+#include "VisualNovelEngine/Classes/Data/Novel.hpp"
+#include "VisualNovelEngine/Classes/Data/ScriptMachine.hpp"
+#include "Exceptions/GeneralException.hpp"
+
+// Each thread count is timed this many times, and the fastest is reported
+#define NOVEL_LOAD_BENCHMARK_RUNS 3
+
+// How many times the script benchmark goes around its loop, each time round runs 10 instructions
+#define SCRIPT_BENCHMARK_ITERATIONS 10000000
 
 ParameterHandler::ParameterHandler(int argc, char* argv[]) {
 
@@ -20,6 +36,40 @@ ParameterHandler::ParameterHandler(int argc, char* argv[]) {
       printVersionInformation();
     }
 
+    // Record every database query and write a report to query_profile.log on exit
+    if (parameter == "--profile-queries") {
+      QueryProfiler::getInstance()->enable(false);
+    }
+
+    // As above, but also include the query plan for each query in the report
+    if (parameter == "--explain-queries") {
+      QueryProfiler::getInstance()->enable(true);
+    }
+
+    // Overrides databaseMode from config.json, e.g. --database-mode=memory
+    if (parameter.rfind("--database-mode=", 0) == 0) {
+      std::string modeName = parameter.substr(std::string("--database-mode=").length());
+      DatabaseOpenMode mode;
+
+      if (!DatabaseConnectionProfile::parseMode(modeName, mode)) {
+        std::cout<<"Unknown database mode '"<<modeName<<"', expected readwrite, readonly or memory"<<std::endl;
+        shouldExitProgram = true;
+        return;
+      }
+
+      DatabaseConnectionProfile::overrideRuntimeMode(mode);
+    }
+
+    // Loads the novel with an increasing number of threads, reports how long each took and exits
+    if (parameter == "--benchmark-novel-load") {
+      benchmarkNovelLoad();
+    }
+
+    // Runs a script a frame's worth of instructions at a time, reports how many instructions a second were run and exits
+    if (parameter == "--benchmark-scripts") {
+      benchmarkScripts();
+    }
+
   }
 
 }
@@ -44,6 +94,159 @@ void ParameterHandler::printVersionInformation() {
   shouldExitProgram = true;
 }
 
+/**
+ * [ParameterHandler::benchmarkNovelLoad Times loading the whole novel on one thread, then on more threads up to one per
+ * core. The databases are opened as the game would open them, so config.json and --database-mode apply]
+ */
+void ParameterHandler::benchmarkNovelLoad() {
+
+  shouldExitProgram = true;
+
+  auto *configHandler = new ConfigHandler();
+  DatabaseConnectionProfile::setRuntimeProfile(configHandler->getConfig()->getDatabaseProfile());
+  delete(configHandler);
+
+  int coreCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  std::vector<int> threadCounts = {1};
+
+  for (int threadCount = 2; threadCount < coreCount; threadCount *= 2) {
+    threadCounts.push_back(threadCount);
+  }
+
+  if (coreCount > 1) {
+    threadCounts.push_back(coreCount);
+  }
+
+  std::cout<<"Loading the novel with up to "<<coreCount<<" threads, the database pool allows "<<
+  DatabaseConnectionProfile::getRuntimeProfile()->poolSize<<" connections ("<<
+  DatabaseConnectionProfile::getModeName(DatabaseConnectionProfile::getRuntimeProfile()->mode)<<")"<<std::endl;
+
+  double singleThreadMilliseconds = 0;
+
+  try {
+    for (int threadCount : threadCounts) {
+      double fastestMilliseconds = 0;
+
+      for (int run = 0; run < NOVEL_LOAD_BENCHMARK_RUNS; run++) {
+        auto startTime = std::chrono::steady_clock::now();
+        auto *novel = new NovelData(NovelResidency::Full, nullptr, threadCount);
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        delete(novel);
+
+        if (run == 0 || milliseconds < fastestMilliseconds) {
+          fastestMilliseconds = milliseconds;
+        }
+      }
+
+      if (threadCount == 1) {
+        singleThreadMilliseconds = fastestMilliseconds;
+      }
+
+      std::cout<<threadCount<<(threadCount == 1 ? " thread:  " : " threads: ")<<fastestMilliseconds<<"ms, "<<
+      (fastestMilliseconds > 0 ? singleThreadMilliseconds / fastestMilliseconds : 1.0)<<"x"<<std::endl;
+    }
+  } catch (GeneralException &e) {
+    std::cout<<"Unable to load the novel: "<<e.what()<<std::endl;
+  }
+}
+
+/**
+ * Gives the benchmark script flags to read and write, and ignores everything else it does
+ */
+class BenchmarkScriptHost : public ScriptHost {
+public:
+  BenchmarkScriptHost() : flags(1, 1) {
+  }
+  NovelFlags &getScriptFlags() override {
+    return flags;
+  }
+  void changeFlag(const NovelFlagChange &change) override {
+    flags.apply(change);
+  }
+  void showBackground(InternedString /*backgroundName*/) override {
+  }
+  void morphBackground(InternedString /*backgroundName*/, int /*milliseconds*/) override {
+  }
+  void fadeInBackground(int /*milliseconds*/) override {
+  }
+  void fadeOutBackground(int /*milliseconds*/) override {
+  }
+  bool isBackgroundTransitioning() override {
+    return false;
+  }
+  bool showSprite(int /*slot*/, CharacterSprite * /*characterSprite*/) override {
+    return true;
+  }
+  void playMusic(InternedString /*musicName*/) override {
+  }
+  void stopMusic() override {
+  }
+private:
+  NovelFlags flags;
+};
+
+/**
+ * [ParameterHandler::benchmarkScripts Times the script machine running a loop of arithmetic, comparisons, jumps and
+ * counter reads, given the same number of instructions per frame as the novel screen gives it]
+ */
+void ParameterHandler::benchmarkScripts() {
+
+  shouldExitProgram = true;
+
+  // var i = 0, var total = 0, while i < iterations { total = total + i * 3 % 7 + i + counter("c") i = i + 1 }
+  ScriptProgram program(InternedString("benchmark"), 8);
+  program.addConstant(SCRIPT_BENCHMARK_ITERATIONS);
+
+  std::vector<uint32_t> instructions = {
+    SCRIPT_ENCODE_ABX(SCRIPT_OP_LOADK, 1, 0),
+    SCRIPT_ENCODE_ABX(SCRIPT_OP_LOADI, 4, 3),
+    SCRIPT_ENCODE_ABX(SCRIPT_OP_LOADI, 5, 7),
+    SCRIPT_ENCODE_ABX(SCRIPT_OP_LOADI, 6, 1),
+    SCRIPT_ENCODE_ABC(SCRIPT_OP_LT, 3, 0, 1),
+    SCRIPT_ENCODE_ABX(SCRIPT_OP_JMPIFNOT, 3, 8),
+    SCRIPT_ENCODE_ABC(SCRIPT_OP_MUL, 3, 0, 4),
+    SCRIPT_ENCODE_ABC(SCRIPT_OP_MOD, 3, 3, 5),
+    SCRIPT_ENCODE_ABC(SCRIPT_OP_ADD, 2, 2, 3),
+    SCRIPT_ENCODE_ABC(SCRIPT_OP_ADD, 2, 2, 0),
+    SCRIPT_ENCODE_ABX(SCRIPT_OP_COUNTER, 7, 0),
+    SCRIPT_ENCODE_ABC(SCRIPT_OP_ADD, 2, 2, 7),
+    SCRIPT_ENCODE_ABC(SCRIPT_OP_ADD, 0, 0, 6),
+    SCRIPT_ENCODE_ABX(SCRIPT_OP_JMP, 0, -10),
+    SCRIPT_ENCODE_ABX(SCRIPT_OP_SETCOUNTER, 2, 0)
+  };
+
+  for (auto &instruction : instructions) {
+    program.addInstruction(instruction);
+  }
+
+  BenchmarkScriptHost host;
+
+  try {
+    program.validate(host.getScriptFlags());
+  } catch (GeneralException &e) {
+    std::cout<<"Unable to run the benchmark script: "<<e.what()<<std::endl;
+    return;
+  }
+
+  ScriptMachine machine;
+  machine.start(&program);
+  int frames = 0;
+
+  auto startTime = std::chrono::steady_clock::now();
+
+  while (machine.run(SCRIPT_INSTRUCTIONS_PER_FRAME, &host) == ScriptState::Running) {
+    frames++;
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  double instructionCount = static_cast<double>(machine.getExecutedCount());
+
+  std::cout<<"Ran "<<machine.getExecutedCount()<<" instructions over "<<frames + 1<<" frames of "<<
+  SCRIPT_INSTRUCTIONS_PER_FRAME<<" in "<<seconds * 1000<<"ms"<<std::endl;
+  std::cout<<(seconds > 0 ? instructionCount / seconds / 1000000 : 0)<<" million instructions per second, "<<
+  (instructionCount > 0 ? seconds * 1000000000 / instructionCount : 0)<<"ns per instruction"<<std::endl;
+}
+
 void ParameterHandler::printLicenceInformation() {
   std::string licenceInformation("\n\n");
 
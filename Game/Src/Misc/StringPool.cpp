@@ -0,0 +1,81 @@
+#include "Misc/StringPool.hpp"
+
+StringPool::StringPool() {
+    // The empty string is always id 0
+    auto *emptyEntry = new StringPoolEntry{0, std::string()};
+
+    entries.push_back(emptyEntry);
+    entriesByValue[emptyEntry->value] = emptyEntry;
+}
+
+StringPool::~StringPool() {
+    for (auto &entry : entries) {
+        delete entry;
+    }
+}
+
+StringPool *StringPool::getPool() {
+    static StringPool pool;
+    return &pool;
+}
+
+/**
+ * [StringPool::intern Returns the pooled copy of a string, adding it to the pool if it isn't already there]
+ * @param  value [The string]
+ * @return       [The entry, valid until the program exits]
+ */
+const StringPoolEntry *StringPool::intern(std::string_view value) {
+
+    StringPool *pool = getPool();
+    std::lock_guard<std::mutex> lock(pool->poolMutex);
+
+    auto existing = pool->entriesByValue.find(value);
+
+    if (existing != pool->entriesByValue.end()) {
+        return existing->second;
+    }
+
+    auto *entry = new StringPoolEntry{static_cast<uint32_t>(pool->entries.size()), std::string(value)};
+
+    // Keyed by a view of the entry's own copy, which never moves
+    pool->entries.push_back(entry);
+    pool->entriesByValue[entry->value] = entry;
+
+    return entry;
+}
+
+/**
+ * [StringPool::find Returns the pooled copy of a string without adding it]
+ * @param  value [The string]
+ * @return       [The entry, or nullptr if the string has not been interned]
+ */
+const StringPoolEntry *StringPool::find(std::string_view value) {
+
+    StringPool *pool = getPool();
+    std::lock_guard<std::mutex> lock(pool->poolMutex);
+
+    auto existing = pool->entriesByValue.find(value);
+
+    return existing != pool->entriesByValue.end() ? existing->second : nullptr;
+}
+
+/**
+ * [StringPool::get Returns the string with the given id]
+ * @param  id [The id of an interned string]
+ * @return    [The string]
+ */
+const std::string &StringPool::get(uint32_t id) {
+
+    StringPool *pool = getPool();
+    std::lock_guard<std::mutex> lock(pool->poolMutex);
+
+    return pool->entries.at(id)->value;
+}
+
+size_t StringPool::size() {
+
+    StringPool *pool = getPool();
+    std::lock_guard<std::mutex> lock(pool->poolMutex);
+
+    return pool->entries.size();
+}
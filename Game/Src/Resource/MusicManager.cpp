@@ -33,6 +33,14 @@ void MusicManager::playAudioStream(std::string name) {
 }
 
 void MusicManager::playAudioStream(std::string name, MusicPlaybackRequestMetadata* metadata) {
+    playAudioStream(InternedString::find(name), metadata);
+}
+
+void MusicManager::playAudioStream(InternedString name) {
+    playAudioStream(name, nullptr);
+}
+
+void MusicManager::playAudioStream(InternedString name, MusicPlaybackRequestMetadata* metadata) {
 
     int id = findAudioStream(name);
 
@@ -45,6 +53,39 @@ void MusicManager::playAudioStream(std::string name, MusicPlaybackRequestMetadat
     playRequestQueue.push(playRequest);
 }
 
+/**
+ * [MusicManager::stopAudioStreams Stops whichever stream is playing, along with any which are waiting to be played]
+ */
+void MusicManager::stopAudioStreams() {
+
+  playRequestQueue = std::queue<MusicPlayRequest>();
+
+  for (auto &stream : audioStream) {
+    if (stream->isPlaying()) {
+      stream->stop(true);
+    }
+  }
+}
+
+/**
+ * [MusicManager::getPlayingStreamName Returns the name of the stream that is playing, or is about to be]
+ * @return [The name, empty if nothing is playing]
+ */
+InternedString MusicManager::getPlayingStreamName() {
+
+  if (!playRequestQueue.empty()) {
+    return audioStream[playRequestQueue.back().getId()]->getName();
+  }
+
+  for (auto &stream : audioStream) {
+    if (stream->isPlaying()) {
+      return stream->getName();
+    }
+  }
+
+  return InternedString();
+}
+
 void MusicManager::playAudioStream(int id) {
   // TODO (I don't think this is needed, decide later when it isn't 2am.)
 }
@@ -114,6 +155,10 @@ AudioStream* MusicManager::getAudioStream(std::string name) {
 }
 
 int MusicManager::findAudioStream(std::string name) {
+  return findAudioStream(InternedString::find(name));
+}
+
+int MusicManager::findAudioStream(InternedString name) {
 
   for (int i = 0; i < audioStream.size(); i++) {
       if (audioStream[i]->getName() == name) {
@@ -1,5 +1,6 @@
 #include <SFML/Graphics.hpp>
 #include "Database/DatabaseConnection.hpp"
+#include "Database/DatabaseConnectionPool.hpp"
 #include "BackgroundRenderer/BackgroundImageRenderer.hpp"
 #include "Resource/ResourceManager.hpp"
 #include "Misc/Utils.hpp"
@@ -32,6 +33,8 @@ ResourceManager::~ResourceManager() {
   delete(textureManager);
   delete(musicManager);
   delete(fontManager);
+
+  DatabaseConnectionPool::getRuntimePool("resource")->release(resourceDatabase);
 }
 
 void ResourceManager::update() {
@@ -94,14 +97,42 @@ TextureManager* ResourceManager::getTextureManager() {
 
 /**
  * [loadResourcesFromDatabase Attempts to load all resource files which are linked in the database]
+ * @param progress [Where the progress of the load is reported, one step per type of resource. May be nullptr]
  */
-void ResourceManager::loadResourcesFromDatabase() {
+void ResourceManager::loadResourcesFromDatabase(LoadingProgress *progress) {
+
+  if (progress) {
+    progress->addSteps(4);
+    progress->beginStep("Reading textures");
+  }
 
   // Load all resources from the database
   textureManager->loadAllFromDatabase(resourceDatabase);
+
+  if (progress) {
+    progress->completeStep();
+    progress->beginStep("Reading music");
+  }
+
   musicManager->loadAllFromDatabase(resourceDatabase);
+
+  if (progress) {
+    progress->completeStep();
+    progress->beginStep("Reading fonts");
+  }
+
   fontManager->loadAllFromDatabase(resourceDatabase);
+
+  if (progress) {
+    progress->completeStep();
+    progress->beginStep("Reading backgrounds");
+  }
+
   backgroundImageRenderer->addAllFromDatabase(resourceDatabase);
+
+  if (progress) {
+    progress->completeStep();
+  }
 }
 
 void ResourceManager::openDatabase() {
@@ -112,5 +143,5 @@ void ResourceManager::openDatabase() {
     }
 
     // Connect to the resource database
-    resourceDatabase = new DatabaseConnection("resource");
-}
\ No newline at end of file
+    resourceDatabase = DatabaseConnectionPool::getRuntimePool("resource")->acquire();
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <iostream>
 #include "Database/DatabaseConnection.hpp"
+#include "Database/QueryCursor.hpp"
 #include "Resource/TextureManager.hpp"
 
 /**
@@ -85,6 +86,15 @@ void TextureManager::assignTexture(const std::string& fname, const std::string&
  * @return      [Texture ID if found, -1 if not found]
  */
 int TextureManager::findTexture(const std::string& name) {
+  return findTexture(InternedString::find(name));
+}
+
+/**
+ * [TextureManager::findTexture Returns the texture ID of the texture with the given name]
+ * @param  name [Interned name of the texture]
+ * @return      [Texture ID if found, -1 if not found]
+ */
+int TextureManager::findTexture(InternedString name) {
 
   for (int i = 0; i<MAX_TEXTURES; i++) {
     if (texture[i]) {
@@ -160,15 +170,11 @@ void TextureManager::loadAllFromDatabase(DatabaseConnection *resource) {
   For instance, for every chapter or scene, we can load or unload textures for character sprites as required if they appear in that scene/chapter or not.
   */
 
- auto *dataSet = new DataSet();
- resource->executeQuery("SELECT * FROM textures;", dataSet);
+  QueryCursor textures(resource->prepare("SELECT name, filename FROM textures;"));
 
- int numberOfTextures = dataSet->getRowCount();
-
- for (int i = 0; i < numberOfTextures; i++) {
-   std::string name = dataSet->getRow(i)->getColumn("name")->getRawData();
-   std::string fileName = "resource/textures/";
-   fileName.append(dataSet->getRow(i)->getColumn("filename")->getRawData());
-   loadTexture(fileName, name);
- }
+  while (textures.next()) {
+    std::string fileName = "resource/textures/";
+    fileName.append(textures.getText(1));
+    loadTexture(fileName, textures.getString(0));
+  }
 }
@@ -9,7 +9,7 @@ Sprite::Sprite(TextureManager *sTextureManager,sf::RenderWindow *window, const s
   mySprite = new sf::Sprite();
   displayWindow = window;
   name = sName;
-  textureName = stextureName;
+  textureName = InternedString(stextureName);
   priority = sPriority;
   textureManager = sTextureManager;
   textureId = -1;
@@ -23,7 +23,7 @@ Sprite::Sprite(TextureManager *sTextureManager, sf::RenderWindow *window, const
   textureManager = sTextureManager;
   displayWindow = window;
   name = sName;
-  textureName = "";
+  textureName = InternedString();
   textureId = -1;
   textureSet = false;
   visible = false;
@@ -47,6 +47,10 @@ bool Sprite::setImage(sf::Texture *image) {
 }
 
 void Sprite::setTextureName(std::string name, bool switchImmediately) {
+  setTextureName(InternedString(name), switchImmediately);
+}
+
+void Sprite::setTextureName(InternedString name, bool switchImmediately) {
   textureName = name;
   textureSet = false;
   textureId = -1;
@@ -79,7 +83,7 @@ void Sprite::update() {
 
     if (fetchedTextureId == -1) {
         std::vector<std::string> errorMessage = {
-                "Could not assign texture to sprite '", name, "': a texture with name '", textureName, "' could not be loaded"
+                "Could not assign texture to sprite '", name, "': a texture with name '", textureName.str(), "' could not be loaded"
         };
 
         throw ResourceException(Utils::implodeString(errorMessage));
@@ -93,7 +97,7 @@ void Sprite::update() {
 
   if (!texture) {
     std::vector<std::string> errorMessage = {
-        "Could not assign texture to sprite '", name, "': a texture with name '", textureName, "' could not be loaded"
+        "Could not assign texture to sprite '", name, "': a texture with name '", textureName.str(), "' could not be loaded"
     };
 
     throw ResourceException(Utils::implodeString(errorMessage));
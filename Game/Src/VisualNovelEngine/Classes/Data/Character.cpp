@@ -21,13 +21,7 @@ Character::Character(int cId, std::string cFirstName, std::string cSurname, std:
     // Load any character sprites related to this sprite from the database
     DataSet *dataSet = new DataSet();
 
-    std::vector<std::string> spriteQuery = {
-            "SELECT * FROM character_sprites WHERE character_id = ",
-            std::to_string(id),
-            ";"
-    };
-
-    novelDb->executeQuery(Utils::implodeString(spriteQuery, ""), dataSet);
+    novelDb->prepare("SELECT * FROM character_sprites WHERE character_id = ?;")->bind(1, id)->execute(dataSet);
 
     int spriteCount = dataSet->getRowCount();
 
@@ -55,6 +49,10 @@ CharacterSprite *Character::getSprite(int id) {
 }
 
 CharacterSprite *Character::getSprite(std::string name) {
+    return getSprite(InternedString::find(name));
+}
+
+CharacterSprite *Character::getSprite(InternedString name) {
 
     for (int i = 0; i < MAX_CHARACTER_SPRITES; i++) {
 
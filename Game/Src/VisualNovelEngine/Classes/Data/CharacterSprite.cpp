@@ -3,7 +3,7 @@
 #include "VisualNovelEngine/Classes/Data/CharacterSprite.hpp"
 
 CharacterSprite::CharacterSprite(std::string cName, int tId, int pCharacterId) {
-  name = cName;
+  name = InternedString(cName);
   characterId = pCharacterId;
   textureId = tId;
 }
@@ -16,7 +16,7 @@ void CharacterSprite::setSprite(int id) {
   spriteId = id;
 }
 
-std::string CharacterSprite::getName() {
+InternedString CharacterSprite::getName() {
   return name;
 }
 
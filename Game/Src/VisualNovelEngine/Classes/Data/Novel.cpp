@@ -1,18 +1,55 @@
 #include <iostream>
+#include <algorithm>
+#include <thread>
 #include "Misc/Utils.hpp"
 #include "Database/DatabaseConnection.hpp"
+#include "Database/QueryCursor.hpp"
+#include "Database/DatabaseConnectionPool.hpp"
 #include "VisualNovelEngine/Classes/Data/Novel.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelLoader.hpp"
 #include <sstream>
 #include <Exceptions/ResourceException.hpp>
 
-NovelData::NovelData() {
+NovelData::NovelData() : NovelData(NovelResidency::Full) {
+}
 
-    for (int i = 0; i < MAX_CHARACTERS; i++) {
-        character[i] = nullptr;
+/**
+ * [NovelData::NovelData Loads the novel]
+ * @param residencyMode [Whether the whole novel is loaded now, or scenes are loaded as they are reached]
+ * @param progress      [Where the progress of the load is reported, if anywhere]
+ * @param loaderThreads [Most threads a fully resident novel is read with, 0 for one per core. 1 reads every table
+ *                       with a single query on this thread]
+ * @param locale        [The locale to play the novel in, empty for the locale it is written in]
+ */
+NovelData::NovelData(NovelResidency residencyMode, LoadingProgress *progress, int loaderThreads,
+                     const std::string &locale) {
+    residency = residencyMode;
+    loaderThreadCount = loaderThreads > 0 ? loaderThreads : static_cast<int>(std::thread::hardware_concurrency());
+    loader = nullptr;
+    image = nullptr;
+    localeIndex = -1;
+    strings = nullptr;
+    imageChapterView = nullptr;
+    imageChapterViewIndex = -1;
+    imageSceneSegmentView = nullptr;
+    imageSceneSegmentViewIndex = -1;
+    imageSegmentLineView = nullptr;
+    imageCharacterStateGroupView = nullptr;
+    imageCharacterStateGroupViewIndex = NOVEL_IMAGE_NO_INDEX;
+    imageMusicPlaybackRequestView = nullptr;
+
+    for (int i = 0; i < 3; i++) {
+        imageSceneView[i] = nullptr;
+        imageSceneViewIndex[i] = -1;
     }
 
+    prefetchChapterIndex = -1;
+    prefetchSceneIndex = -1;
+    previousScene = nullptr;
+    previousChapterIndex = -1;
+    previousSceneIndex = -1;
     chapterCount = 0;
-    loadFromDatabase();
+    loadFromDatabase(progress, locale);
     start();
 }
 
@@ -32,177 +69,1097 @@ void NovelData::start(int cChapter, int cScene, int cSceneSegment, int cSceneSeg
     currentScene = cScene;
     currentSceneSegment = cSceneSegment;
     currentSceneSegmentLine = cSceneSegmentLine; // Game hasn't started yet, first line has id of 0
+    entrySceneSegment = 0;
+    previousScene = nullptr;
+    previousChapterIndex = -1;
+    previousSceneIndex = -1;
 
 }
 
+/**
+ * [NovelData::jumpTo Moves the story straight to a line, without going through any of the lines before it]
+ * @param  cChapter          [Index of the chapter]
+ * @param  cScene            [Index of the scene within the chapter]
+ * @param  cSceneSegment     [Index of the segment within the scene]
+ * @param  cSceneSegmentLine [Index of the line within the segment]
+ * @return                   [The line. If the novel has no such line, nothing is changed and a ResourceException is thrown]
+ */
+NovelSceneSegmentLine *NovelData::jumpTo(int cChapter, int cScene, int cSceneSegment, int cSceneSegmentLine) {
+
+    int originalChapter = currentChapter;
+    int originalScene = currentScene;
+    int originalSceneSegment = currentSceneSegment;
+    int originalSceneSegmentLine = currentSceneSegmentLine;
+    NovelScene *originalPreviousScene = previousScene;
+
+    NovelSceneSegmentLine *line = nullptr;
+
+    if (cChapter >= 0 && cChapter < chapterCount && cScene >= 0) {
+        start(cChapter, cScene, cSceneSegment, cSceneSegmentLine);
+
+        if (cScene < getCurrentChapter()->getSceneCount()) {
+            line = getCurrentLine();
+        }
+    }
+
+    if (!line) {
+        start(originalChapter, originalScene, originalSceneSegment, originalSceneSegmentLine);
+        previousScene = originalPreviousScene;
+
+        std::vector<std::string> error = {
+                "The novel has no line ", std::to_string(cSceneSegmentLine), " in segment ", std::to_string(cSceneSegment),
+                " of scene ", std::to_string(cScene), " of chapter ", std::to_string(cChapter)
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    updateSceneWindow();
+
+    return line;
+}
+
 /**
  * [getNextAction Returns the type of action that should be taken next]
  * @return [description]
  */
 AdvanceState NovelData::getNextAction() {
 
-    if (currentSceneSegmentLine == getCurrentSceneSegment()->getLineCount() - 1) {
+    NovelSceneSegment *segment = getCurrentSceneSegment();
+
+    if (currentSceneSegmentLine < segment->getLineCount() - 1) {
+        return AdvanceState::NextLine;
+    }
+
+    NovelJump jump = getJump(segment->getId());
+
+    if (jump.chapter < 0) {
+        return AdvanceState::StoryEnd;
+    }
+
+    // A jump to another segment of the same scene doesn't need a transition
+    if (jump.chapter == currentChapter && jump.scene == currentScene) {
+        return AdvanceState::SceneSegmentEnd;
+    }
+
+    return AdvanceState::SceneEnd;
+}
+
+NovelSceneSegment *NovelData::getCurrentSceneSegment() {
+
+    if (residency == NovelResidency::Image) {
+        NovelScene *scene = getCurrentScene();
+
+        if (!scene || currentSceneSegment < 0 || currentSceneSegment >= scene->getSegmentCount()) {
+            return nullptr;
+        }
+
+        int segmentIndex = static_cast<int>(image->getScene(getImageSceneIndex(currentChapter, currentScene)).firstSceneSegment) + currentSceneSegment;
+
+        // The view is only changed when the segment does, as the request it holds may still be playing
+        if (imageSceneSegmentViewIndex != segmentIndex) {
+            const NovelImageSceneSegment &record = image->getSceneSegment(segmentIndex);
+
+            imageSceneSegmentView->setFromImage(record, getImageMusicPlaybackRequest(record.musicPlaybackRequest));
+            imageSceneSegmentViewIndex = segmentIndex;
+        }
+
+        return imageSceneSegmentView;
+    }
+
+    return getCurrentScene()->getSceneSegment(currentSceneSegment);
+}
+
+NovelScene *NovelData::getCurrentScene() {
+
+    if (residency == NovelResidency::Image) {
+        return getImageScene(currentChapter, currentScene);
+    }
+
+    NovelChapter *currentChapterData = getCurrentChapter();
+
+    if (residency == NovelResidency::Windowed && currentScene >= 0 && !currentChapterData->getScene(currentScene)) {
+        makeSceneResident(currentChapter, currentScene);
+    }
+
+    return currentChapterData->getScene(currentScene);
+}
+
+NovelChapter *NovelData::getCurrentChapter() {
+
+    if (residency == NovelResidency::Image) {
+
+        if (imageChapterViewIndex != currentChapter) {
+            imageChapterView->setFromImage(image, image->getChapter(currentChapter));
+            imageChapterViewIndex = currentChapter;
+        }
+
+        return imageChapterView;
+    }
+
+    if (currentChapter < 0 || currentChapter >= static_cast<int>(chapter.size())) {
+        return nullptr;
+    }
+
+    return chapter[currentChapter];
+}
+
+/**
+ * [NovelData::getUpcomingScene Returns the scene the current segment leads to, waiting for it to finish loading if it is still being prefetched]
+ * @return [The scene, or nullptr at the end of the story]
+ */
+NovelScene *NovelData::getUpcomingScene() {
+
+    NovelJump jump = getJump(getCurrentSceneSegment()->getId());
+
+    if (jump.chapter < 0) {
+        return nullptr;
+    }
+
+    if (residency == NovelResidency::Image) {
+        return getImageScene(jump.chapter, jump.scene);
+    }
+
+    if (residency == NovelResidency::Windowed) {
+        makeSceneResident(jump.chapter, jump.scene);
+    }
+
+    return chapter[jump.chapter]->getScene(jump.scene);
+}
+
+void NovelData::loadFromDatabase(LoadingProgress *progress, const std::string &locale) {
+
+    if (!Utils::fileExists("db/novel")) {
+        throw GeneralException("Error: Unable to find novel database file");
+    }
+
+    if (progress) {
+        progress->addSteps(2);
+        progress->beginStep("Reading characters");
+    }
+
+    // Empty the character array
+    for (auto &loadedCharacter : character) {
+        delete loadedCharacter;
+    }
+
+    character.clear();
+
+    // Kept for as long as the novel exists, as scenes are read through it
+    novelDb = DatabaseConnectionPool::getRuntimePool("novel")->acquire();
+
+    // Load all of the characters, each row is used as soon as it has been read
+    QueryCursor characterData(novelDb->prepare("SELECT * FROM characters;"));
+
+    int idColumn = characterData.getColumnIndex("id");
+    int firstNameColumn = characterData.getColumnIndex("first_name");
+    int surnameColumn = characterData.getColumnIndex("surname");
+    int bioColumn = characterData.getColumnIndex("bio");
+    int ageColumn = characterData.getColumnIndex("age");
+    int showOnCharacterMenuColumn = characterData.getColumnIndex("showOnCharacterMenu");
+
+    while (characterData.next()) {
+
+        int id = idColumn != -1 ? characterData.getInteger(idColumn) : 0;
+        std::string firstName = firstNameColumn != -1 ? characterData.getString(firstNameColumn) : "";
+        std::string surname = surnameColumn != -1 ? characterData.getString(surnameColumn) : "";
+        std::string bio = bioColumn != -1 ? characterData.getString(bioColumn) : "";
+        std::string age = ageColumn != -1 ? characterData.getString(ageColumn) : "";
+        bool showOnCharacterMenu = false;
+
+        if (showOnCharacterMenuColumn != -1) {
+            std::string_view comparison = characterData.getText(showOnCharacterMenuColumn);
+            showOnCharacterMenu = (comparison == "TRUE" || comparison == "true");
+        }
+
+        character.push_back(new Character(id, firstName, surname, bio, age, showOnCharacterMenu, novelDb));
+    }
+
+    // Load project information from Database
+    projectInformation = new ProjectInformation(novelDb);
+
+    // Decides whether the text of the lines needs to be read along with the rest of the novel
+    loadLocales(locale);
+
+    loader = new NovelLoader(novelDb, &character);
+    loader->setLineTextLoaded(!strings);
+
+    // Small enough to be read from the database whichever way the rest of the novel is read
+    loadStoryFlags();
+
+    if (progress) {
+        progress->completeStep();
+        progress->beginStep("Reading the novel");
+    }
+
+    if (residency == NovelResidency::Image) {
+        try {
+            image = new NovelImage(NOVEL_IMAGE_PATH);
+        } catch (ResourceException &e) {
+            std::cout << "Unable to use the novel image, the novel database will be used instead: " << e.what() << std::endl;
+            residency = NovelResidency::Full;
+        }
+    }
+
+    if (image) {
+        // Only one of each is ever shown at once, except for scenes during a transition between them
+        imageChapterView = new NovelChapter("", 0);
+        imageSceneSegmentView = new NovelSceneSegment(0, "", nullptr);
+        imageSegmentLineView = new NovelSceneSegmentLine(0, 0, "", nullptr, "");
+        imageCharacterStateGroupView = new CharacterStateGroup(0);
+        imageMusicPlaybackRequestView = new MusicPlaybackRequest(0, "", nullptr);
+
+        for (auto &sceneView : imageSceneView) {
+            sceneView = new NovelScene();
+        }
+
+        // The loader is only kept to find the sprites of character states
+        chapterCount = static_cast<int>(image->getChapterCount());
+
+        if (progress) {
+            progress->completeStep();
+        }
+
+        return;
+    }
+
+    if (residency == NovelResidency::Windowed) {
+        // Scenes are loaded as they are reached, so the loader is kept
+        loader->loadChapterIndex();
+    } else if (loaderThreadCount > 1) {
+        // Each chapter is read and assembled on whichever thread is free, each thread has its own connection
+        loader->loadInParallel(DatabaseConnectionPool::getRuntimePool("novel"), loaderThreadCount, progress);
+        characterStateGroups.swap(loader->getCharacterStateGroups());
+    } else {
+        // The rest of the novel is read with one query per table and assembled in a single pass
+        loader->load(progress);
+        characterStateGroups.swap(loader->getCharacterStateGroups());
+    }
+
+    chapter = loader->getChapters();
+    chapterCount = static_cast<int>(chapter.size());
+    loader->loadJumps(jumps);
+
+    if (residency != NovelResidency::Windowed) {
+        delete loader;
+        loader = nullptr;
+    }
+
+    indexLines();
+
+    if (progress) {
+        progress->completeStep();
+    }
+}
+
+NovelData::~NovelData() {
+
+    // The prefetch thread must not be left using the loader
+    try {
+        finishPrefetch();
+    } catch (GeneralException &e) {
+        std::cout << "Error while prefetching a scene: " << e.what() << std::endl;
+    }
+
+    delete loader;
+    DatabaseConnectionPool::getRuntimePool("novel")->release(novelDb);
+
+    delete imageChapterView;
+    delete imageSceneSegmentView;
+    delete imageSegmentLineView;
+
+    for (auto &sceneView : imageSceneView) {
+        delete sceneView;
+    }
+
+    delete imageCharacterStateGroupView;
+    delete imageMusicPlaybackRequestView;
+
+    delete image;
+    delete strings;
+
+    for (auto &loadedChapter : chapter) {
+        delete loadedChapter;
+    }
+
+    // Lines only point to these, as several lines can share a group
+    for (auto &characterStateGroup : characterStateGroups) {
+        delete characterStateGroup;
+    }
+}
+
+/**
+ * [NovelData::makeSceneResident Ensures a scene is loaded, using the prefetched scene if it is the one being loaded]
+ * @param chapterIndex [Index of the chapter]
+ * @param sceneIndex   [Index of the scene within the chapter]
+ */
+void NovelData::makeSceneResident(int chapterIndex, int sceneIndex) {
+
+    finishPrefetch();
+
+    if (chapterIndex < 0 || chapterIndex >= chapterCount) {
+        return;
+    }
+
+    NovelChapter *sceneChapter = chapter[chapterIndex];
+
+    if (sceneIndex < 0 || sceneIndex >= sceneChapter->getSceneCount() || sceneChapter->getScene(sceneIndex)) {
+        return;
+    }
+
+    sceneChapter->setScene(sceneIndex, loader->loadScene(sceneChapter->getSceneId(sceneIndex)));
+    residentScenes.emplace_back(chapterIndex, sceneIndex);
+}
+
+/**
+ * [NovelData::prefetchScene Starts loading a scene on another thread]
+ * @param chapterIndex [Index of the chapter]
+ * @param sceneIndex   [Index of the scene within the chapter]
+ */
+void NovelData::prefetchScene(int chapterIndex, int sceneIndex) {
+
+    // Only one scene is loaded at a time, as they share the loader and its connection
+    finishPrefetch();
+
+    if (chapterIndex < 0 || chapterIndex >= chapterCount) {
+        return;
+    }
+
+    NovelChapter *sceneChapter = chapter[chapterIndex];
+
+    if (sceneIndex < 0 || sceneIndex >= sceneChapter->getSceneCount() || sceneChapter->getScene(sceneIndex)) {
+        return;
+    }
+
+    int sceneId = sceneChapter->getSceneId(sceneIndex);
+    NovelLoader *sceneLoader = loader;
+
+    prefetchChapterIndex = chapterIndex;
+    prefetchSceneIndex = sceneIndex;
+    prefetch = std::async(std::launch::async, [sceneLoader, sceneId] {
+        return sceneLoader->loadScene(sceneId);
+    });
+}
+
+/**
+ * [NovelData::finishPrefetch Waits for a prefetch to complete and hands the scene over to its chapter]
+ */
+void NovelData::finishPrefetch() {
+
+    if (!prefetch.valid()) {
+        return;
+    }
+
+    int chapterIndex = prefetchChapterIndex;
+    int sceneIndex = prefetchSceneIndex;
+    prefetchChapterIndex = -1;
+    prefetchSceneIndex = -1;
+
+    // Rethrows anything thrown while the scene was loading
+    NovelScene *prefetchedScene = prefetch.get();
+
+    chapter[chapterIndex]->setScene(sceneIndex, prefetchedScene);
+    residentScenes.emplace_back(chapterIndex, sceneIndex);
+}
+
+/**
+ * [NovelData::getImageSceneIndex Finds a scene in the novel image]
+ * @param  chapterIndex [Index of the chapter]
+ * @param  sceneIndex   [Index of the scene within the chapter]
+ * @return              [Index of the scene in the image, or -1 if the novel has no such scene]
+ */
+int NovelData::getImageSceneIndex(int chapterIndex, int sceneIndex) {
+
+    if (chapterIndex < 0 || chapterIndex >= chapterCount || sceneIndex < 0) {
+        return -1;
+    }
+
+    const NovelImageChapter &record = image->getChapter(chapterIndex);
+
+    if (sceneIndex >= static_cast<int>(record.sceneCount)) {
+        return -1;
+    }
+
+    return static_cast<int>(record.firstScene) + sceneIndex;
+}
+
+/**
+ * [NovelData::getImageScene Points one of the scene views at a scene in the novel image]
+ * @param  chapterIndex [Index of the chapter]
+ * @param  sceneIndex   [Index of the scene within the chapter]
+ * @return              [The view, or nullptr if the novel has no such scene]
+ */
+NovelScene *NovelData::getImageScene(int chapterIndex, int sceneIndex) {
+
+    int imageSceneIndex = getImageSceneIndex(chapterIndex, sceneIndex);
+
+    if (imageSceneIndex == -1) {
+        return nullptr;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        if (imageSceneViewIndex[i] == imageSceneIndex) {
+            return imageSceneView[i];
+        }
+    }
+
+    // The views of the current and previous scenes are kept, as both are used during the transition between them
+    int currentImageSceneIndex = getImageSceneIndex(currentChapter, currentScene);
+    int previousImageSceneIndex = getImageSceneIndex(previousChapterIndex, previousSceneIndex);
+    int view = 0;
+
+    for (int i = 0; i < 3; i++) {
+        if (imageSceneViewIndex[i] == -1
+            || (imageSceneViewIndex[i] != currentImageSceneIndex && imageSceneViewIndex[i] != previousImageSceneIndex)) {
+            view = i;
+            break;
+        }
+    }
+
+    imageSceneView[view]->setFromImage(image, image->getScene(imageSceneIndex));
+    imageSceneViewIndex[view] = imageSceneIndex;
+
+    return imageSceneView[view];
+}
+
+/**
+ * [NovelData::getImageCharacterStateGroup Points the character state group view at a group in the novel image]
+ * @param  index [Index of the group in the image]
+ * @return       [The view, valid until another group is viewed. nullptr for NOVEL_IMAGE_NO_INDEX]
+ */
+CharacterStateGroup *NovelData::getImageCharacterStateGroup(uint32_t index) {
+
+    if (index == NOVEL_IMAGE_NO_INDEX) {
+        return nullptr;
+    }
+
+    if (imageCharacterStateGroupViewIndex == index) {
+        return imageCharacterStateGroupView;
+    }
 
-        if (currentSceneSegment == getCurrentScene()->getSegmentCount() - 1) {
+    const NovelImageCharacterStateGroup &record = image->getCharacterStateGroup(index);
+    CharacterStateGroup *group = imageCharacterStateGroupView;
 
-            if (currentScene == getCurrentChapter()->getSceneCount() - 1) {
-                return AdvanceState::ChapterEnd;
+    // Only marked as viewing the group once every state has been found
+    imageCharacterStateGroupViewIndex = NOVEL_IMAGE_NO_INDEX;
+    group->setFromImage(record);
+
+    for (uint32_t i = 0; i < record.characterStateCount; i++) {
+        const NovelImageCharacterState &state = image->getCharacterState(record.firstCharacterState + i);
+
+        if (!state.characterId) {
+            std::vector<std::string> error = {
+                    "Unable to find a character sprite with id ",
+                    std::to_string(state.characterSpriteId)
+            };
+
+            throw ResourceException(Utils::implodeString(error));
+        }
+
+        CharacterSprite *sprite = loader->findCharacterSprite(state.characterId, image->getString(state.spriteName));
+
+        group->setCharacterState(i, state.id, sprite);
+    }
+
+    imageCharacterStateGroupViewIndex = index;
+
+    return group;
+}
+
+/**
+ * [NovelData::getImageMusicPlaybackRequest Points the music playback request view at a request in the novel image]
+ * @param  index [Index of the request in the image]
+ * @return       [The view, valid until the next segment is viewed. nullptr for NOVEL_IMAGE_NO_INDEX]
+ */
+MusicPlaybackRequest *NovelData::getImageMusicPlaybackRequest(uint32_t index) {
+
+    if (index == NOVEL_IMAGE_NO_INDEX) {
+        return nullptr;
+    }
+
+    imageMusicPlaybackRequestView->setFromImage(image, image->getMusicPlaybackRequest(index));
+
+    return imageMusicPlaybackRequestView;
+}
+
+NovelSceneSegmentLine *NovelData::getNextLine() {
+
+    ++currentSceneSegmentLine;
+
+    return getCurrentLine();
+}
+
+/**
+ * [NovelData::getCurrentLine Returns the line the story is at]
+ * @return [The line, or nullptr if the current segment has no such line]
+ */
+NovelSceneSegmentLine *NovelData::getCurrentLine() {
+
+    if (residency == NovelResidency::Image) {
+        NovelSceneSegment *segment = getCurrentSceneSegment();
+
+        if (!segment || currentSceneSegmentLine >= segment->getLineCount()) {
+            return nullptr;
+        }
+
+        const NovelImageSegmentLine &record = image->getSegmentLine(
+                image->getSceneSegment(imageSceneSegmentViewIndex).firstSegmentLine + currentSceneSegmentLine);
+
+        imageSegmentLineView->setFromImage(image, record, getImageCharacterStateGroup(record.characterStateGroup));
+
+        return imageSegmentLineView;
+    }
+
+    NovelSceneSegment *segment = getCurrentSceneSegment();
+
+    return segment ? segment->getLine(currentSceneSegmentLine) : nullptr;
+}
+
+/**
+ * [NovelData::advanceToNextSegment Moves the story to the segment the current one leads to within the same scene]
+ * @return [The segment]
+ */
+NovelSceneSegment *NovelData::advanceToNextSegment() {
+    currentSceneSegmentLine = -1; // Reset which line we're on
+
+    if (getCurrentScene()->getSegmentCount() == 0) {
+        // TODO: Allow scenes with no segments as a background image transition between multiple places
+        std::cout << "Error: scene " << getCurrentScene()->getId() << " has no scene segments" << std::endl;
+    }
+
+    // A scene which has only just started begins at the segment it was jumped to
+    if (currentSceneSegment < 0) {
+        currentSceneSegment = entrySceneSegment;
+    } else {
+        currentSceneSegment = getJump(getCurrentSceneSegment()->getId()).sceneSegment;
+    }
+
+    return getCurrentSceneSegment();
+}
+
+/**
+ * [NovelData::advanceToNextScene Moves the story to the scene the current segment leads to, or to the first scene if
+ * the story hasn't started yet. The segment within it is started by advanceToNextSegment]
+ * @return [The scene, or nullptr if the story has ended]
+ */
+NovelScene *NovelData::advanceToNextScene() {
+
+    NovelJump jump = {currentChapter, 0, 0};
+
+    if (currentScene >= 0) {
+        jump = getJump(getCurrentSceneSegment()->getId());
+
+        if (jump.chapter < 0) {
+            return nullptr;
+        }
+
+        previousScene = getCurrentScene(); // Keep a reference to it as sometimes we need to use it during transitions
+        previousChapterIndex = currentChapter;
+        previousSceneIndex = currentScene;
+    } else {
+        previousScene = nullptr;
+        previousChapterIndex = -1;
+        previousSceneIndex = -1;
+    }
+
+    currentChapter = jump.chapter;
+    currentScene = jump.scene;
+    currentSceneSegment = -1;
+    entrySceneSegment = jump.sceneSegment;
+
+    NovelScene *scene = getCurrentScene();
+
+    updateSceneWindow();
+
+    return scene;
+}
+
+/**
+ * [NovelData::updateSceneWindow When windowed, unloads the scenes other than the previous and current ones and starts loading the one the current scene leads to]
+ */
+void NovelData::updateSceneWindow() {
+
+    if (residency != NovelResidency::Windowed) {
+        return;
+    }
+
+    NovelScene *scene = getCurrentScene();
+    NovelJump upcoming = {-1, -1, -1};
+
+    // The jump at the end of the scene's last segment is the one usually taken, though an earlier segment may lead elsewhere
+    if (scene && scene->getSegmentCount() > 0) {
+        upcoming = getJump(scene->getSceneSegment(scene->getSegmentCount() - 1)->getId());
+    }
+
+    // Places any scene which was still being prefetched, so that it is released below if it is no longer needed. The
+    // loader is only free to release scenes while nothing is being prefetched
+    finishPrefetch();
+
+    // The previous scene is kept as its end transition is still needed when the new scene starts
+    std::vector<std::pair<int, int>> keptScenes;
+
+    for (auto &residentScene : residentScenes) {
+        int chapterIndex = residentScene.first;
+        int sceneIndex = residentScene.second;
+
+        if ((chapterIndex == currentChapter && sceneIndex == currentScene)
+            || (chapterIndex == previousChapterIndex && sceneIndex == previousSceneIndex)
+            || (chapterIndex == upcoming.chapter && sceneIndex == upcoming.scene)) {
+            keptScenes.push_back(residentScene);
+        } else {
+            loader->releaseScene(chapter[chapterIndex]->getSceneId(sceneIndex));
+            chapter[chapterIndex]->releaseScene(sceneIndex);
+        }
+    }
+
+    residentScenes.swap(keptScenes);
+
+    prefetchScene(upcoming.chapter, upcoming.scene);
+}
+
+/**
+ * [NovelData::getJump Returns where the story goes once a segment of the current chapter has finished. A chapter whose
+ * requirement isn't met is passed over when the story reaches it from another chapter, the story then carries on from
+ * the first scene of the next chapter it can play]
+ * @param  sceneSegmentId [Id of the segment]
+ * @return                [The jump, which ends the story if the novel has no such segment]
+ */
+NovelJump NovelData::getJump(int sceneSegmentId) {
+
+    NovelJump jump = findJump(sceneSegmentId);
+
+    if (jump.chapter < 0 || jump.chapter == currentChapter || isChapterAvailable(jump.chapter)) {
+        return jump;
+    }
+
+    for (int i = jump.chapter + 1; i < chapterCount; i++) {
+        if (i != currentChapter && getChapterSceneCount(i) > 0 && isChapterAvailable(i)) {
+            return {i, 0, 0};
+        }
+    }
+
+    return {-1, -1, -1};
+}
+
+/**
+ * [NovelData::findJump Finds the jump or branch a segment takes, regardless of where it leads]
+ * @param  sceneSegmentId [Id of the segment]
+ * @return                [The jump, which ends the story if the novel has no such segment]
+ */
+NovelJump NovelData::findJump(int sceneSegmentId) {
+
+    // The first branch whose requirement is met is taken instead of the jump
+    if (sceneSegmentId >= 0 && sceneSegmentId + 1 < static_cast<int>(firstBranch.size())) {
+        for (uint32_t i = firstBranch[sceneSegmentId]; i < firstBranch[sceneSegmentId + 1]; i++) {
+            if (requirements.evaluate(branches[i].requirementId, flags)) {
+                return branches[i].target;
             }
+        }
+    }
 
-            return AdvanceState::SceneEnd;
+    if (residency == NovelResidency::Image) {
+        const NovelImageSceneSegmentJump *record = image->findSceneSegmentJump(sceneSegmentId);
+
+        if (!record) {
+            return {-1, -1, -1};
         }
 
-        return AdvanceState::SceneSegmentEnd;
+        return {record->chapter, record->scene, record->sceneSegment};
+    }
+
+    if (sceneSegmentId < 0 || sceneSegmentId >= static_cast<int>(jumps.size())) {
+        return {-1, -1, -1};
+    }
+
+    return jumps[sceneSegmentId];
+}
+
+/**
+ * [NovelData::loadStoryFlags Reads the flags and counters, the requirements which test them and the branches, flag
+ * changes and scripts of every scene segment. The flags are set to their values at the start of the story]
+ */
+void NovelData::loadStoryFlags() {
+
+    loader->loadFlags(defaultFlags);
+    loader->loadRequirements(requirements);
+    loader->loadChapterRequirements(chapterRequirements);
+    loader->loadBranches(branches, firstBranch);
+    loader->loadFlagChanges(flagChanges, firstFlagChange);
+    loader->loadSegmentScripts(segmentScripts);
+
+    // Requirements and changes are checked once here, so that they can be used without any checks while playing
+    requirements.validate(defaultFlags);
+
+    for (auto &change : flagChanges) {
+        bool counter = change.operation != NOVEL_FLAG_CHANGE_SET_FLAG;
+        int count = counter ? defaultFlags.getCounterCount() : defaultFlags.getFlagCount();
+
+        if (change.operand < 0 || change.operand >= count
+            || change.operation < NOVEL_FLAG_CHANGE_SET_FLAG || change.operation > NOVEL_FLAG_CHANGE_ADD_COUNTER) {
+            std::vector<std::string> error = {
+                    "The novel changes ", counter ? "counter " : "flag ", std::to_string(change.operand),
+                    ", which it does not declare"
+            };
+            throw ResourceException(Utils::implodeString(error));
+        }
+    }
+
+    resetFlags();
+}
+
+/**
+ * [NovelData::resetFlags Sets every flag and counter to its value at the start of the story]
+ */
+void NovelData::resetFlags() {
+    flags = defaultFlags;
+}
+
+/**
+ * [NovelData::getFlagChanges Finds the flag and counter changes made as a scene segment starts]
+ * @param  sceneSegmentId [Id of the segment]
+ * @param  changes        [Set to the first change]
+ * @return                [How many changes there are, in the order they are made]
+ */
+int NovelData::getFlagChanges(int sceneSegmentId, const NovelFlagChange **changes) {
+
+    *changes = flagChanges.data();
+
+    if (sceneSegmentId < 0 || sceneSegmentId + 1 >= static_cast<int>(firstFlagChange.size())) {
+        return 0;
+    }
+
+    *changes = flagChanges.data() + firstFlagChange[sceneSegmentId];
+
+    return static_cast<int>(firstFlagChange[sceneSegmentId + 1] - firstFlagChange[sceneSegmentId]);
+}
+
+/**
+ * [NovelData::getSegmentScript Finds the script a scene segment starts]
+ * @param  sceneSegmentId [Id of the segment]
+ * @return                [Name of the script, empty if it starts none]
+ */
+InternedString NovelData::getSegmentScript(int sceneSegmentId) {
+
+    if (sceneSegmentId < 0 || sceneSegmentId >= static_cast<int>(segmentScripts.size())) {
+        return InternedString();
+    }
+
+    return segmentScripts[sceneSegmentId];
+}
+
+/**
+ * [NovelData::isChapterAvailable Checks whether a chapter can be played with the current flags and counters]
+ * @param  chapterIndex [Index of the chapter]
+ * @return              [Whether its requirement is met, false if the novel has no such chapter]
+ */
+bool NovelData::isChapterAvailable(int chapterIndex) {
+
+    if (chapterIndex < 0 || chapterIndex >= static_cast<int>(chapterRequirements.size())) {
+        return false;
+    }
+
+    return requirements.evaluate(chapterRequirements[chapterIndex].requirementId, flags);
+}
+
+/**
+ * [NovelData::getChapterSceneCount Returns how many scenes a chapter has, whether or not they are loaded]
+ * @param  chapterIndex [Index of the chapter]
+ * @return              [The number of scenes]
+ */
+int NovelData::getChapterSceneCount(int chapterIndex) {
+
+    if (residency == NovelResidency::Image) {
+        return static_cast<int>(image->getChapter(chapterIndex).sceneCount);
+    }
+
+    return chapter[chapterIndex]->getSceneCount();
+}
+
+/**
+ * [NovelData::isChapterHidden Checks whether a chapter is left out of any list of chapters, such as one which is only
+ * reached through a jump]
+ * @param  chapterIndex [Index of the chapter]
+ * @return              [Whether it is hidden, true if the novel has no such chapter]
+ */
+bool NovelData::isChapterHidden(int chapterIndex) {
+
+    if (chapterIndex < 0 || chapterIndex >= static_cast<int>(chapterRequirements.size())) {
+        return true;
+    }
+
+    return chapterRequirements[chapterIndex].hidden;
+}
+
+/**
+ * [NovelData::indexLines Indexes every line by its id, so that lines which are no longer being shown can be found]
+ */
+void NovelData::indexLines() {
+
+    // Windowed novels only have the lines around the current scene, others are read from the database. Novel images
+    // have their own index of lines
+    if (residency != NovelResidency::Full) {
+        return;
+    }
+
+    for (auto &loadedChapter : chapter) {
+        for (int i = 0; i < loadedChapter->getSceneCount(); i++) {
+            NovelScene *scene = loadedChapter->getScene(i);
+
+            for (int j = 0; j < scene->getSegmentCount(); j++) {
+                NovelSceneSegment *segment = scene->getSceneSegment(j);
+
+                for (int k = 0; k < segment->getLineCount(); k++) {
+                    NovelSceneSegmentLine *line = segment->getLine(k);
+
+                    if (line->getId() < 0) {
+                        continue;
+                    }
+
+                    if (line->getId() >= static_cast<int>(lineById.size())) {
+                        lineById.resize(line->getId() + 1, nullptr);
+                    }
+
+                    lineById[line->getId()] = line;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * [NovelData::getLineText Returns the text of any line in the novel, whether or not its scene is loaded]
+ * @param  lineId [Id of the line]
+ * @return        [The text, empty if the novel has no such line]
+ */
+std::string NovelData::getLineText(int lineId) {
+
+    if (lineId < 0) {
+        return "";
+    }
+
+    if (strings) {
+        return std::string(strings->getLineText(lineId));
+    }
+
+    if (residency == NovelResidency::Image) {
+        uint32_t lineIndex = image->getSegmentLineIndex(lineId);
+
+        if (lineIndex == NOVEL_IMAGE_NO_INDEX) {
+            return "";
+        }
+
+        return std::string(image->getString(image->getSegmentLine(lineIndex).text));
+    }
+
+    if (residency == NovelResidency::Full) {
+        if (lineId >= static_cast<int>(lineById.size()) || !lineById[lineId]) {
+            return "";
+        }
+
+        return std::string(lineById[lineId]->getText());
+    }
+
+    PooledConnection connection = DatabaseConnectionPool::getRuntimePool("novel")->tryCheckout();
+    QueryCursor lineData(getLineReader(connection)->prepare("SELECT text FROM segment_lines WHERE id = ?;")->bind(1, lineId));
+
+    return lineData.next() ? lineData.getString(0) : "";
+}
+
+/**
+ * [NovelData::getLineReader Returns the connection a windowed novel reads lines which aren't loaded through. The novel's
+ * own connection may be in use by the prefetch thread, so a connection checked out of the pool is used. The pool may
+ * have no other connection, as it only has one when opened in memory or when SQLite isn't thread safe, so the novel's
+ * own connection is used once the prefetch has finished]
+ * @param  connection [The connection checked out of the pool with tryCheckout, which may be empty]
+ * @return            [The connection to read through]
+ */
+DatabaseConnection *NovelData::getLineReader(PooledConnection &connection) {
+
+    if (connection.get()) {
+        return connection.get();
     }
 
-    return AdvanceState::NextLine;
-}
+    finishPrefetch();
 
-NovelSceneSegment *NovelData::getCurrentSceneSegment() {
-    return chapter[currentChapter]->getScene(currentScene)->getSceneSegment(currentSceneSegment);
+    return novelDb;
 }
 
-NovelScene *NovelData::getCurrentScene() {
-    return chapter[currentChapter]->getScene(currentScene);
+/**
+ * [NovelData::getLineText Returns the text of a line in the current locale]
+ * @param  line [The line]
+ * @return      [The text]
+ */
+std::string NovelData::getLineText(NovelSceneSegmentLine *line) {
+    return std::string(strings ? strings->getLineText(line->getId()) : line->getText());
 }
 
-NovelChapter *NovelData::getCurrentChapter() {
-    return chapter[currentChapter];
+/**
+ * [NovelData::getCharacterName Returns the name shown with a line in the current locale, either the name it overrides
+ * the character's name with or the character's name]
+ * @param  line [The line]
+ * @return      [The name, empty if nobody is speaking]
+ */
+std::string NovelData::getCharacterName(NovelSceneSegmentLine *line) {
+    return getCharacterName(line->getId(), line->getCharacterId(), line->getOverrideCharacterName().view());
 }
 
-void NovelData::loadFromDatabase() {
-
-    if (!Utils::fileExists("db/novel")) {
-        throw GeneralException("Error: Unable to find novel database file");
-    }
+/**
+ * [NovelData::getCharacterName Returns the name shown with any line in the novel in the current locale, whether or not
+ * its scene is loaded]
+ * @param  lineId [Id of the line]
+ * @return        [The name, empty if nobody is speaking or the novel has no such line]
+ */
+std::string NovelData::getCharacterName(int lineId) {
 
-    // Empty the character array
-    for (int i = 0; i < MAX_CHARACTERS; i++) {
-        if (character[i]) {
-            delete (character[i]);
-            character[i] = nullptr;
-        }
+    if (lineId < 0) {
+        return "";
     }
 
-    novelDb = new DatabaseConnection("novel");
+    if (residency == NovelResidency::Image) {
+        uint32_t lineIndex = image->getSegmentLineIndex(lineId);
 
-    // Load all of the characters
-    DataSet *characterData = new DataSet();
+        if (lineIndex == NOVEL_IMAGE_NO_INDEX) {
+            return "";
+        }
 
-    novelDb->executeQuery("SELECT * FROM characters;", characterData);
+        const NovelImageSegmentLine &record = image->getSegmentLine(lineIndex);
 
-    for (int i = 0; i < characterData->getRowCount(); i++) {
+        return getCharacterName(lineId, record.characterId, image->getString(record.overrideCharacterName));
+    }
 
-        if (i >= MAX_CHARACTERS) {
-            break;
+    if (residency == NovelResidency::Full) {
+        if (lineId >= static_cast<int>(lineById.size()) || !lineById[lineId]) {
+            return "";
         }
 
-        {
-            int id = 0;
-            std::string firstName("");
-            std::string surname("");
-            std::string bio("");
-            std::string age("");
-            bool showOnCharacterMenu = false;
+        return getCharacterName(lineById[lineId]);
+    }
 
-            if (characterData->getRow(i)->doesColumnExist("id")) {
-                id = characterData->getRow(i)->getColumn("id")->getData()->asInteger();
-            }
+    PooledConnection connection = DatabaseConnectionPool::getRuntimePool("novel")->tryCheckout();
+    QueryCursor lineData(getLineReader(connection)->prepare(
+            "SELECT character_id, override_character_name FROM segment_lines WHERE id = ?;")->bind(1, lineId));
 
-            if (characterData->getRow(i)->doesColumnExist("first_name")) {
-                firstName = characterData->getRow(i)->getColumn("first_name")->getRawData();
-            }
+    if (!lineData.next()) {
+        return "";
+    }
 
-            if (characterData->getRow(i)->doesColumnExist("surname")) {
-                surname = characterData->getRow(i)->getColumn("surname")->getRawData();
-            }
+    return getCharacterName(lineId, lineData.getInteger(0), lineData.getString(1));
+}
 
-            if (characterData->getRow(i)->doesColumnExist("bio")) {
-                bio = characterData->getRow(i)->getColumn("bio")->getRawData();
-            }
+/**
+ * [NovelData::getCharacterName Returns the name shown with a line in the current locale]
+ * @param  lineId                [Id of the line]
+ * @param  characterId           [Id of the character speaking it, 0 if nobody is]
+ * @param  overrideCharacterName [The name the line shows in place of the character's in the novel's own locale]
+ * @return                       [The name, empty if nobody is speaking]
+ */
+std::string NovelData::getCharacterName(int lineId, int characterId, std::string_view overrideCharacterName) {
 
-            if (characterData->getRow(i)->doesColumnExist("age")) {
-                age = characterData->getRow(i)->getColumn("age")->getRawData();
-            }
+    if (strings) {
+        overrideCharacterName = strings->getLineCharacterName(lineId);
+    }
 
-            if (characterData->getRow(i)->doesColumnExist("showOnCharacterMenu")) {
-                std::string comparison = characterData->getRow(i)->getColumn("showOnCharacterMenu")->getRawData();
-                showOnCharacterMenu = (comparison == "TRUE" || comparison == "true");
-            }
+    if (!overrideCharacterName.empty()) {
+        return std::string(overrideCharacterName);
+    }
 
-            character[i] = new Character(id, firstName, surname, bio, age, showOnCharacterMenu, novelDb);
-        }
+    if (characterId <= 0) {
+        return "";
     }
 
-    for (int i = 0; i < MAX_CHAPTERS; i++) {
-        chapter[i] = nullptr;
+    if (strings) {
+        return std::string(strings->getCharacterName(characterId));
     }
 
-    // Load project information from Database
-    projectInformation = new ProjectInformation(novelDb);
+    Character *lineCharacter = getCharacter(characterId - 1);
 
-    DataSet *chapterData = new DataSet();
+    return lineCharacter ? lineCharacter->getFirstName() : "";
+}
 
-    novelDb->executeQuery("SELECT * FROM chapters", chapterData);
+/**
+ * [NovelData::getChapterTitle Returns the title of a chapter in the current locale]
+ * @param  chapterIndex [Index of the chapter]
+ * @return              [The title, empty if the novel has no such chapter]
+ */
+std::string NovelData::getChapterTitle(int chapterIndex) {
 
-    for (int i = 0; i < chapterData->getRowCount(); i++) {
+    if (chapterIndex < 0 || chapterIndex >= chapterCount) {
+        return "";
+    }
 
-        if (!chapterData->getRow(i)->doesColumnExist("id")) {
-            continue;
-        }
+    if (image) {
+        const NovelImageChapter &record = image->getChapter(static_cast<uint32_t>(chapterIndex));
+        return strings ? std::string(strings->getChapterTitle(record.id)) : std::string(image->getString(record.title));
+    }
 
-        if (!chapterData->getRow(i)->doesColumnExist("title")) {
-            continue;
-        }
+    return strings ? std::string(strings->getChapterTitle(chapter[chapterIndex]->getId()))
+                   : chapter[chapterIndex]->getTitle();
+}
 
-        chapter[i] = new NovelChapter(novelDb,
-                                      chapterData->getRow(i)->getColumn("title")->getData()->getRawData(),
-                                      chapterData->getRow(i)->getColumn("id")->getData()->asInteger(),
-                                      character);
+/**
+ * [NovelData::setLocale Changes the locale the novel is played in. Only the string pack of the new locale is kept
+ * mapped, the story itself is left as it is. If the new pack can't be used, a ResourceException is thrown and the
+ * locale is left as it was]
+ * @param locale [Name of the locale, one of getLocales()]
+ */
+void NovelData::setLocale(const std::string &locale) {
 
-        chapterCount++;
-    }
+    auto found = std::find(locales.begin(), locales.end(), locale);
 
-    // Cleanup
-    delete (characterData);
-    delete (chapterData);
-}
+    if (found == locales.end()) {
+        std::vector<std::string> error = {"The novel has no locale '", locale, "'"};
+        throw ResourceException(Utils::implodeString(error));
+    }
 
-NovelData::~NovelData() {
-    delete novelDb;
+    int index = static_cast<int>(found - locales.begin());
 
-    for (int i = 0; i < MAX_CHAPTERS; i++) {
-        if (chapter[i]) {
-            delete (chapter[i]);
-        }
+    if (index == localeIndex) {
+        return;
     }
-}
 
-NovelSceneSegmentLine *NovelData::getNextLine() {
-    return getCurrentSceneSegment()->getLine(++currentSceneSegmentLine);
+    auto *pack = new StringPack(StringPack::getPath(locale));
+
+    delete strings;
+    strings = pack;
+    localeIndex = index;
 }
 
-NovelSceneSegment *NovelData::advanceToNextSegment() {
-    currentSceneSegmentLine = -1; // Reset which line we're on
+/**
+ * [NovelData::loadLocales Reads the novel's locales and maps the string pack of the one it is played in. If no pack
+ * can be used, the locales are dropped and the text the novel is written in is read from the database instead]
+ * @param locale [The locale to play in, empty for the locale the novel is written in]
+ */
+void NovelData::loadLocales(const std::string &locale) {
 
-    if (getCurrentScene()->getSegmentCount() == 0) {
-        // TODO: Allow scenes with no segments as a background image transition between multiple places
-        std::cout << "Error: scene " << getCurrentScene()->getId() << " has no scene segments" << std::endl;
+    QueryCursor localeData(novelDb->prepare("SELECT name FROM locales ORDER BY id;"));
+
+    while (localeData.next()) {
+        locales.push_back(localeData.getString(0));
     }
-    return getCurrentScene()->getSceneSegment(++currentSceneSegment);
-}
 
-NovelScene *NovelData::advanceToNextScene() {
-    currentSceneSegment = -1;
+    if (locales.empty()) {
+        return;
+    }
 
-    if (currentScene >= 0) {
-        // We won't be always be jumping between them in a linear fashion
-        previousScene = getCurrentScene(); // Keep a reference to it as sometimes we need to use it during transitions
-    } else {
-        previousScene = nullptr;
+    std::string firstChoice = locale.empty() ? locales[0] : locale;
+
+    try {
+        setLocale(firstChoice);
+        return;
+    } catch (ResourceException &e) {
+        std::cout << "Unable to play the novel in '" << firstChoice << "': " << e.what() << std::endl;
+    }
+
+    if (firstChoice != locales[0]) {
+        try {
+            setLocale(locales[0]);
+            return;
+        } catch (ResourceException &e) {
+            std::cout << "Unable to play the novel in '" << locales[0] << "': " << e.what() << std::endl;
+        }
     }
-    currentScene++;
-    return getCurrentScene();
+
+    std::cout << "The novel's text will be read from the novel database" << std::endl;
+    locales.clear();
 }
 
 ProjectInformation *NovelData::getProjectInformation() {
@@ -210,72 +1167,111 @@ ProjectInformation *NovelData::getProjectInformation() {
 }
 
 Character *NovelData::getCharacter(int id) {
+
+    if (id < 0 || id >= static_cast<int>(character.size())) {
+        return nullptr;
+    }
+
     return character[id];
 }
 
+/**
+ * [NovelData::findCharacterSprite Finds one of a character's sprites by name]
+ * @param  characterId [Id of the character]
+ * @param  spriteName  [Name of the sprite]
+ * @return             [The sprite, or nullptr if the character or sprite does not exist]
+ */
+CharacterSprite *NovelData::findCharacterSprite(int characterId, const std::string &spriteName) {
+
+    Character *spriteCharacter = getCharacter(characterId - 1);
+
+    return spriteCharacter ? spriteCharacter->getSprite(spriteName) : nullptr;
+}
+
 // Chapter-specific stuff
-NovelChapter::NovelChapter(DatabaseConnection *db, std::string chapterTitle, int chapterId, Character *character[]) {
+NovelChapter::NovelChapter(std::string chapterTitle, int chapterId) {
     title = chapterTitle;
     id = chapterId;
     sceneCount = 0;
+    imageView = false;
 
 #ifdef DEBUG_NOVEL_DATA
     std::cout<<"Adding chapter "<<id<<" '"<<title<<"'"<<std::endl;
 #endif
+}
 
-    for (int i = 0; i < MAX_SCENES; i++) {
-        scene[i] = nullptr;
-    }
-
-    // Get all of the scenes within the chapter
-    auto *sceneData = new DataSet();
-
-    std::ostringstream ss;
-
-    ss << "SELECT * FROM scenes WHERE chapter_id = " << id << ";";
-
-    db->executeQuery(ss.str(), sceneData);
+/**
+ * [NovelChapter::addScene Adds a scene to the end of the chapter, the chapter takes ownership of it]
+ * @param newScene [The scene]
+ */
+void NovelChapter::addScene(NovelScene *newScene) {
+    sceneIds.push_back(newScene->getId());
+    scene.push_back(newScene);
+    sceneCount++;
+}
 
-    for (int i = 0; i < sceneData->getRowCount(); i++) {
+/**
+ * [NovelChapter::setSceneIndex Sets the ids of the scenes in this chapter without loading them, any loaded scenes are deleted]
+ * @param ids [Ids of the scenes, in the order they are played]
+ */
+void NovelChapter::setSceneIndex(const std::vector<int> &ids) {
 
-        if (!sceneData->getRow(i)->doesColumnExist("id")) {
-            continue;
-        }
+    for (int i = 0; i < sceneCount; i++) {
+        releaseScene(i);
+    }
 
-        std::string backgroundImageName("");
+    sceneIds = ids;
+    scene.assign(sceneIds.size(), nullptr);
+    sceneCount = static_cast<int>(sceneIds.size());
+}
 
-        if (sceneData->getRow(i)->doesColumnExist("background_image_name")) {
-            backgroundImageName = sceneData->getRow(i)->getColumn("background_image_name")->getRawData();
-        }
+int NovelChapter::getSceneId(int index) {
+    return sceneIds[index];
+}
 
-        int backgroundColourId = 0;
-        int startTransitionColourId = 0;
-        int endTransitionColourId = 0;
+/**
+ * [NovelChapter::setScene Places a loaded scene into the scene index, the chapter takes ownership of it]
+ * @param index    [Index of the scene]
+ * @param newScene [The scene]
+ */
+void NovelChapter::setScene(int index, NovelScene *newScene) {
 
-        if (sceneData->getRow(i)->doesColumnExist("background_colour_id")) {
-            backgroundColourId = sceneData->getRow(i)->getColumn("background_colour_id")->getData()->asInteger();
-        }
+    if (index < 0 || index >= sceneCount) {
+        delete newScene;
+        return;
+    }
 
-        if (sceneData->getRow(i)->doesColumnExist("start_transition_colour_id")) {
-            startTransitionColourId = sceneData->getRow(i)->getColumn("start_transition_colour_id")->getData()->asInteger();
-        }
+    releaseScene(index);
+    scene[index] = newScene;
+}
 
-        if (sceneData->getRow(i)->doesColumnExist("end_transition_colour_id")) {
-            endTransitionColourId = sceneData->getRow(i)->getColumn("end_transition_colour_id")->getData()->asInteger();
-        }
+/**
+ * [NovelChapter::releaseScene Deletes a loaded scene, it stays in the scene index so that it can be loaded again]
+ * @param index [Index of the scene]
+ */
+void NovelChapter::releaseScene(int index) {
 
-        scene[i] = new NovelScene(db, sceneData->getRow(i), character);
-        sceneCount++;
+    if (scene[index]) {
+        delete scene[index];
+        scene[index] = nullptr;
     }
+}
 
-    delete sceneData;
+/**
+ * [NovelChapter::setFromImage Makes this a view of a chapter in the novel image, its scenes are read through NovelData]
+ * @param image  [The novel image]
+ * @param record [The chapter]
+ */
+void NovelChapter::setFromImage(NovelImage *image, const NovelImageChapter &record) {
+    id = record.id;
+    imageTitle = image->getString(record.title);
+    imageView = true;
+    sceneCount = static_cast<int>(record.sceneCount);
 }
 
 NovelChapter::~NovelChapter() {
-    for (int i = 0; i < MAX_SCENES; i++) {
-        if (scene[i]) {
-            delete scene[i];
-        }
+    for (auto &loadedScene : scene) {
+        delete loadedScene;
     }
 }
 
@@ -284,10 +1280,15 @@ int NovelChapter::getId() {
 }
 
 std::string NovelChapter::getTitle() {
-    return title;
+    return imageView ? std::string(imageTitle) : title;
 }
 
 NovelScene *NovelChapter::getScene(int id) {
+
+    if (id < 0 || id >= static_cast<int>(scene.size())) {
+        return nullptr;
+    }
+
     return scene[id];
 }
 
@@ -296,66 +1297,67 @@ int NovelChapter::getSceneCount() {
 }
 
 // Scene-specific stuff
-NovelScene::NovelScene(DatabaseConnection *db, DataSetRow *data, Character *character[]) {
-    id = data->getColumn("id")->getData()->asInteger();
-    backgroundImage = data->getColumn("background_image_name")->getData()->asString();
-    backgroundColourId = data->getColumn("background_colour_id")->getData()->asInteger();
-    startTransitionColourId = data->getColumn("start_transition_colour_id")->getData()->asInteger();
-    endTransitionColourId = data->getColumn("end_transition_colour_id")->getData()->asInteger();
-    startTransitionTypeId = data->getColumn("start_transition_type_id")->getData()->asInteger();
-    endTransitionTypeId = data->getColumn("end_transition_type_id")->getData()->asInteger();
-
+NovelScene::NovelScene() {
+    id = 0;
+    backgroundColourId = 0;
+    startTransitionColourId = 0;
+    endTransitionColourId = 0;
+    startTransitionTypeId = 0;
+    endTransitionTypeId = 0;
     segmentCount = 0;
+}
 
-    for (int i = 0; i < MAX_SEGMENTS; i++) {
-        segment[i] = nullptr;
-    }
+NovelScene::NovelScene(QueryCursor *data) {
+    id = data->getInteger("id");
+    backgroundImage = InternedString(data->getText("background_image_name"));
+    backgroundColourId = data->getInteger("background_colour_id");
+    startTransitionColourId = data->getInteger("start_transition_colour_id");
+    endTransitionColourId = data->getInteger("end_transition_colour_id");
+    startTransitionTypeId = data->getInteger("start_transition_type_id");
+    endTransitionTypeId = data->getInteger("end_transition_type_id");
+
+    segmentCount = 0;
 
 #ifdef DEBUG_NOVEL_DATA
     std::cout<<"Adding scene "<<id<<std::endl;
 #endif
+}
 
-    DataSet *sceneSegmentData = new DataSet();
-
-    std::ostringstream ss;
-
-    ss << "SELECT * FROM scene_segments WHERE scene_id = " << id << ";";
-
-    db->executeQuery(ss.str(), sceneSegmentData);
-
-    for (int i = 0; i < sceneSegmentData->getRowCount(); i++) {
-
-        if (!sceneSegmentData->getRow(i)->doesColumnExist("id")) {
-            continue;
-        }
-
-        std::string visualEffectName = sceneSegmentData->getRow(i)->doesColumnExist("visual_effect_name")
-                                       ? sceneSegmentData->getRow(i)->getColumn("visual_effect_name")->getRawData() : "";
-
-        segment[i] = new NovelSceneSegment(db,
-                                           sceneSegmentData->getRow(i)->getColumn("id")->getData()->asInteger(),
-                                           visualEffectName,
-                                           character,
-                                           sceneSegmentData->getRow(i)->getColumn(
-                                                   "music_playback_request_id")->getData()->asInteger());
+/**
+ * [NovelScene::addSceneSegment Adds a segment to the end of the scene. Its lines can only be added once it is part of the scene]
+ * @param newSegment [The segment]
+ */
+void NovelScene::addSceneSegment(NovelSceneSegment newSegment) {
+    newSegment.scene = this;
+    segment.push_back(std::move(newSegment));
+    segmentCount++;
+}
 
-        segmentCount++;
-    }
+/**
+ * [NovelScene::setFromImage Makes this a view of a scene in the novel image, its segments are read through NovelData]
+ * @param image  [The novel image]
+ * @param record [The scene]
+ */
+void NovelScene::setFromImage(NovelImage *image, const NovelImageScene &record) {
+    id = record.id;
+    backgroundImage = InternedString(image->getString(record.backgroundImageName));
+    backgroundColourId = record.backgroundColourId;
+    startTransitionColourId = record.startTransitionColourId;
+    endTransitionColourId = record.endTransitionColourId;
+    startTransitionTypeId = record.startTransitionTypeId;
+    endTransitionTypeId = record.endTransitionTypeId;
+    segmentCount = static_cast<int>(record.sceneSegmentCount);
+}
 
-    delete sceneSegmentData;
+NovelScene::~NovelScene() = default;
 
-}
+NovelSceneSegment *NovelScene::getSceneSegment(int id) {
 
-NovelScene::~NovelScene() {
-    for (int i = 0; i < MAX_SEGMENTS; i++) {
-        if (segment[i]) {
-            delete segment[i];
-        }
+    if (id < 0 || id >= static_cast<int>(segment.size())) {
+        return nullptr;
     }
-}
 
-NovelSceneSegment *NovelScene::getSceneSegment(int id) {
-    return segment[id];
+    return &segment[id];
 }
 
 int NovelScene::getSegmentCount() {
@@ -366,7 +1368,7 @@ int NovelScene::getId() {
     return id;
 }
 
-std::string NovelScene::getBackgroundImageName() {
+InternedString NovelScene::getBackgroundImageName() {
     return backgroundImage;
 }
 
@@ -391,96 +1393,102 @@ int NovelScene::getEndTransitionColourId() {
 }
 
 // Segment-specific stuff
-NovelSceneSegment::NovelSceneSegment(DatabaseConnection *db, int ssId,
-                                     std::string ssVisualEffectName, Character *character[], int musicPlaybackRequestId) {
+NovelSceneSegment::NovelSceneSegment(int ssId, std::string ssVisualEffectName,
+                                     MusicPlaybackRequest *ssMusicPlaybackRequest) {
     id = ssId;
     visualEffectName = ssVisualEffectName;
+    scene = nullptr;
+    firstLine = 0;
     lineCount = 0;
-    musicPlaybackRequest = nullptr;
-
-    for (auto & currentLine : line) {
-        currentLine = nullptr;
-    }
+    musicPlaybackRequest = ssMusicPlaybackRequest;
+    imageView = false;
 
 #ifdef DEBUG_NOVEL_DATA
     std::cout<<"Added scene segment "<<id<<std::endl;
 #endif
+}
 
-    // Get the music playback request if there is one
-    auto *musicPlaybackRequestData = new DataSet();
+NovelSceneSegment::NovelSceneSegment(NovelSceneSegment &&other) noexcept {
+    id = other.id;
+    backgroundMusicName = std::move(other.backgroundMusicName);
+    visualEffectName = std::move(other.visualEffectName);
+    scene = other.scene;
+    firstLine = other.firstLine;
+    lineCount = other.lineCount;
+    musicPlaybackRequest = other.musicPlaybackRequest;
+    imageView = other.imageView;
+
+    other.musicPlaybackRequest = nullptr;
+}
 
-    if (musicPlaybackRequestId) {
-        std::vector<std::string> query = {
-                "SELECT * FROM music_playback_requests WHERE id = ",
-                std::to_string(musicPlaybackRequestId), ";"
-        };
+NovelSceneSegment &NovelSceneSegment::operator=(NovelSceneSegment &&other) noexcept {
 
-        db->executeQuery(Utils::implodeString(query), musicPlaybackRequestData);
+    if (this == &other) {
+        return *this;
     }
 
-    if (musicPlaybackRequestData->getRowCount() == 1) {
-
-        // We have a music playback request, so let's add it
-        int playbackRequestId = musicPlaybackRequestData->getRow(0)->getColumn("id")->getData()->asInteger();
-        std::string musicName = musicPlaybackRequestData->getRow(0)->getColumn("music_name")->getRawData();
-        int musicPlaybackRequestMetadataId = musicPlaybackRequestData->getRow(0)->getColumn("music_playback_request_metadata_id")->getData()->asInteger();
-        musicPlaybackRequest = new MusicPlaybackRequest(db, playbackRequestId, musicName, musicPlaybackRequestMetadataId);
+    if (!imageView) {
+        delete musicPlaybackRequest;
     }
 
-    delete(musicPlaybackRequestData);
-
-    // Get all of the lines for this scene segment
-    DataSet *lineData = new DataSet();
-
-    std::ostringstream ss;
-
-    ss << "SELECT * FROM segment_lines WHERE scene_segment_id = " << id << ";";
-
-    db->executeQuery(ss.str(), lineData);
-
-    for (int i = 0; i < lineData->getRowCount(); i++) {
-
-        int characterStateGroupId = 0;
-
-        if (!lineData->getRow(i)->doesColumnExist("id")) {
-            continue;
-        }
+    id = other.id;
+    backgroundMusicName = std::move(other.backgroundMusicName);
+    visualEffectName = std::move(other.visualEffectName);
+    scene = other.scene;
+    firstLine = other.firstLine;
+    lineCount = other.lineCount;
+    musicPlaybackRequest = other.musicPlaybackRequest;
+    imageView = other.imageView;
 
-        if (!lineData->getRow(i)->doesColumnExist("text")) {
-            continue;
-        }
+    other.musicPlaybackRequest = nullptr;
 
-        if (lineData->getRow(i)->doesColumnExist("character_state_group_id")) {
-            characterStateGroupId = lineData->getRow(i)->getColumn("character_state_group_id")->getData()->asInteger();
-        }
+    return *this;
+}
 
-        int characterId = lineData->getRow(i)->getColumn("character_id")->getData()->asInteger();
-        std::string overrideCharacterName = "";
+/**
+ * [NovelSceneSegment::addLine Adds a line to the end of the segment, it is stored with the rest of the scene's lines]
+ * @param  newLine [The line]
+ * @return         [False if the segment is not part of a scene yet, or another segment's lines have been added since this
+ *                  segment's first line, as a segment's lines must be stored together]
+ */
+bool NovelSceneSegment::addLine(NovelSceneSegmentLine newLine) {
 
-        if (lineData->getRow(i)->doesColumnExist("override_character_name")) {
-            overrideCharacterName = lineData->getRow(i)->getColumn("override_character_name")->getRawData();
-        }
+    if (!scene) {
+        return false;
+    }
 
-        line[i] = new NovelSceneSegmentLine(db,
-                                            lineData->getRow(i)->getColumn("id")->getData()->asInteger(),
-                                            characterId,
-                                            lineData->getRow(i)->getColumn("text")->getRawData(),
-                                            characterStateGroupId,
-                                            overrideCharacterName,
-                                            character
-        );
+    int nextLine = static_cast<int>(scene->line.size());
 
-        lineCount++;
+    if (!lineCount) {
+        firstLine = nextLine;
+    } else if (firstLine + lineCount != nextLine) {
+        return false;
     }
 
-    delete lineData;
+    scene->line.push_back(std::move(newLine));
+    lineCount++;
+    return true;
+}
+
+/**
+ * [NovelSceneSegment::setFromImage Makes this a view of a segment in the novel image, its lines are read through NovelData]
+ * @param record  [The segment]
+ * @param request [The segment's music playback request, which is not owned by the view]
+ */
+void NovelSceneSegment::setFromImage(const NovelImageSceneSegment &record, MusicPlaybackRequest *request) {
+    id = record.id;
+    // Visual effects aren't shown by the runner yet, so the name is left in the image rather than copied
+    visualEffectName.clear();
+    scene = nullptr;
+    firstLine = 0;
+    lineCount = static_cast<int>(record.segmentLineCount);
+    musicPlaybackRequest = request;
+    imageView = true;
 }
 
 NovelSceneSegment::~NovelSceneSegment() {
-    for (int i = 0; i < MAX_LINES; i++) {
-        if (line[i]) {
-            delete line[i];
-        }
+    if (!imageView) {
+        delete musicPlaybackRequest;
     }
 }
 
@@ -489,7 +1497,12 @@ int NovelSceneSegment::getLineCount() {
 }
 
 NovelSceneSegmentLine *NovelSceneSegment::getLine(int id) {
-    return line[id];
+
+    if (!scene || id < 0 || id >= lineCount) {
+        return nullptr;
+    }
+
+    return &scene->line[firstLine + id];
 }
 
 std::string NovelSceneSegment::getBackgroundMusicName() {
@@ -497,48 +1510,44 @@ std::string NovelSceneSegment::getBackgroundMusicName() {
 }
 
 // Line-specific stuff
-NovelSceneSegmentLine::NovelSceneSegmentLine(DatabaseConnection *db, int sslId, int sslCharacterId, std::string sslText,
-                                             int sslCharacterStateGroupId, std::string sslOverrideCharacterName,
-                                             Character *character[]) {
+NovelSceneSegmentLine::NovelSceneSegmentLine(int sslId, int sslCharacterId, std::string sslText,
+                                             CharacterStateGroup *sslCharacterStateGroup,
+                                             std::string sslOverrideCharacterName) {
     id = sslId;
     characterId = sslCharacterId;
-    overrideCharacterName = sslOverrideCharacterName;
+    overrideCharacterName = InternedString(sslOverrideCharacterName);
 
     text = sslText;
-    characterStateGroup = nullptr;
+    imageView = false;
+    characterStateGroup = sslCharacterStateGroup;
 
 #ifdef DEBUG_NOVEL_DATA
     std::cout<<"Added line \""<<text<<"\""<<std::endl;
 #endif
-
-    // Find if we have a character sprite group attached to this line
-    if (sslCharacterStateGroupId == 0) {
-        return;
-    }
-
-    std::vector<std::string> characterStateGroupQuery = {
-            "SELECT * FROM character_state_groups WHERE id = ",
-            std::to_string(sslCharacterStateGroupId),
-            ";"
-    };
-
-    DataSet *dataSet = new DataSet();
-
-    db->executeQuery(Utils::implodeString(characterStateGroupQuery), dataSet);
-
-    if (dataSet->getRowCount() > 0) {
-        characterStateGroup = new CharacterStateGroup(dataSet->getRow(0)->getColumn("id")->getData()->asInteger(), db,
-                                                      character);
-    }
-
 }
 
-NovelSceneSegmentLine::~NovelSceneSegmentLine() {
-
+/**
+ * [NovelSceneSegmentLine::setFromImage Makes this a view of a line in the novel image]
+ * @param image  [The novel image]
+ * @param record [The line]
+ * @param group  [The line's character state group, which is not owned by the view]
+ */
+void NovelSceneSegmentLine::setFromImage(NovelImage *image, const NovelImageSegmentLine &record,
+                                         CharacterStateGroup *group) {
+    id = record.id;
+    characterId = record.characterId;
+    imageText = image->getString(record.text);
+    imageView = true;
+    overrideCharacterName = InternedString(image->getString(record.overrideCharacterName));
+    characterStateGroup = group;
 }
 
-std::string NovelSceneSegmentLine::getText() {
-    return text;
+/**
+ * [NovelSceneSegmentLine::getText Returns the line's text in the locale the novel is written in]
+ * @return [The text, valid for as long as the line is, or until a view is pointed at another line]
+ */
+std::string_view NovelSceneSegmentLine::getText() {
+    return imageView ? imageText : std::string_view(text);
 }
 
 int NovelSceneSegmentLine::getCharacterId() {
@@ -549,7 +1558,7 @@ int NovelSceneSegmentLine::getCharacterId() {
     }
 }
 
-std::string NovelSceneSegmentLine::getOverrideCharacterName() {
+InternedString NovelSceneSegmentLine::getOverrideCharacterName() {
     return overrideCharacterName;
 }
 
@@ -568,7 +1577,7 @@ ProjectInformation::ProjectInformation(DatabaseConnection *db) {
     // Gets information about the project and stores it
     DataSet *projectInformationDataSet = new DataSet();
 
-    db->executeQuery("SELECT * FROM game_information LIMIT 1;", projectInformationDataSet);
+    db->prepare("SELECT * FROM game_information LIMIT 1;")->execute(projectInformationDataSet);
 
     if (projectInformationDataSet->getRowCount() == 0) {
         return;
@@ -595,153 +1604,129 @@ ProjectInformation::ProjectInformation(DatabaseConnection *db) {
 }
 
 // Character sprite group stuff
-CharacterStateGroup::CharacterStateGroup(int myId, DatabaseConnection *db, Character *character[]) {
+CharacterStateGroup::CharacterStateGroup(int myId) {
     id = myId;
-
-    DataSet *dataSet = new DataSet();
-
-    std::vector<std::string> query = {
-            "SELECT * FROM character_states WHERE character_state_group_id = ",
-            std::to_string(id),
-            ";"
-    };
-
-    db->executeQuery(Utils::implodeString(query), dataSet);
-
-    int numberOfStates = dataSet->getRowCount();
-
-    if (numberOfStates > 0) {
-
-        for (int i = 0; i < numberOfStates; i++) {
-            characterState.push_back(
-                    new CharacterState(dataSet->getRow(i)->getColumn("id")->getData()->asInteger(), db, character));
-        }
-
-    }
-
-    delete (dataSet);
+    characterStateCount = 0;
 }
 
 CharacterStateGroup::~CharacterStateGroup() {
-
+    for (auto &state : characterState) {
+        delete state;
+    }
 }
 
 std::vector<CharacterState *> CharacterStateGroup::getCharacterStates() {
-    return characterState;
+    return std::vector<CharacterState *>(characterState.begin(), characterState.begin() + characterStateCount);
 }
 
-// Character state stuff
-CharacterState::CharacterState(int myId, DatabaseConnection *db, Character *character[]) {
-    id = myId;
-
-    std::vector<std::string> query = {
-            "SELECT * FROM character_states WHERE id = ",
-            std::to_string(id),
-            ";"
-    };
-
-    DataSet *dataSet = new DataSet();
-
-    db->executeQuery(Utils::implodeString(query), dataSet);
-
-    std::string characterSpriteId = dataSet->getRow(0)->getColumn("character_sprite_id")->getRawData();
-
-    if (dataSet->getRowCount() > 0) {
-
-        std::vector<std::string> query = {
-                "SELECT * FROM character_sprites WHERE id = ",
-                characterSpriteId,
-                ";"
-        };
-
-        auto *dataSet = new DataSet();
-
-        db->executeQuery(Utils::implodeString(query), dataSet);
-
-        if (dataSet->getRowCount() == 0) {
-            std::vector<std::string> error = {
-                    "Unable to find a character sprite with id ",
-                    characterSpriteId
-            };
-
-            throw ResourceException(Utils::implodeString(error));
-        }
-
-        int characterId = dataSet->getRow(0)->getColumn("character_id")->getData()->asInteger();
-        std::string characterSpriteName = dataSet->getRow(0)->getColumn("name")->getRawData();
-
-        characterSprite = character[characterId - 1]->getSprite(characterSpriteName);
-
-        if (!characterSprite) {
-            std::vector<std::string> error = {
-                    "Could not find sprite for character ",
-                    std::to_string(characterId),
-                    " with name: ",
-                    characterSpriteName
-            };
+void CharacterStateGroup::addCharacterState(CharacterState *state) {
+    characterState.push_back(state);
+    characterStateCount = characterState.size();
+}
 
-            throw ResourceException(Utils::implodeString(error));
-        }
+/**
+ * [CharacterStateGroup::setFromImage Makes this a view of a group in the novel image, its states are then set with
+ * setCharacterState. States are only allocated when the group has more of them than any group viewed before]
+ * @param record [The group]
+ */
+void CharacterStateGroup::setFromImage(const NovelImageCharacterStateGroup &record) {
+    id = record.id;
 
-        delete (dataSet);
+    while (characterState.size() < record.characterStateCount) {
+        characterState.push_back(new CharacterState(0, nullptr));
+    }
 
-    } else {
-        std::vector<std::string> error = {
-                "No character state with id ",
-                std::to_string(id),
-                " could be found."
-        };
+    characterStateCount = record.characterStateCount;
+}
 
-        throw DataSetException(Utils::implodeString(error));
-    }
+/**
+ * [CharacterStateGroup::setCharacterState Sets one of the states of a group being viewed]
+ * @param index   [Index of the state within the group]
+ * @param stateId [Id of the state]
+ * @param sprite  [The sprite it shows]
+ */
+void CharacterStateGroup::setCharacterState(uint32_t index, int stateId, CharacterSprite *sprite) {
+    characterState[index]->set(stateId, sprite);
+}
 
-    delete (dataSet);
+// Character state stuff
+CharacterState::CharacterState(int myId, CharacterSprite *sprite) {
+    id = myId;
+    characterSprite = sprite;
 }
 
 CharacterState::~CharacterState() {
 
 }
 
-// Music playback request stuff
-MusicPlaybackRequest::MusicPlaybackRequest(DatabaseConnection *db, int myId, std::string myMusicName, int musicPlaybackRequestMetadataId) {
+void CharacterState::set(int myId, CharacterSprite *sprite) {
     id = myId;
-    musicName = myMusicName;
-    metadata = nullptr;
-
-    auto *musicPlaybackRequestMetadataSet = new DataSet();
+    characterSprite = sprite;
+}
 
-    std::vector<std::string> query = {
-            "SELECT * FROM music_playback_request_metadata WHERE id = ",
-            std::to_string(musicPlaybackRequestMetadataId), ";"
-    };
+// Music playback request stuff
+MusicPlaybackRequest::MusicPlaybackRequest(int myId, std::string myMusicName,
+                                           MusicPlaybackRequestMetadata *requestMetadata) {
+    id = myId;
+    musicName = InternedString(myMusicName);
+    metadata = requestMetadata;
+}
 
-    db->executeQuery(Utils::implodeString(query), musicPlaybackRequestMetadataSet);
+MusicPlaybackRequest::~MusicPlaybackRequest() {
 
-    if (musicPlaybackRequestMetadataSet->getRowCount() == 1) {
-        metadata = new MusicPlaybackRequestMetadata(musicPlaybackRequestMetadataSet);
+    // A view's metadata is held within it
+    if (!imageMetadata) {
+        delete metadata;
     }
+}
 
-    delete(musicPlaybackRequestMetadataSet);
+/**
+ * [MusicPlaybackRequest::setFromImage Makes this a view of a request in the novel image]
+ * @param image  [The novel image]
+ * @param record [The request]
+ */
+void MusicPlaybackRequest::setFromImage(NovelImage *image, const NovelImageMusicPlaybackRequest &record) {
 
+    if (!imageMetadata) {
+        delete metadata;
+    }
 
+    id = record.id;
+    musicName = InternedString::find(image->getString(record.musicName));
+    imageMetadata.emplace(record.metadataId, record.pitch, record.volume, record.loop != 0, record.startTime,
+                          record.endTime, record.muted != 0);
+    metadata = record.hasMetadata ? &*imageMetadata : nullptr;
 }
 
 /**
  * Saves all of the data required for the metadata object
  * @param data
  */
-MusicPlaybackRequestMetadata::MusicPlaybackRequestMetadata(DataSet *data) {
-    // I have taken a different approach this time by simply passing the dataset into here
-    // Might be nicer to do this everywhere
+MusicPlaybackRequestMetadata::MusicPlaybackRequestMetadata(DataSetRow *data)
+        // I have taken a different approach this time by simply passing the row into here
+        // Might be nicer to do this everywhere
+        : MusicPlaybackRequestMetadata(data->getColumn("id")->getData()->asInteger(),
+                                       data->getColumn("pitch")->getData()->asFloat(),
+                                       data->getColumn("volume")->getData()->asInteger(),
+                                       data->getColumn("loop")->getData()->asBoolean(),
+                                       data->getColumn("startTime")->getData()->asInteger(),
+                                       data->getColumn("endTime")->getData()->asInteger(),
+                                       data->getColumn("muted")->getData()->asBoolean()) {
+}
+
+/**
+ * Saves the metadata values, as stored in the novel database or novel image
+ */
+MusicPlaybackRequestMetadata::MusicPlaybackRequestMetadata(int myId, float myPitch, int myVolume, bool shouldLoop,
+                                                           int startTime, int endTime, bool mute) {
 
     // TODO: Throw errors when values are out of range
-    id = data->getRow(0)->getColumn("id")->getData()->asInteger();
-    pitch = data->getRow(0)->getColumn("pitch")->getData()->asFloat();
-    volume = data->getRow(0)->getColumn("volume")->getData()->asInteger();
-    loop = data->getRow(0)->getColumn("loop")->getData()->asBoolean();
-    startInMilliseconds = data->getRow(0)->getColumn("startTime")->getData()->asInteger();
-    endInMilliseconds = data->getRow(0)->getColumn("endTime")->getData()->asInteger();
-    bool mute = data->getRow(0)->getColumn("muted")->getData()->asBoolean();
+    id = myId;
+    pitch = myPitch;
+    volume = myVolume;
+    loop = shouldLoop;
+    startInMilliseconds = startTime;
+    endInMilliseconds = endTime;
 
     // 1-10 are valid values, 5 is normal speed.
     if (pitch == 0) {
@@ -766,4 +1751,4 @@ MusicPlaybackRequestMetadata::MusicPlaybackRequestMetadata(DataSet *data) {
         throw ResourceException("startInMilliseconds must be greater than 0");
     }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include <algorithm>
+#include "VisualNovelEngine/Classes/Data/NovelBacklog.hpp"
+
+/**
+ * [NovelBacklog::NovelBacklog Creates an empty backlog, all of its memory is allocated here]
+ * @param entryCapacity [How many lines are kept]
+ */
+NovelBacklog::NovelBacklog(int entryCapacity) {
+    entries.resize(entryCapacity > 0 ? entryCapacity : 1, {0});
+    firstEntry = 0;
+    entryCount = 0;
+}
+
+/**
+ * [NovelBacklog::push Adds a line to the end of the backlog, replacing the oldest line once it is full]
+ * @param lineId [Id of the line]
+ */
+void NovelBacklog::push(int lineId) {
+
+    int capacity = static_cast<int>(entries.size());
+    int index = (firstEntry + entryCount) % capacity;
+
+    entries[index].lineId = lineId;
+
+    if (entryCount < capacity) {
+        entryCount++;
+    } else {
+        firstEntry = (firstEntry + 1) % capacity;
+    }
+}
+
+/**
+ * [NovelBacklog::removeNewest Removes lines from the end of the backlog, for when the story goes back to an earlier line]
+ * @param count [How many lines to remove]
+ */
+void NovelBacklog::removeNewest(int count) {
+    entryCount -= std::max(0, std::min(count, entryCount));
+}
+
+void NovelBacklog::clear() {
+    firstEntry = 0;
+    entryCount = 0;
+}
+
+/**
+ * [NovelBacklog::getEntry Returns one of the lines in the backlog]
+ * @param  index [0 for the oldest line, up to getEntryCount() - 1 for the newest]
+ * @return       [The entry]
+ */
+const NovelBacklogEntry &NovelBacklog::getEntry(int index) {
+    return entries[(firstEntry + index) % static_cast<int>(entries.size())];
+}
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include "VisualNovelEngine/Classes/Data/NovelFlags.hpp"
+
+NovelFlags::NovelFlags() : NovelFlags(0, 0) {
+}
+
+/**
+ * [NovelFlags::NovelFlags Creates a store with every flag cleared and every counter at 0]
+ * @param flagCount    [How many flags the novel declares]
+ * @param counterCount [How many counters the novel declares]
+ */
+NovelFlags::NovelFlags(int flagCount, int counterCount) {
+    this->flagCount = std::max(flagCount, 0);
+    flagWords.resize((this->flagCount + 63) / 64, 0);
+    counters.resize(std::max(counterCount, 0), 0);
+}
+
+void NovelFlags::set(int flag, bool value) {
+
+    uint64_t bit = uint64_t(1) << (flag & 63);
+
+    if (value) {
+        flagWords[flag >> 6] |= bit;
+    } else {
+        flagWords[flag >> 6] &= ~bit;
+    }
+}
+
+void NovelFlags::setCounter(int counter, int value) {
+    counters[counter] = value;
+}
+
+/**
+ * [NovelFlags::apply Makes a change to a flag or counter]
+ * @param  change [The change, its operand must be a flag or counter this store has]
+ * @return        [The change which undoes it]
+ */
+NovelFlagChange NovelFlags::apply(const NovelFlagChange &change) {
+
+    if (change.operation == NOVEL_FLAG_CHANGE_SET_FLAG) {
+        NovelFlagChange undo = {NOVEL_FLAG_CHANGE_SET_FLAG, change.operand, isSet(change.operand) ? 1 : 0};
+        set(change.operand, change.value != 0);
+
+        return undo;
+    }
+
+    NovelFlagChange undo = {NOVEL_FLAG_CHANGE_SET_COUNTER, change.operand, getCounter(change.operand)};
+
+    if (change.operation == NOVEL_FLAG_CHANGE_ADD_COUNTER) {
+        // Wraps rather than overflowing, counters are expected to stay well within range
+        setCounter(change.operand, static_cast<int32_t>(static_cast<uint32_t>(undo.value) + static_cast<uint32_t>(change.value)));
+    } else {
+        setCounter(change.operand, change.value);
+    }
+
+    return undo;
+}
+
+/**
+ * [NovelFlags::assign Replaces every flag and counter, such as with the ones in a save. Values the store doesn't have
+ * are ignored, and any it has which aren't given keep their current value]
+ * @param words         [The flags, 64 to a word]
+ * @param counterValues [The counters]
+ */
+void NovelFlags::assign(const std::vector<uint64_t> &words, const std::vector<int32_t> &counterValues) {
+
+    size_t wordCount = std::min(words.size(), flagWords.size());
+    std::copy(words.begin(), words.begin() + wordCount, flagWords.begin());
+
+    // Bits past the last flag are kept clear
+    if (flagCount % 64 != 0 && wordCount == flagWords.size()) {
+        flagWords.back() &= (uint64_t(1) << (flagCount % 64)) - 1;
+    }
+
+    size_t counterCount = std::min(counterValues.size(), counters.size());
+    std::copy(counterValues.begin(), counterValues.begin() + counterCount, counters.begin());
+}
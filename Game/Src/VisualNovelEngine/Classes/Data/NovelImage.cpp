@@ -0,0 +1,167 @@
+#include <cstring>
+#include <vector>
+#include "Misc/Utils.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelImage.hpp"
+#include <Exceptions/ResourceException.hpp>
+
+/**
+ * [NovelImage::NovelImage Maps a novel image into memory]
+ * @param path [Path of the image]
+ */
+NovelImage::NovelImage(const std::string &path) {
+    imagePath = path;
+    file = new MappedFile(path);
+    data = file->getData();
+    size = file->getSize();
+    header = reinterpret_cast<const NovelImageHeader *>(data);
+
+    try {
+        checkHeader();
+    } catch (ResourceException &e) {
+        delete file;
+        throw;
+    }
+}
+
+NovelImage::~NovelImage() {
+    delete file;
+}
+
+const NovelImageChapter &NovelImage::getChapter(uint32_t index) {
+    return getRecord<NovelImageChapter>(header->chapters, index, "chapters");
+}
+
+const NovelImageScene &NovelImage::getScene(uint32_t index) {
+    return getRecord<NovelImageScene>(header->scenes, index, "scenes");
+}
+
+const NovelImageSceneSegment &NovelImage::getSceneSegment(uint32_t index) {
+    return getRecord<NovelImageSceneSegment>(header->sceneSegments, index, "scene_segments");
+}
+
+const NovelImageSegmentLine &NovelImage::getSegmentLine(uint32_t index) {
+    return getRecord<NovelImageSegmentLine>(header->segmentLines, index, "segment_lines");
+}
+
+/**
+ * [NovelImage::getSegmentLineIndex Finds a line by its id]
+ * @param  lineId [Id of the line]
+ * @return        [Index of the line, or NOVEL_IMAGE_NO_INDEX if the novel has no such line]
+ */
+uint32_t NovelImage::getSegmentLineIndex(int lineId) {
+
+    if (lineId < 0 || static_cast<uint32_t>(lineId) >= header->segmentLineIndexById.count) {
+        return NOVEL_IMAGE_NO_INDEX;
+    }
+
+    return reinterpret_cast<const uint32_t *>(data + header->segmentLineIndexById.offset)[lineId];
+}
+
+const NovelImageCharacterStateGroup &NovelImage::getCharacterStateGroup(uint32_t index) {
+    return getRecord<NovelImageCharacterStateGroup>(header->characterStateGroups, index, "character_state_groups");
+}
+
+const NovelImageCharacterState &NovelImage::getCharacterState(uint32_t index) {
+    return getRecord<NovelImageCharacterState>(header->characterStates, index, "character_states");
+}
+
+const NovelImageMusicPlaybackRequest &NovelImage::getMusicPlaybackRequest(uint32_t index) {
+    return getRecord<NovelImageMusicPlaybackRequest>(header->musicPlaybackRequests, index, "music_playback_requests");
+}
+
+/**
+ * [NovelImage::findSceneSegmentJump Finds where the story goes after a scene segment]
+ * @param  sceneSegmentId [Id of the segment]
+ * @return                [The jump, or nullptr if the novel has no such segment]
+ */
+const NovelImageSceneSegmentJump *NovelImage::findSceneSegmentJump(int sceneSegmentId) {
+
+    if (sceneSegmentId < 0 || static_cast<uint32_t>(sceneSegmentId) >= header->sceneSegmentJumps.count) {
+        return nullptr;
+    }
+
+    return &reinterpret_cast<const NovelImageSceneSegmentJump *>(data + header->sceneSegmentJumps.offset)[sceneSegmentId];
+}
+
+/**
+ * [NovelImage::getString Returns a string from the string blob without copying it]
+ * @param  imageString [Location of the string]
+ * @return             [The string, valid for as long as the image is]
+ */
+std::string_view NovelImage::getString(const NovelImageString &imageString) {
+
+    if (static_cast<uint64_t>(imageString.offset) + imageString.length > header->strings.count) {
+        std::vector<std::string> error = {
+                "The novel image '", imagePath, "' contains a string outside of its string blob"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    return std::string_view(data + header->strings.offset + imageString.offset, imageString.length);
+}
+
+/**
+ * [NovelImage::checkHeader Checks that the image was written by a compatible compiler, and that every table is within the file]
+ */
+void NovelImage::checkHeader() {
+
+    if (size < sizeof(NovelImageHeader) || std::memcmp(header->magic, NOVEL_IMAGE_MAGIC, NOVEL_IMAGE_MAGIC_LENGTH) != 0) {
+        std::vector<std::string> error = {
+                "'", imagePath, "' is not a novel image"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    if (header->version != NOVEL_IMAGE_VERSION || header->byteOrderMark != NOVEL_IMAGE_BYTE_ORDER_MARK
+        || header->headerSize != sizeof(NovelImageHeader)) {
+        std::vector<std::string> error = {
+                "The novel image '", imagePath, "' was written by an incompatible version of the compiler (image version ",
+                std::to_string(header->version), ", expected ", std::to_string(NOVEL_IMAGE_VERSION), ")"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    if (header->fileSize != size) {
+        std::vector<std::string> error = {
+                "The novel image '", imagePath, "' is ", std::to_string(size), " bytes, but should be ",
+                std::to_string(header->fileSize), " bytes"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    checkTable(header->chapters, sizeof(NovelImageChapter), "chapters");
+    checkTable(header->scenes, sizeof(NovelImageScene), "scenes");
+    checkTable(header->sceneSegments, sizeof(NovelImageSceneSegment), "scene_segments");
+    checkTable(header->segmentLines, sizeof(NovelImageSegmentLine), "segment_lines");
+    checkTable(header->segmentLineIndexById, sizeof(uint32_t), "segment_line_index_by_id");
+    checkTable(header->characterStateGroups, sizeof(NovelImageCharacterStateGroup), "character_state_groups");
+    checkTable(header->characterStates, sizeof(NovelImageCharacterState), "character_states");
+    checkTable(header->musicPlaybackRequests, sizeof(NovelImageMusicPlaybackRequest), "music_playback_requests");
+    checkTable(header->sceneSegmentJumps, sizeof(NovelImageSceneSegmentJump), "scene_segment_jumps");
+    checkTable(header->strings, 1, "strings");
+}
+
+void NovelImage::checkTable(const NovelImageTable &table, size_t recordSize, const std::string &tableName) {
+
+    if (table.offset % NOVEL_IMAGE_TABLE_ALIGNMENT != 0
+        || static_cast<uint64_t>(table.offset) + static_cast<uint64_t>(table.count) * recordSize > size) {
+        std::vector<std::string> error = {
+                "The table '", tableName, "' of the novel image '", imagePath, "' is outside of the file"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+}
+
+template<typename Record>
+const Record &NovelImage::getRecord(const NovelImageTable &table, uint32_t index, const char *tableName) {
+
+    if (index >= table.count) {
+        std::vector<std::string> error = {
+                "The novel image '", imagePath, "' refers to record ", std::to_string(index), " of the table '",
+                tableName, "', which only has ", std::to_string(table.count), " records"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    return reinterpret_cast<const Record *>(data + table.offset)[index];
+}
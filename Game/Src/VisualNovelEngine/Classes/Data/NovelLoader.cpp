@@ -0,0 +1,849 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <future>
+#include <exception>
+#include "Misc/Utils.hpp"
+#include "Database/QueryCursor.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelLoader.hpp"
+#include <Exceptions/ResourceException.hpp>
+
+// Each state is joined to its sprite so that both are read at once
+#define CHARACTER_STATE_QUERY "SELECT character_states.id, character_states.character_state_group_id, " \
+    "character_states.character_sprite_id, character_sprites.id, character_sprites.character_id, character_sprites.name " \
+    "FROM character_states " \
+    "LEFT JOIN character_sprites ON character_sprites.id = character_states.character_sprite_id "
+
+// Ids of the character state groups used by the lines of one scene, the scene id is bound to it
+#define SCENE_CHARACTER_STATE_GROUPS_QUERY "SELECT segment_lines.character_state_group_id FROM segment_lines " \
+    "JOIN scene_segments ON scene_segments.id = segment_lines.scene_segment_id WHERE scene_segments.scene_id = ?"
+
+/**
+ * [NovelLoader::NovelLoader Prepares to load a novel, the characters must already have been loaded]
+ * @param db              [Connection to the novel database]
+ * @param novelCharacters [The novel's characters, used to find the sprite for each character state]
+ */
+NovelLoader::NovelLoader(DatabaseConnection *db, std::vector<Character *> *novelCharacters) {
+    novelDb = db;
+    character = novelCharacters;
+    lineTextLoaded = true;
+}
+
+NovelLoader::~NovelLoader() {
+
+    // Only the groups which were never taken by the novel are still owned by the loader
+    for (auto &characterStateGroup : characterStateGroups) {
+        delete characterStateGroup;
+    }
+}
+
+/**
+ * [NovelLoader::load Reads every chapter, scene, segment and line. Parents are always loaded before their children]
+ * @param progress [Where the progress of the load is reported, one step per table. May be nullptr]
+ */
+void NovelLoader::load(LoadingProgress *progress) {
+
+    auto step = [progress](const std::string &description) {
+        if (progress) {
+            progress->completeStep();
+            progress->beginStep(description);
+        }
+    };
+
+    if (progress) {
+        progress->addSteps(6);
+        progress->beginStep("Reading character states");
+    }
+
+    loadCharacterStateGroups(novelDb->prepare("SELECT id FROM character_state_groups ORDER BY id;"),
+                             novelDb->prepare(CHARACTER_STATE_QUERY "ORDER BY character_states.character_state_group_id, character_states.id;"));
+    step("Reading music");
+    loadMusicPlaybackRequests();
+    step("Reading chapters");
+    loadChapters();
+    step("Reading scenes");
+    loadScenes();
+    step("Reading scene segments");
+    loadSceneSegments(novelDb->prepare("SELECT * FROM scene_segments ORDER BY scene_id, id;"));
+    step("Reading lines");
+    loadLines(novelDb->prepare("SELECT * FROM segment_lines ORDER BY scene_segment_id, id;"));
+
+    if (progress) {
+        progress->completeStep();
+    }
+}
+
+/**
+ * [NovelLoader::loadInParallel Reads the whole novel as load() does, with the chapters shared out between several
+ * threads. Chapters are taken in order by whichever thread is free, so one long chapter doesn't hold up the others]
+ * @param pool        [Pool the loader's connection came from, each other thread checks out its own connection from it]
+ * @param threadCount [Most threads to load with, including this one. Fewer are used if the pool has no free connections]
+ * @param progress    [Where the progress of the load is reported, one step per chapter. May be nullptr]
+ */
+void NovelLoader::loadInParallel(DatabaseConnectionPool *pool, int threadCount, LoadingProgress *progress) {
+
+    if (progress) {
+        progress->addSteps(3);
+        progress->beginStep("Reading character states");
+    }
+
+    loadCharacterStateGroups(novelDb->prepare("SELECT id FROM character_state_groups ORDER BY id;"),
+                             novelDb->prepare(CHARACTER_STATE_QUERY "ORDER BY character_states.character_state_group_id, character_states.id;"));
+
+    if (progress) {
+        progress->completeStep();
+        progress->beginStep("Reading music");
+    }
+
+    loadMusicPlaybackRequests();
+
+    if (progress) {
+        progress->completeStep();
+        progress->beginStep("Reading chapters");
+    }
+
+    loadChapters();
+
+    if (progress) {
+        progress->completeStep();
+        progress->addSteps(static_cast<int>(chapters.size()));
+        progress->beginStep("Reading scenes");
+    }
+
+    std::atomic<size_t> nextChapter(0);
+    std::atomic<bool> failed(false);
+
+    auto loadNextChapters = [this, &nextChapter, &failed, progress](NovelLoader *chapterLoader) {
+        try {
+            for (size_t i = nextChapter++; i < chapters.size() && !failed; i = nextChapter++) {
+                chapterLoader->loadChapterScenes(chapters[i]);
+
+                if (progress) {
+                    progress->completeStep();
+                }
+            }
+        } catch (...) {
+            failed = true;
+            throw;
+        }
+    };
+
+    int helperCount = std::min(threadCount, static_cast<int>(chapters.size())) - 1;
+    std::vector<std::future<void>> helpers;
+
+    for (int i = 0; i < helperCount; i++) {
+        helpers.push_back(std::async(std::launch::async, [this, pool, &loadNextChapters] {
+
+            // Waiting for a connection could wait forever if this thread's own connection is the last in the pool
+            PooledConnection connection = pool->tryCheckout();
+
+            if (!connection.get()) {
+                return;
+            }
+
+            NovelLoader chapterLoader(connection.get(), character);
+
+            // The groups stay owned by this loader, the helper only looks them up
+            chapterLoader.characterStateGroupsById = characterStateGroupsById;
+            chapterLoader.lineTextLoaded = lineTextLoaded;
+            chapterLoader.loadMusicPlaybackRequests();
+
+            loadNextChapters(&chapterLoader);
+        }));
+    }
+
+    std::exception_ptr error;
+
+    try {
+        loadNextChapters(this);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // Every helper must have finished with the chapters before they are handed over, even if one of them failed
+    for (auto &helper : helpers) {
+        try {
+            helper.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * [NovelLoader::loadChapterIndex Reads the chapters and the ids of their scenes without loading the scenes, which are then read with loadScene]
+ */
+void NovelLoader::loadChapterIndex() {
+    loadMusicPlaybackRequests();
+    loadChapters();
+    loadSceneIndexes();
+}
+
+/**
+ * [NovelLoader::loadSceneIndexes Reads the ids of the scenes in every chapter, in the order they are numbered within the chapter]
+ */
+void NovelLoader::loadSceneIndexes() {
+
+    QueryCursor sceneData(novelDb->prepare("SELECT id, chapter_id FROM scenes ORDER BY chapter_id, id;"));
+
+    int currentChapterId = -1;
+    std::vector<int> sceneIds;
+
+    auto setSceneIndex = [this, &currentChapterId, &sceneIds]() {
+        auto chapter = chaptersById.find(currentChapterId);
+
+        if (chapter != chaptersById.end()) {
+            chapter->second->setSceneIndex(sceneIds);
+        }
+
+        sceneIds.clear();
+    };
+
+    while (sceneData.next()) {
+
+        int chapterId = sceneData.getInteger(1);
+
+        if (chapterId != currentChapterId) {
+            setSceneIndex();
+            currentChapterId = chapterId;
+        }
+
+        sceneIds.push_back(sceneData.getInteger(0));
+    }
+
+    setSceneIndex();
+}
+
+/**
+ * [NovelLoader::loadChapterScenes Reads the scenes of a chapter, and all of their segments and lines. The character
+ * state groups and music playback requests must already have been loaded]
+ * @param chapter [The chapter, its scenes are added to it]
+ */
+void NovelLoader::loadChapterScenes(NovelChapter *chapter) {
+
+    scenesById.clear();
+    segmentsById.clear();
+
+    int firstSceneId = INT_MAX;
+    int lastSceneId = INT_MIN;
+    {
+        QueryCursor sceneData(novelDb->prepare("SELECT * FROM scenes WHERE chapter_id = ? ORDER BY id;")
+                                      ->bind(1, chapter->getId()));
+
+        if (!sceneData.doesColumnExist("id")) {
+            return;
+        }
+
+        while (sceneData.next()) {
+            auto *newScene = new NovelScene(&sceneData);
+
+            chapter->addScene(newScene);
+            scenesById[newScene->getId()] = newScene;
+
+            firstSceneId = std::min(firstSceneId, newScene->getId());
+            lastSceneId = std::max(lastSceneId, newScene->getId());
+        }
+    }
+
+    if (scenesById.empty()) {
+        return;
+    }
+
+    // The compiler writes a chapter's scenes, segments and lines together, so each chapter's ids form a range that can
+    // be read straight from the parent id indexes. Anything in the range belonging to another chapter has no parent here
+    // and is skipped
+    loadSceneSegments(novelDb->prepare("SELECT * FROM scene_segments WHERE scene_id BETWEEN ? AND ? ORDER BY scene_id, id;")
+                              ->bind(1, firstSceneId)->bind(2, lastSceneId));
+
+    int firstSegmentId = INT_MAX;
+    int lastSegmentId = INT_MIN;
+
+    for (auto &segment : segmentsById) {
+        firstSegmentId = std::min(firstSegmentId, segment.first);
+        lastSegmentId = std::max(lastSegmentId, segment.first);
+    }
+
+    if (segmentsById.empty()) {
+        return;
+    }
+
+    loadLines(novelDb->prepare("SELECT * FROM segment_lines WHERE scene_segment_id BETWEEN ? AND ? ORDER BY scene_segment_id, id;")
+                      ->bind(1, firstSegmentId)->bind(2, lastSegmentId));
+}
+
+/**
+ * [NovelLoader::loadJumps Reads where the story goes after each scene segment]
+ * @param jumps [Filled with the jumps, indexed by the id of the segment they follow]
+ */
+void NovelLoader::loadJumps(std::vector<NovelJump> &jumps) {
+
+    QueryCursor jumpData(novelDb->prepare(
+            "SELECT scene_segment_id, chapter_index, scene_index, scene_segment_index FROM scene_segment_jumps "
+            "ORDER BY scene_segment_id;"));
+
+    while (jumpData.next()) {
+
+        int sceneSegmentId = jumpData.getInteger(0);
+
+        if (sceneSegmentId < 0) {
+            continue;
+        }
+
+        if (sceneSegmentId >= static_cast<int>(jumps.size())) {
+            jumps.resize(sceneSegmentId + 1, {-1, -1, -1});
+        }
+
+        jumps[sceneSegmentId] = {jumpData.getInteger(1), jumpData.getInteger(2), jumpData.getInteger(3)};
+    }
+}
+
+/**
+ * [NovelLoader::loadBranches Reads the branches of every scene segment, in the order they are checked]
+ * @param branches    [Filled with the branches, grouped by the segment they belong to]
+ * @param firstBranch [Filled with the index of each segment's first branch, indexed by the id of the segment. A
+ *                     segment's branches end where the next segment's start, the last entry is where they all end]
+ */
+void NovelLoader::loadBranches(std::vector<NovelBranch> &branches, std::vector<uint32_t> &firstBranch) {
+
+    QueryCursor branchData(novelDb->prepare(
+            "SELECT scene_segment_id, requirement_id, chapter_index, scene_index, scene_segment_index "
+            "FROM scene_segment_branches ORDER BY scene_segment_id, id;"));
+
+    while (branchData.next()) {
+
+        int sceneSegmentId = branchData.getInteger(0);
+
+        if (sceneSegmentId < 0) {
+            continue;
+        }
+
+        while (static_cast<int>(firstBranch.size()) <= sceneSegmentId) {
+            firstBranch.push_back(static_cast<uint32_t>(branches.size()));
+        }
+
+        branches.push_back({branchData.getInteger(1),
+                            {branchData.getInteger(2), branchData.getInteger(3), branchData.getInteger(4)}});
+    }
+
+    firstBranch.push_back(static_cast<uint32_t>(branches.size()));
+}
+
+/**
+ * [NovelLoader::loadFlags Reads the flags and counters the novel declares, with their values at the start of the story]
+ * @param flags [Replaced with the flags and counters]
+ */
+void NovelLoader::loadFlags(NovelFlags &flags) {
+
+    std::vector<std::pair<int, int>> flagDefaults;
+    std::vector<std::pair<int, int>> counterDefaults;
+
+    QueryCursor flagData(novelDb->prepare("SELECT counter, flag_index, default_value FROM flags;"));
+
+    while (flagData.next()) {
+        auto &defaults = flagData.getBoolean(0) ? counterDefaults : flagDefaults;
+        defaults.emplace_back(flagData.getInteger(1), flagData.getInteger(2));
+    }
+
+    // Indices are given by the compiler without gaps, so there is one more of each than the highest index
+    int flagCount = 0;
+    int counterCount = 0;
+
+    for (auto &flag : flagDefaults) {
+        flagCount = std::max(flagCount, flag.first + 1);
+    }
+
+    for (auto &counter : counterDefaults) {
+        counterCount = std::max(counterCount, counter.first + 1);
+    }
+
+    flags = NovelFlags(flagCount, counterCount);
+
+    for (auto &flag : flagDefaults) {
+        if (flag.first >= 0) {
+            flags.set(flag.first, flag.second != 0);
+        }
+    }
+
+    for (auto &counter : counterDefaults) {
+        if (counter.first >= 0) {
+            flags.setCounter(counter.first, counter.second);
+        }
+    }
+}
+
+/**
+ * [NovelLoader::loadRequirements Reads the terms of every requirement]
+ * @param requirements [Where the terms are added]
+ */
+void NovelLoader::loadRequirements(NovelRequirements &requirements) {
+
+    QueryCursor termData(novelDb->prepare(
+            "SELECT requirement_id, opcode, operand, value FROM requirement_terms ORDER BY requirement_id, id;"));
+
+    while (termData.next()) {
+        requirements.addTerm(termData.getInteger(0), {termData.getInteger(1), termData.getInteger(2),
+                                                      termData.getInteger(3)});
+    }
+}
+
+/**
+ * [NovelLoader::loadChapterRequirements Reads whether each chapter is hidden and the requirement it has]
+ * @param chapterRequirements [Filled with the requirements, in the same order as the chapters]
+ */
+void NovelLoader::loadChapterRequirements(std::vector<NovelChapterRequirement> &chapterRequirements) {
+
+    QueryCursor chapterData(novelDb->prepare("SELECT hidden, requirement_id FROM chapters ORDER BY id;"));
+
+    while (chapterData.next()) {
+        chapterRequirements.push_back({chapterData.getBoolean(0), chapterData.getInteger(1)});
+    }
+}
+
+/**
+ * [NovelLoader::loadFlagChanges Reads the flag and counter changes made as each scene segment starts]
+ * @param flagChanges     [Filled with the changes, grouped by segment in the order they are made]
+ * @param firstFlagChange [Filled with the index of each segment's first change, indexed by the id of the segment in
+ *                         the same way as the branches of loadBranches]
+ */
+void NovelLoader::loadFlagChanges(std::vector<NovelFlagChange> &flagChanges, std::vector<uint32_t> &firstFlagChange) {
+
+    QueryCursor changeData(novelDb->prepare(
+            "SELECT scene_segment_id, operation, operand, value FROM scene_segment_flag_changes "
+            "ORDER BY scene_segment_id, id;"));
+
+    while (changeData.next()) {
+
+        int sceneSegmentId = changeData.getInteger(0);
+
+        if (sceneSegmentId < 0) {
+            continue;
+        }
+
+        while (static_cast<int>(firstFlagChange.size()) <= sceneSegmentId) {
+            firstFlagChange.push_back(static_cast<uint32_t>(flagChanges.size()));
+        }
+
+        flagChanges.push_back({changeData.getInteger(1), changeData.getInteger(2), changeData.getInteger(3)});
+    }
+
+    firstFlagChange.push_back(static_cast<uint32_t>(flagChanges.size()));
+}
+
+/**
+ * [NovelLoader::loadSegmentScripts Reads the name of the script each scene segment starts]
+ * @param segmentScripts [Filled with the names, indexed by the id of the segment. A segment which starts no script
+ *                        has an empty name, or is past the end]
+ */
+void NovelLoader::loadSegmentScripts(std::vector<InternedString> &segmentScripts) {
+
+    QueryCursor scriptData(novelDb->prepare("SELECT scene_segment_id, script_name FROM scene_segment_scripts;"));
+
+    while (scriptData.next()) {
+
+        int sceneSegmentId = scriptData.getInteger(0);
+
+        if (sceneSegmentId < 0) {
+            continue;
+        }
+
+        if (static_cast<int>(segmentScripts.size()) <= sceneSegmentId) {
+            segmentScripts.resize(sceneSegmentId + 1);
+        }
+
+        segmentScripts[sceneSegmentId] = InternedString(scriptData.getText(1));
+    }
+}
+
+/**
+ * [NovelLoader::loadScene Reads a single scene, and all of its segments and lines. This may be called from another
+ * thread, as long as nothing else is using the loader at the same time]
+ * @param  sceneId [Id of the scene]
+ * @return         [The scene, or nullptr if it does not exist. Its lines point to character state groups kept by the
+ *                  loader until the scene is released]
+ */
+NovelScene *NovelLoader::loadScene(int sceneId) {
+
+    // Character state groups are kept between scenes, as the compiler shares each group between every line using it
+    releaseScene(sceneId);
+    scenesById.clear();
+    segmentsById.clear();
+
+    NovelScene *loadedScene = nullptr;
+    {
+        QueryCursor sceneData(novelDb->prepare("SELECT * FROM scenes WHERE id = ?;")->bind(1, sceneId));
+
+        if (sceneData.next()) {
+            loadedScene = new NovelScene(&sceneData);
+            scenesById[sceneId] = loadedScene;
+        }
+    }
+
+    if (!loadedScene) {
+        return nullptr;
+    }
+
+    std::vector<int> &groupIds = sceneCharacterStateGroupIds[sceneId];
+
+    groupIds = loadCharacterStateGroups(
+            novelDb->prepare("SELECT id FROM character_state_groups WHERE id IN (" SCENE_CHARACTER_STATE_GROUPS_QUERY ") ORDER BY id;")
+                    ->bind(1, sceneId),
+            novelDb->prepare(CHARACTER_STATE_QUERY "WHERE character_states.character_state_group_id IN (" SCENE_CHARACTER_STATE_GROUPS_QUERY ") "
+                             "ORDER BY character_states.character_state_group_id, character_states.id;")
+                    ->bind(1, sceneId));
+
+    for (auto &groupId : groupIds) {
+        characterStateGroupUseCounts[groupId]++;
+    }
+
+    loadSceneSegments(novelDb->prepare("SELECT * FROM scene_segments WHERE scene_id = ? ORDER BY id;")->bind(1, sceneId));
+    loadLines(novelDb->prepare("SELECT segment_lines.* FROM segment_lines "
+                               "JOIN scene_segments ON scene_segments.id = segment_lines.scene_segment_id "
+                               "WHERE scene_segments.scene_id = ? "
+                               "ORDER BY segment_lines.scene_segment_id, segment_lines.id;")->bind(1, sceneId));
+
+    return loadedScene;
+}
+
+/**
+ * [NovelLoader::releaseScene Deletes the character state groups which only a released scene was using, the scene
+ * itself is deleted by its chapter. Must not be called while the scene is being loaded]
+ * @param sceneId [Id of the scene]
+ */
+void NovelLoader::releaseScene(int sceneId) {
+
+    auto scene = sceneCharacterStateGroupIds.find(sceneId);
+
+    if (scene == sceneCharacterStateGroupIds.end()) {
+        return;
+    }
+
+    for (auto &groupId : scene->second) {
+        auto useCount = characterStateGroupUseCounts.find(groupId);
+
+        if (useCount == characterStateGroupUseCounts.end() || --useCount->second > 0) {
+            continue;
+        }
+
+        characterStateGroupUseCounts.erase(useCount);
+
+        auto group = characterStateGroupsById.find(groupId);
+
+        if (group == characterStateGroupsById.end()) {
+            continue;
+        }
+
+        characterStateGroups.erase(std::find(characterStateGroups.begin(), characterStateGroups.end(), group->second));
+        delete group->second;
+        characterStateGroupsById.erase(group);
+    }
+
+    sceneCharacterStateGroupIds.erase(scene);
+}
+
+/**
+ * [NovelLoader::loadCharacterStateGroups Reads the character state groups which have not already been loaded. Groups are
+ * never changed once loaded, so every line using a group shares the same instance]
+ * @param  groupQuery [Query for the ids of the groups]
+ * @param  stateQuery [Query for the states of the groups, ordered by group]
+ * @return            [The id of every group the group query returned, including those which were already loaded]
+ */
+std::vector<int> NovelLoader::loadCharacterStateGroups(PreparedStatement *groupQuery, PreparedStatement *stateQuery) {
+
+    std::vector<int> groupIds;
+    std::unordered_map<int, CharacterStateGroup *> loadedGroups;
+    QueryCursor groupData(groupQuery);
+
+    while (groupData.next()) {
+        int groupId = groupData.getInteger(0);
+        groupIds.push_back(groupId);
+
+        if (characterStateGroupsById.count(groupId)) {
+            continue;
+        }
+
+        auto *group = new CharacterStateGroup(groupId);
+
+        characterStateGroups.push_back(group);
+        characterStateGroupsById[groupId] = group;
+        loadedGroups[groupId] = group;
+    }
+
+    QueryCursor stateData(stateQuery);
+
+    int currentGroupId = -1;
+    CharacterStateGroup *currentGroup = nullptr;
+
+    while (stateData.next()) {
+
+        int groupId = stateData.getInteger(1);
+
+        if (groupId != currentGroupId) {
+            auto group = loadedGroups.find(groupId);
+
+            currentGroupId = groupId;
+            currentGroup = group != loadedGroups.end() ? group->second : nullptr;
+        }
+
+        // States in a group which doesn't exist can never be shown, and those of an already loaded group are already in it
+        if (!currentGroup) {
+            continue;
+        }
+
+        if (stateData.isNull(3)) {
+            std::vector<std::string> error = {
+                    "Unable to find a character sprite with id ",
+                    stateData.getString(2)
+            };
+
+            throw ResourceException(Utils::implodeString(error));
+        }
+
+        CharacterSprite *sprite = findCharacterSprite(stateData.getInteger(4), stateData.getString(5));
+
+        currentGroup->addCharacterState(new CharacterState(stateData.getInteger(0), sprite));
+    }
+
+    return groupIds;
+}
+
+void NovelLoader::loadMusicPlaybackRequests() {
+
+    novelDb->prepare("SELECT * FROM music_playback_requests;")->execute(&musicPlaybackRequests);
+    novelDb->prepare("SELECT * FROM music_playback_request_metadata;")->execute(&musicPlaybackRequestMetadata);
+
+    for (int i = 0; i < musicPlaybackRequests.getRowCount(); i++) {
+        musicPlaybackRequestRows[musicPlaybackRequests.getRow(i)->getColumn("id")->getData()->asInteger()] = i;
+    }
+
+    for (int i = 0; i < musicPlaybackRequestMetadata.getRowCount(); i++) {
+        musicPlaybackRequestMetadataRows[musicPlaybackRequestMetadata.getRow(i)->getColumn("id")->getData()->asInteger()] = i;
+    }
+}
+
+void NovelLoader::loadChapters() {
+
+    QueryCursor chapterData(novelDb->prepare("SELECT * FROM chapters ORDER BY id;"));
+
+    // Both columns are required for a chapter to be loaded
+    if (!chapterData.doesColumnExist("id") || !chapterData.doesColumnExist("title")) {
+        return;
+    }
+
+    int chapterIdColumn = chapterData.getColumnIndex("id");
+    int chapterTitleColumn = chapterData.getColumnIndex("title");
+
+    while (chapterData.next()) {
+        auto *newChapter = new NovelChapter(chapterData.getString(chapterTitleColumn),
+                                            chapterData.getInteger(chapterIdColumn));
+
+        chapters.push_back(newChapter);
+        chaptersById[newChapter->getId()] = newChapter;
+    }
+}
+
+void NovelLoader::loadScenes() {
+
+    QueryCursor sceneData(novelDb->prepare("SELECT * FROM scenes ORDER BY chapter_id, id;"));
+
+    if (!sceneData.doesColumnExist("id")) {
+        return;
+    }
+
+    int chapterIdColumn = sceneData.getColumnIndex("chapter_id");
+    int currentChapterId = -1;
+    NovelChapter *currentChapter = nullptr;
+
+    while (sceneData.next()) {
+
+        int chapterId = sceneData.getInteger(chapterIdColumn);
+
+        if (chapterId != currentChapterId) {
+            auto parent = chaptersById.find(chapterId);
+
+            currentChapterId = chapterId;
+            currentChapter = parent != chaptersById.end() ? parent->second : nullptr;
+        }
+
+        if (!currentChapter) {
+            continue;
+        }
+
+        auto *newScene = new NovelScene(&sceneData);
+
+        currentChapter->addScene(newScene);
+        scenesById[newScene->getId()] = newScene;
+    }
+}
+
+void NovelLoader::loadSceneSegments(PreparedStatement *segmentQuery) {
+
+    QueryCursor segmentData(segmentQuery);
+
+    if (!segmentData.doesColumnExist("id")) {
+        return;
+    }
+
+    int idColumn = segmentData.getColumnIndex("id");
+    int sceneIdColumn = segmentData.getColumnIndex("scene_id");
+    int visualEffectNameColumn = segmentData.getColumnIndex("visual_effect_name");
+    int musicPlaybackRequestIdColumn = segmentData.getColumnIndex("music_playback_request_id");
+
+    int currentSceneId = -1;
+    NovelScene *currentScene = nullptr;
+
+    while (segmentData.next()) {
+
+        int sceneId = segmentData.getInteger(sceneIdColumn);
+
+        if (sceneId != currentSceneId) {
+            auto parent = scenesById.find(sceneId);
+
+            currentSceneId = sceneId;
+            currentScene = parent != scenesById.end() ? parent->second : nullptr;
+        }
+
+        if (!currentScene) {
+            continue;
+        }
+
+        std::string visualEffectName = visualEffectNameColumn != -1
+                                       ? segmentData.getString(visualEffectNameColumn) : "";
+
+        currentScene->addSceneSegment(NovelSceneSegment(segmentData.getInteger(idColumn),
+                                                        visualEffectName,
+                                                        createMusicPlaybackRequest(segmentData.getInteger(musicPlaybackRequestIdColumn))));
+    }
+
+    // Segments are stored within their scene, so they are only found by id once every one of them has been added
+    for (auto &scene : scenesById) {
+        for (int i = 0; i < scene.second->getSegmentCount(); i++) {
+            NovelSceneSegment *segment = scene.second->getSceneSegment(i);
+            segmentsById[segment->getId()] = segment;
+        }
+    }
+}
+
+void NovelLoader::loadLines(PreparedStatement *lineQuery) {
+
+    QueryCursor lineData(lineQuery);
+
+    if (!lineData.doesColumnExist("id") || !lineData.doesColumnExist("text")) {
+        return;
+    }
+
+    // Resolve the columns once rather than for every line
+    int idColumn = lineData.getColumnIndex("id");
+    int segmentIdColumn = lineData.getColumnIndex("scene_segment_id");
+    int textColumn = lineData.getColumnIndex("text");
+    int characterIdColumn = lineData.getColumnIndex("character_id");
+    int characterStateGroupIdColumn = lineData.getColumnIndex("character_state_group_id");
+    int overrideCharacterNameColumn = lineData.getColumnIndex("override_character_name");
+
+    int currentSegmentId = -1;
+    NovelSceneSegment *currentSegment = nullptr;
+
+    while (lineData.next()) {
+
+        int segmentId = lineData.getInteger(segmentIdColumn);
+
+        if (segmentId != currentSegmentId) {
+            auto parent = segmentsById.find(segmentId);
+
+            currentSegmentId = segmentId;
+            currentSegment = parent != segmentsById.end() ? parent->second : nullptr;
+        }
+
+        if (!currentSegment) {
+            continue;
+        }
+
+        CharacterStateGroup *characterStateGroup = nullptr;
+        int characterStateGroupId = characterStateGroupIdColumn != -1
+                                    ? lineData.getInteger(characterStateGroupIdColumn) : 0;
+
+        if (characterStateGroupId != 0) {
+            auto group = characterStateGroupsById.find(characterStateGroupId);
+
+            if (group != characterStateGroupsById.end()) {
+                characterStateGroup = group->second;
+            }
+        }
+
+        std::string overrideCharacterName = overrideCharacterNameColumn != -1
+                                            ? lineData.getString(overrideCharacterNameColumn) : "";
+
+        // Lines arrive ordered by segment, so a segment's lines are always added together
+        currentSegment->addLine(NovelSceneSegmentLine(lineData.getInteger(idColumn),
+                                                      lineData.getInteger(characterIdColumn),
+                                                      lineTextLoaded ? lineData.getString(textColumn) : "",
+                                                      characterStateGroup,
+                                                      overrideCharacterName));
+    }
+}
+
+/**
+ * [NovelLoader::createMusicPlaybackRequest Creates the music playback request for a scene segment]
+ * @param  musicPlaybackRequestId [Id of the request, 0 when the segment does not have one]
+ * @return                        [The request, or nullptr if there isn't one]
+ */
+MusicPlaybackRequest *NovelLoader::createMusicPlaybackRequest(int musicPlaybackRequestId) {
+
+    if (!musicPlaybackRequestId) {
+        return nullptr;
+    }
+
+    auto requestRow = musicPlaybackRequestRows.find(musicPlaybackRequestId);
+
+    if (requestRow == musicPlaybackRequestRows.end()) {
+        return nullptr;
+    }
+
+    DataSetRow *request = musicPlaybackRequests.getRow(requestRow->second);
+    int metadataId = request->getColumn("music_playback_request_metadata_id")->getData()->asInteger();
+
+    MusicPlaybackRequestMetadata *metadata = nullptr;
+    auto metadataRow = musicPlaybackRequestMetadataRows.find(metadataId);
+
+    if (metadataRow != musicPlaybackRequestMetadataRows.end()) {
+        metadata = new MusicPlaybackRequestMetadata(musicPlaybackRequestMetadata.getRow(metadataRow->second));
+    }
+
+    return new MusicPlaybackRequest(request->getColumn("id")->getData()->asInteger(),
+                                    request->getColumn("music_name")->getRawData(),
+                                    metadata);
+}
+
+/**
+ * [NovelLoader::findCharacterSprite Finds the sprite used by a character state]
+ * @param  characterId [Id of the character the sprite belongs to]
+ * @param  spriteName  [Name of the sprite]
+ * @return             [The sprite]
+ */
+CharacterSprite *NovelLoader::findCharacterSprite(int characterId, std::string_view spriteName) {
+
+    CharacterSprite *sprite = nullptr;
+
+    if (characterId > 0 && characterId <= static_cast<int>(character->size()) && (*character)[characterId - 1]) {
+        sprite = (*character)[characterId - 1]->getSprite(InternedString::find(spriteName));
+    }
+
+    if (!sprite) {
+        std::vector<std::string> error = {
+                "Could not find sprite for character ",
+                std::to_string(characterId),
+                " with name: ",
+                std::string(spriteName)
+        };
+
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    return sprite;
+}
@@ -0,0 +1,141 @@
+#include "Misc/Utils.hpp"
+#include "VisualNovelEngine/Classes/Data/NovelRequirements.hpp"
+#include <Exceptions/ResourceException.hpp>
+
+NovelRequirements::NovelRequirements() {
+    // Requirement 0 is no requirement at all, and has no terms
+    firstTerm = {0, 0};
+}
+
+/**
+ * [NovelRequirements::addTerm Adds a term to the end of a requirement. Requirements must be added in order of their id]
+ * @param requirementId [Id of the requirement]
+ * @param term          [The term]
+ */
+void NovelRequirements::addTerm(int requirementId, const NovelRequirementTerm &term) {
+
+    if (requirementId < getRequirementCount() || requirementId < 1) {
+        std::vector<std::string> error = {
+                "The terms of requirement ", std::to_string(requirementId), " were not given in order"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    while (static_cast<int>(firstTerm.size()) < requirementId + 2) {
+        firstTerm.push_back(static_cast<uint32_t>(terms.size()));
+    }
+
+    terms.push_back(term);
+    firstTerm.back() = static_cast<uint32_t>(terms.size());
+}
+
+/**
+ * [NovelRequirements::validate Checks that every requirement can be evaluated, so that evaluate doesn't have to. Throws
+ * a ResourceException if a requirement refers to a flag or counter which doesn't exist, or its terms don't leave a
+ * single result]
+ * @param flags [The flags and counters requirements are evaluated against]
+ */
+void NovelRequirements::validate(const NovelFlags &flags) const {
+
+    for (int requirementId = 1; requirementId <= getRequirementCount(); requirementId++) {
+
+        int depth = 0;
+        bool valid = true;
+
+        for (uint32_t i = firstTerm[requirementId]; i < firstTerm[requirementId + 1] && valid; i++) {
+            const NovelRequirementTerm &term = terms[i];
+
+            switch (term.opcode) {
+                case NOVEL_REQUIREMENT_FALSE:
+                case NOVEL_REQUIREMENT_TRUE:
+                    depth++;
+                    break;
+                case NOVEL_REQUIREMENT_FLAG:
+                    valid = term.operand >= 0 && term.operand < flags.getFlagCount();
+                    depth++;
+                    break;
+                case NOVEL_REQUIREMENT_COUNTER_AT_LEAST:
+                case NOVEL_REQUIREMENT_COUNTER_AT_MOST:
+                case NOVEL_REQUIREMENT_COUNTER_EQUALS:
+                    valid = term.operand >= 0 && term.operand < flags.getCounterCount();
+                    depth++;
+                    break;
+                case NOVEL_REQUIREMENT_NOT:
+                    valid = depth >= 1;
+                    break;
+                case NOVEL_REQUIREMENT_AND:
+                case NOVEL_REQUIREMENT_OR:
+                    valid = depth >= 2;
+                    depth--;
+                    break;
+                default:
+                    valid = false;
+            }
+
+            valid = valid && depth <= NOVEL_REQUIREMENT_MAX_DEPTH;
+        }
+
+        if (!valid || depth != 1) {
+            std::vector<std::string> error = {
+                    "Requirement ", std::to_string(requirementId), " of the novel is damaged, it may have been written ",
+                    "by a different version of the GameCompiler"
+            };
+            throw ResourceException(Utils::implodeString(error));
+        }
+    }
+}
+
+/**
+ * [NovelRequirements::evaluate Checks whether a requirement is met]
+ * @param  requirementId [Id of the requirement, 0 for none]
+ * @param  flags         [The flags and counters to check it against]
+ * @return               [Whether it is met, a requirement the novel doesn't have is always met]
+ */
+bool NovelRequirements::evaluate(int requirementId, const NovelFlags &flags) const {
+
+    if (requirementId <= 0 || requirementId > getRequirementCount()) {
+        return true;
+    }
+
+    // The newest result is the lowest bit
+    uint64_t stack = 0;
+
+    const NovelRequirementTerm *term = terms.data() + firstTerm[requirementId];
+    const NovelRequirementTerm *end = terms.data() + firstTerm[requirementId + 1];
+
+    for (; term != end; ++term) {
+        switch (term->opcode) {
+            case NOVEL_REQUIREMENT_FALSE:
+                stack <<= 1;
+                break;
+            case NOVEL_REQUIREMENT_TRUE:
+                stack = (stack << 1) | 1;
+                break;
+            case NOVEL_REQUIREMENT_FLAG:
+                stack = (stack << 1) | (flags.isSet(term->operand) ? 1 : 0);
+                break;
+            case NOVEL_REQUIREMENT_COUNTER_AT_LEAST:
+                stack = (stack << 1) | (flags.getCounter(term->operand) >= term->value ? 1 : 0);
+                break;
+            case NOVEL_REQUIREMENT_COUNTER_AT_MOST:
+                stack = (stack << 1) | (flags.getCounter(term->operand) <= term->value ? 1 : 0);
+                break;
+            case NOVEL_REQUIREMENT_COUNTER_EQUALS:
+                stack = (stack << 1) | (flags.getCounter(term->operand) == term->value ? 1 : 0);
+                break;
+            case NOVEL_REQUIREMENT_NOT:
+                stack ^= 1;
+                break;
+            case NOVEL_REQUIREMENT_AND:
+                stack = (stack >> 1) & (stack | ~uint64_t(1));
+                break;
+            case NOVEL_REQUIREMENT_OR:
+                stack = (stack >> 1) | (stack & 1);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return (stack & 1) != 0;
+}
@@ -0,0 +1,388 @@
+#include <algorithm>
+#include "VisualNovelEngine/Classes/Data/NovelRollback.hpp"
+
+// A step with any values starts with its flags and the length of its values, and ends with them the other way round
+#define NOVEL_ROLLBACK_STEP_FRAMING 6
+
+/**
+ * [NovelRollback::NovelRollback Creates an empty rollback, all of its memory is allocated here]
+ * @param byteCapacity [Size of the ring in bytes]
+ */
+NovelRollback::NovelRollback(int byteCapacity) {
+    ring.resize(byteCapacity > 0 ? byteCapacity : 1, 0);
+    stepValues.reserve(256);
+    pendingFlagUndos.reserve(16);
+    clear();
+}
+
+void NovelRollback::setBackground(InternedString backgroundName) {
+    pending.backgroundName = backgroundName;
+}
+
+/**
+ * [NovelRollback::setMusic Records the music playing from the next line shown]
+ * @param musicName [Name of the music, empty if none is playing]
+ */
+void NovelRollback::setMusic(InternedString musicName) {
+    pending.musicName = musicName;
+}
+
+/**
+ * [NovelRollback::setCharacterSprites Records the sprites shown from the next line shown]
+ * @param characterSprites [The sprite in each slot, nullptr for an empty slot]
+ */
+void NovelRollback::setCharacterSprites(const std::vector<CharacterSprite *> &characterSprites) {
+    pending.characterSprites = characterSprites;
+}
+
+/**
+ * [NovelRollback::recordFlagChange Records a change made to the flags from the next line shown]
+ * @param undo [The change which undoes it, as returned by NovelFlags::apply]
+ */
+void NovelRollback::recordFlagChange(const NovelFlagChange &undo) {
+    pendingFlagUndos.push_back(undo);
+}
+
+/**
+ * [NovelRollback::pushLine Records that a line has been shown, along with any changes given since the last one]
+ * @param chapter          [Index of the line's chapter]
+ * @param scene            [Index of the line's scene within the chapter]
+ * @param sceneSegment     [Index of the line's segment within the scene]
+ * @param sceneSegmentLine [Index of the line within the segment]
+ */
+void NovelRollback::pushLine(int chapter, int scene, int sceneSegment, int sceneSegmentLine) {
+
+    // The first line has nothing before it to go back to
+    if (hasShownLine) {
+        uint8_t flags = 0;
+        stepValues.clear();
+
+        if (chapter != shown.chapter || scene != shown.scene || sceneSegment != shown.sceneSegment
+            || sceneSegmentLine != shown.sceneSegmentLine + 1) {
+            flags |= NOVEL_ROLLBACK_CURSOR;
+
+            int32_t cursor[4] = {shown.chapter, shown.scene, shown.sceneSegment, shown.sceneSegmentLine};
+            appendValue(cursor, sizeof(cursor));
+        }
+
+        if (pending.characterSprites != shown.characterSprites) {
+            flags |= NOVEL_ROLLBACK_SPRITES;
+            appendSpriteChanges();
+        }
+
+        if (pending.backgroundName != shown.backgroundName) {
+            flags |= NOVEL_ROLLBACK_BACKGROUND;
+
+            uint32_t backgroundId = shown.backgroundName.getId();
+            appendValue(&backgroundId, sizeof(backgroundId));
+        }
+
+        if (pending.musicName != shown.musicName) {
+            flags |= NOVEL_ROLLBACK_MUSIC;
+
+            uint32_t musicId = shown.musicName.getId();
+            appendValue(&musicId, sizeof(musicId));
+        }
+
+        if (!pendingFlagUndos.empty()) {
+            flags |= NOVEL_ROLLBACK_FLAGS;
+
+            auto undoCount = static_cast<uint16_t>(std::min(pendingFlagUndos.size(), size_t(UINT16_MAX)));
+            appendValue(&undoCount, sizeof(undoCount));
+
+            for (int i = 0; i < undoCount; i++) {
+                int32_t undo[3] = {pendingFlagUndos[i].operation, pendingFlagUndos[i].operand, pendingFlagUndos[i].value};
+                appendValue(undo, sizeof(undo));
+            }
+        }
+
+        writeStep(flags);
+    }
+
+    // Changes made before the first line have nothing to be rolled back to
+    pendingFlagUndos.clear();
+
+    shown.chapter = chapter;
+    shown.scene = scene;
+    shown.sceneSegment = sceneSegment;
+    shown.sceneSegmentLine = sceneSegmentLine;
+    shown.backgroundName = pending.backgroundName;
+    shown.musicName = pending.musicName;
+
+    if (shown.characterSprites != pending.characterSprites) {
+        shown.characterSprites = pending.characterSprites;
+    }
+
+    hasShownLine = true;
+}
+
+/**
+ * [NovelRollback::rollBack Goes back to an earlier line by undoing the steps taken since it, newest first. Flag changes
+ * made since the current line was shown, which aren't in a step yet, are undone first. The line and what was shown with
+ * it are then given by getState]
+ * @param  lineCount  [How many lines to go back by]
+ * @param  storyFlags [The story flags, which are put back as they were at that line]
+ * @return            [How many lines were gone back by, which is fewer if the ring doesn't go back that far]
+ */
+int NovelRollback::rollBack(int lineCount, NovelFlags *storyFlags) {
+
+    int stepsUndone = 0;
+
+    // Nothing is undone if the story can't go back, as the current line carries on with its changes
+    if (lineCount > 0 && stepCount > 0) {
+        for (int i = static_cast<int>(pendingFlagUndos.size()) - 1; i >= 0; i--) {
+            if (storyFlags) {
+                storyFlags->apply(pendingFlagUndos[i]);
+            }
+        }
+
+        pendingFlagUndos.clear();
+    }
+
+    while (stepsUndone < lineCount && stepCount > 0) {
+
+        uint8_t flags = 0;
+        readBytes(byteCount - 1, &flags, sizeof(flags));
+
+        int stepSize = 1;
+        int offset = byteCount;
+
+        if (flags) {
+            uint16_t valuesLength = 0;
+            readBytes(byteCount - 3, &valuesLength, sizeof(valuesLength));
+
+            stepSize = valuesLength + NOVEL_ROLLBACK_STEP_FRAMING;
+            offset = byteCount - stepSize + 3;
+        }
+
+        if (flags & NOVEL_ROLLBACK_CURSOR) {
+            int32_t cursor[4];
+            readBytes(offset, cursor, sizeof(cursor));
+            offset += sizeof(cursor);
+
+            shown.chapter = cursor[0];
+            shown.scene = cursor[1];
+            shown.sceneSegment = cursor[2];
+            shown.sceneSegmentLine = cursor[3];
+        } else {
+            shown.sceneSegmentLine--;
+        }
+
+        if (flags & NOVEL_ROLLBACK_SPRITES) {
+            uint8_t slotCounts[2] = {0, 0};
+            readBytes(offset, slotCounts, sizeof(slotCounts));
+            offset += sizeof(slotCounts);
+
+            shown.characterSprites.resize(slotCounts[0], nullptr);
+
+            for (int i = 0; i < slotCounts[1]; i++) {
+                uint8_t slot = 0;
+                uint16_t spriteId = 0;
+                readBytes(offset, &slot, sizeof(slot));
+                readBytes(offset + 1, &spriteId, sizeof(spriteId));
+                offset += 3;
+
+                shown.characterSprites[slot] = spriteById[spriteId];
+            }
+        }
+
+        // Names are kept as their id in the string pool, which never changes once a string has been interned
+        if (flags & NOVEL_ROLLBACK_BACKGROUND) {
+            uint32_t backgroundId = 0;
+            readBytes(offset, &backgroundId, sizeof(backgroundId));
+            offset += sizeof(backgroundId);
+
+            shown.backgroundName = backgroundId != UINT32_MAX ? InternedString(StringPool::get(backgroundId)) : InternedString();
+        }
+
+        if (flags & NOVEL_ROLLBACK_MUSIC) {
+            uint32_t musicId = 0;
+            readBytes(offset, &musicId, sizeof(musicId));
+            offset += sizeof(musicId);
+
+            shown.musicName = musicId != UINT32_MAX ? InternedString(StringPool::get(musicId)) : InternedString();
+        }
+
+        if (flags & NOVEL_ROLLBACK_FLAGS) {
+            uint16_t undoCount = 0;
+            readBytes(offset, &undoCount, sizeof(undoCount));
+            offset += sizeof(undoCount);
+
+            // A flag may have been changed more than once in a step, so the changes are undone newest first
+            for (int i = undoCount - 1; i >= 0; i--) {
+                int32_t undo[3];
+                readBytes(offset + i * static_cast<int>(sizeof(undo)), undo, sizeof(undo));
+
+                if (storyFlags) {
+                    storyFlags->apply({undo[0], undo[1], undo[2]});
+                }
+            }
+        }
+
+        byteCount -= stepSize;
+        stepCount--;
+        stepsUndone++;
+    }
+
+    pending.backgroundName = shown.backgroundName;
+    pending.musicName = shown.musicName;
+    pending.characterSprites = shown.characterSprites;
+
+    return stepsUndone;
+}
+
+/**
+ * [NovelRollback::clear Forgets every step, the next line pushed is the furthest back the story can then be rolled]
+ */
+void NovelRollback::clear() {
+    firstByte = 0;
+    byteCount = 0;
+    stepCount = 0;
+    hasShownLine = false;
+    shown = {-1, -1, -1, -1, InternedString(), InternedString(), {}};
+    pending = shown;
+    pendingFlagUndos.clear();
+    spriteById.assign(1, nullptr);
+    spriteIds.clear();
+}
+
+/**
+ * [NovelRollback::appendSpriteChanges Adds the number of sprite slots shown, then the index and previous sprite of each
+ * slot which is different in the line being pushed, to the values of the step]
+ */
+void NovelRollback::appendSpriteChanges() {
+
+    uint8_t slotCounts[2] = {static_cast<uint8_t>(std::min(shown.characterSprites.size(), size_t(UINT8_MAX))), 0};
+    size_t countOffset = stepValues.size() + 1;
+    appendValue(slotCounts, sizeof(slotCounts));
+
+    for (int i = 0; i < slotCounts[0]; i++) {
+        CharacterSprite *sprite = shown.characterSprites[i];
+
+        if (i < static_cast<int>(pending.characterSprites.size()) && pending.characterSprites[i] == sprite) {
+            continue;
+        }
+
+        auto slot = static_cast<uint8_t>(i);
+        uint16_t spriteId = getSpriteId(sprite);
+        appendValue(&slot, sizeof(slot));
+        appendValue(&spriteId, sizeof(spriteId));
+        stepValues[countOffset]++;
+    }
+}
+
+/**
+ * [NovelRollback::getSpriteId Returns the id steps refer to a sprite by, giving it one if it hasn't been recorded before.
+ * Sprites belong to the novel's characters, so they outlive every step]
+ * @param  sprite [The sprite, nullptr for an empty slot]
+ * @return        [Its id]
+ */
+uint16_t NovelRollback::getSpriteId(CharacterSprite *sprite) {
+
+    if (!sprite) {
+        return 0;
+    }
+
+    auto existing = spriteIds.find(sprite);
+
+    if (existing != spriteIds.end()) {
+        return existing->second;
+    }
+
+    // Running out of ids would need more characters than a novel ever has, such a sprite is rolled back as an empty slot
+    if (spriteById.size() > UINT16_MAX) {
+        return 0;
+    }
+
+    auto spriteId = static_cast<uint16_t>(spriteById.size());
+    spriteById.push_back(sprite);
+    spriteIds[sprite] = spriteId;
+
+    return spriteId;
+}
+
+/**
+ * [NovelRollback::writeStep Adds a step to the newest end of the ring, dropping the oldest steps until it fits]
+ * @param flags [What the values in stepValues are the previous values of]
+ */
+void NovelRollback::writeStep(uint8_t flags) {
+
+    int capacity = static_cast<int>(ring.size());
+    int stepSize = flags ? static_cast<int>(stepValues.size()) + NOVEL_ROLLBACK_STEP_FRAMING : 1;
+
+    // Going back past a step that can't be stored is impossible, so everything before it is forgotten
+    if (stepSize > capacity || stepValues.size() > UINT16_MAX) {
+        firstByte = 0;
+        byteCount = 0;
+        stepCount = 0;
+        return;
+    }
+
+    while (capacity - byteCount < stepSize) {
+        dropOldestStep();
+    }
+
+    writeBytes(byteCount, &flags, sizeof(flags));
+
+    if (flags) {
+        auto valuesLength = static_cast<uint16_t>(stepValues.size());
+
+        writeBytes(byteCount + 1, &valuesLength, sizeof(valuesLength));
+        writeBytes(byteCount + 3, stepValues.data(), valuesLength);
+        writeBytes(byteCount + 3 + valuesLength, &valuesLength, sizeof(valuesLength));
+        writeBytes(byteCount + 5 + valuesLength, &flags, sizeof(flags));
+    }
+
+    byteCount += stepSize;
+    stepCount++;
+}
+
+void NovelRollback::dropOldestStep() {
+
+    uint8_t flags = 0;
+    readBytes(0, &flags, sizeof(flags));
+
+    int stepSize = 1;
+
+    if (flags) {
+        uint16_t valuesLength = 0;
+        readBytes(1, &valuesLength, sizeof(valuesLength));
+
+        stepSize = valuesLength + NOVEL_ROLLBACK_STEP_FRAMING;
+    }
+
+    firstByte = (firstByte + stepSize) % static_cast<int>(ring.size());
+    byteCount -= stepSize;
+    stepCount--;
+}
+
+/**
+ * [NovelRollback::readBytes Copies bytes out of the ring, which may wrap around its end]
+ * @param offset [Where to start, counted from the oldest byte]
+ * @param data   [Where to copy the bytes to]
+ * @param size   [How many bytes to copy]
+ */
+void NovelRollback::readBytes(int offset, void *data, int size) {
+
+    auto *bytes = static_cast<uint8_t *>(data);
+    int capacity = static_cast<int>(ring.size());
+
+    for (int i = 0; i < size; i++) {
+        bytes[i] = ring[(firstByte + offset + i) % capacity];
+    }
+}
+
+void NovelRollback::writeBytes(int offset, const void *data, int size) {
+
+    auto *bytes = static_cast<const uint8_t *>(data);
+    int capacity = static_cast<int>(ring.size());
+
+    for (int i = 0; i < size; i++) {
+        ring[(firstByte + offset + i) % capacity] = bytes[i];
+    }
+}
+
+void NovelRollback::appendValue(const void *data, int size) {
+    auto *bytes = static_cast<const uint8_t *>(data);
+    stepValues.insert(stepValues.end(), bytes, bytes + size);
+}
@@ -0,0 +1,117 @@
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "Misc/Utils.hpp"
+#include "VisualNovelEngine/Classes/Data/ReadTextLog.hpp"
+#include "VisualNovelEngine/Classes/Data/SaveGame.hpp"
+#include <Exceptions/ResourceException.hpp>
+
+/**
+ * [ReadTextLog::markRead Records that a line has been shown]
+ * @param  lineId [Id of the line]
+ * @return        [Whether the line had already been read before this]
+ */
+bool ReadTextLog::markRead(int lineId) {
+
+    if (lineId < 0) {
+        return false;
+    }
+
+    size_t word = static_cast<size_t>(lineId) / 64;
+    uint64_t bit = uint64_t(1) << (lineId % 64);
+
+    if (word >= words.size()) {
+        words.resize(word + 1, 0);
+    }
+
+    bool alreadyRead = (words[word] & bit) != 0;
+    words[word] |= bit;
+
+    return alreadyRead;
+}
+
+bool ReadTextLog::hasBeenRead(int lineId) const {
+
+    if (lineId < 0) {
+        return false;
+    }
+
+    size_t word = static_cast<size_t>(lineId) / 64;
+
+    return word < words.size() && (words[word] & (uint64_t(1) << (lineId % 64))) != 0;
+}
+
+/**
+ * [ReadTextLog::readFromFile Reads the lines which have been read from a file]
+ * @param  path [Path of the file]
+ * @return      [The log, empty if the file does not exist yet]
+ */
+ReadTextLog ReadTextLog::readFromFile(const std::string &path) {
+
+    ReadTextLog log;
+
+    if (!Utils::fileExists(path)) {
+        return log;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    std::string data = contents.str();
+    SaveGameHeader header = {};
+
+    if (data.size() < sizeof(SaveGameHeader)) {
+        std::vector<std::string> error = {
+                "'", path, "' is not a read text file"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    std::memcpy(&header, data.data(), sizeof(SaveGameHeader));
+
+    if (std::memcmp(header.magic, READ_TEXT_LOG_MAGIC, SAVE_GAME_MAGIC_LENGTH) != 0
+        || header.version != READ_TEXT_LOG_VERSION || header.byteOrderMark != SAVE_GAME_BYTE_ORDER_MARK) {
+        std::vector<std::string> error = {
+                "'", path, "' is not a read text file, or was written by an incompatible version of the game"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    const char *payload = data.data() + sizeof(SaveGameHeader);
+
+    if (header.payloadSize != data.size() - sizeof(SaveGameHeader) || header.payloadSize % sizeof(uint64_t) != 0
+        || header.checksum != SaveGame::checksum(payload, header.payloadSize)) {
+        std::vector<std::string> error = {
+                "The read text file '", path, "' is damaged"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    log.words.resize(header.payloadSize / sizeof(uint64_t));
+    std::memcpy(log.words.data(), payload, header.payloadSize);
+
+    return log;
+}
+
+/**
+ * [ReadTextLog::writeToFile Writes the log to a file, replacing the file only once it has been fully written]
+ * @param path [Path of the file]
+ */
+void ReadTextLog::writeToFile(const std::string &path) const {
+
+    const char *payload = reinterpret_cast<const char *>(words.data());
+    size_t payloadSize = words.size() * sizeof(uint64_t);
+
+    SaveGameHeader header = {};
+    std::memcpy(header.magic, READ_TEXT_LOG_MAGIC, SAVE_GAME_MAGIC_LENGTH);
+    header.version = READ_TEXT_LOG_VERSION;
+    header.byteOrderMark = SAVE_GAME_BYTE_ORDER_MARK;
+    header.payloadSize = static_cast<uint32_t>(payloadSize);
+    header.checksum = SaveGame::checksum(payload, payloadSize);
+
+    std::string data(reinterpret_cast<const char *>(&header), sizeof(SaveGameHeader));
+    data.append(payload, payloadSize);
+
+    SaveGame::writeToFile(path, data);
+}
@@ -0,0 +1,268 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "Misc/Utils.hpp"
+#include "VisualNovelEngine/Classes/Data/SaveGame.hpp"
+#include <Exceptions/ResourceException.hpp>
+
+SaveGame::SaveGame() {
+    chapter = 0;
+    scene = -1;
+    sceneSegment = -1;
+    sceneSegmentLine = -1;
+}
+
+/**
+ * [SaveGame::serialise Writes the save, including its header, into a string of bytes]
+ * @return [The contents of a save file]
+ */
+std::string SaveGame::serialise() const {
+
+    std::string payload;
+
+    auto writeInteger = [&payload](uint32_t value) {
+        payload.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+
+    auto writeString = [&payload, &writeInteger](const std::string &value) {
+        writeInteger(static_cast<uint32_t>(value.size()));
+        payload.append(value);
+    };
+
+    writeInteger(static_cast<uint32_t>(chapter));
+    writeInteger(static_cast<uint32_t>(scene));
+    writeInteger(static_cast<uint32_t>(sceneSegment));
+    writeInteger(static_cast<uint32_t>(sceneSegmentLine));
+    writeString(backgroundName);
+    writeString(musicName);
+    writeString(text);
+    writeString(characterName);
+    writeInteger(static_cast<uint32_t>(characterSprites.size()));
+
+    for (auto &characterSprite : characterSprites) {
+        writeInteger(static_cast<uint32_t>(characterSprite.characterId));
+        writeString(characterSprite.spriteName);
+    }
+
+    writeInteger(static_cast<uint32_t>(flagWords.size()));
+
+    for (auto &flagWord : flagWords) {
+        writeInteger(static_cast<uint32_t>(flagWord));
+        writeInteger(static_cast<uint32_t>(flagWord >> 32));
+    }
+
+    writeInteger(static_cast<uint32_t>(counters.size()));
+
+    for (auto &counter : counters) {
+        writeInteger(static_cast<uint32_t>(counter));
+    }
+
+    SaveGameHeader header = {};
+    std::memcpy(header.magic, SAVE_GAME_MAGIC, SAVE_GAME_MAGIC_LENGTH);
+    header.version = SAVE_GAME_VERSION;
+    header.byteOrderMark = SAVE_GAME_BYTE_ORDER_MARK;
+    header.payloadSize = static_cast<uint32_t>(payload.size());
+    header.checksum = checksum(payload.data(), payload.size());
+
+    std::string data(reinterpret_cast<const char *>(&header), sizeof(SaveGameHeader));
+    data.append(payload);
+
+    return data;
+}
+
+/**
+ * [SaveGame::deserialise Reads a save from the contents of a save file]
+ * @param  data [The contents of the file]
+ * @param  path [Path of the file, used in error messages]
+ * @return      [The save]
+ */
+SaveGame SaveGame::deserialise(const std::string &data, const std::string &path) {
+
+    SaveGameHeader header = {};
+
+    if (data.size() < sizeof(SaveGameHeader)) {
+        std::vector<std::string> error = {
+                "'", path, "' is not a save file"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    std::memcpy(&header, data.data(), sizeof(SaveGameHeader));
+
+    if (std::memcmp(header.magic, SAVE_GAME_MAGIC, SAVE_GAME_MAGIC_LENGTH) != 0) {
+        std::vector<std::string> error = {
+                "'", path, "' is not a save file"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    if (header.version < 1 || header.version > SAVE_GAME_VERSION || header.byteOrderMark != SAVE_GAME_BYTE_ORDER_MARK) {
+        std::vector<std::string> error = {
+                "The save file '", path, "' was written by an incompatible version of the game (save version ",
+                std::to_string(header.version), ", expected ", std::to_string(SAVE_GAME_VERSION), ")"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    const char *payload = data.data() + sizeof(SaveGameHeader);
+
+    if (header.payloadSize != data.size() - sizeof(SaveGameHeader)
+        || header.checksum != checksum(payload, header.payloadSize)) {
+        std::vector<std::string> error = {
+                "The save file '", path, "' is damaged"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    size_t position = 0;
+
+    auto readInteger = [&]() {
+        uint32_t value;
+
+        if (header.payloadSize - position < sizeof(value)) {
+            std::vector<std::string> error = {
+                    "The save file '", path, "' ends unexpectedly"
+            };
+            throw ResourceException(Utils::implodeString(error));
+        }
+
+        std::memcpy(&value, payload + position, sizeof(value));
+        position += sizeof(value);
+
+        return value;
+    };
+
+    auto readString = [&]() {
+        uint32_t length = readInteger();
+
+        if (header.payloadSize - position < length) {
+            std::vector<std::string> error = {
+                    "The save file '", path, "' ends unexpectedly"
+            };
+            throw ResourceException(Utils::implodeString(error));
+        }
+
+        std::string value(payload + position, length);
+        position += length;
+
+        return value;
+    };
+
+    SaveGame saveGame;
+    saveGame.chapter = static_cast<int>(readInteger());
+    saveGame.scene = static_cast<int>(readInteger());
+    saveGame.sceneSegment = static_cast<int>(readInteger());
+    saveGame.sceneSegmentLine = static_cast<int>(readInteger());
+    saveGame.backgroundName = readString();
+    saveGame.musicName = readString();
+    saveGame.text = readString();
+    saveGame.characterName = readString();
+
+    uint32_t characterSpriteCount = readInteger();
+
+    for (uint32_t i = 0; i < characterSpriteCount; i++) {
+        SaveGameCharacterSprite characterSprite;
+        characterSprite.characterId = static_cast<int>(readInteger());
+        characterSprite.spriteName = readString();
+        saveGame.characterSprites.push_back(characterSprite);
+    }
+
+    if (header.version >= SAVE_GAME_FLAGS_VERSION) {
+        uint32_t flagWordCount = readInteger();
+
+        for (uint32_t i = 0; i < flagWordCount; i++) {
+            uint64_t low = readInteger();
+            uint64_t high = readInteger();
+            saveGame.flagWords.push_back(low | (high << 32));
+        }
+
+        uint32_t counterCount = readInteger();
+
+        for (uint32_t i = 0; i < counterCount; i++) {
+            saveGame.counters.push_back(static_cast<int32_t>(readInteger()));
+        }
+    }
+
+    return saveGame;
+}
+
+/**
+ * [SaveGame::readFromFile Reads a save file]
+ * @param  path [Path of the file]
+ * @return      [The save]
+ */
+SaveGame SaveGame::readFromFile(const std::string &path) {
+
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open()) {
+        std::vector<std::string> error = {
+                "Unable to open the save file '", path, "'"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    return deserialise(contents.str(), path);
+}
+
+/**
+ * [SaveGame::writeToFile Writes a serialised save to a file, replacing the file only once it has been fully written]
+ * @param path [Path of the file]
+ * @param data [The serialised save]
+ */
+void SaveGame::writeToFile(const std::string &path, const std::string &data) {
+
+    std::error_code directoryError;
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, directoryError);
+    }
+
+    // Written to a temporary file first so that a failed save never replaces a good one
+    std::string temporaryPath = path + ".tmp";
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open()) {
+        std::vector<std::string> error = {
+                "Unable to open '", temporaryPath, "' to write the save"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file.close();
+
+    if (file.fail()) {
+        std::vector<std::string> error = {
+                "Unable to write the save to '", temporaryPath, "'"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    std::remove(path.c_str());
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::vector<std::string> error = {
+                "Unable to move the save from '", temporaryPath, "' to '", path, "'"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+}
+
+uint32_t SaveGame::checksum(const char *data, size_t length) {
+
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
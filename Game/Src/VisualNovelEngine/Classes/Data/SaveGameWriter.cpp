@@ -0,0 +1,75 @@
+#include <iostream>
+#include "VisualNovelEngine/Classes/Data/SaveGameWriter.hpp"
+#include <Exceptions/ResourceException.hpp>
+
+SaveGameWriter::SaveGameWriter() {
+    writing = false;
+    terminateWriterThread = false;
+    writerThread = new std::thread(&SaveGameWriter::threadFunction, this);
+}
+
+SaveGameWriter::~SaveGameWriter() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        terminateWriterThread = true;
+    }
+
+    queueCondition.notify_all();
+    writerThread->join();
+    delete (writerThread);
+}
+
+/**
+ * [SaveGameWriter::write Queues a save to be written, returning straight away]
+ * @param path     [Path of the save file]
+ * @param saveGame [The save, which is copied]
+ */
+void SaveGameWriter::write(const std::string &path, const SaveGame &saveGame) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        writeQueue.push({path, saveGame});
+    }
+
+    queueCondition.notify_all();
+}
+
+/**
+ * [SaveGameWriter::flush Waits until every queued save has been written]
+ */
+void SaveGameWriter::flush() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueCondition.wait(lock, [this] {
+        return writeQueue.empty() && !writing;
+    });
+}
+
+void SaveGameWriter::threadFunction() {
+
+    std::unique_lock<std::mutex> lock(queueMutex);
+
+    while (true) {
+        queueCondition.wait(lock, [this] {
+            return terminateWriterThread || !writeQueue.empty();
+        });
+
+        // Anything still queued is written before the thread stops
+        if (writeQueue.empty()) {
+            return;
+        }
+
+        SaveGameWriteRequest request = writeQueue.front();
+        writeQueue.pop();
+        writing = true;
+        lock.unlock();
+
+        try {
+            SaveGame::writeToFile(request.path, request.saveGame.serialise());
+        } catch (ResourceException &e) {
+            std::cout << "Unable to save the game: " << e.what() << std::endl;
+        }
+
+        lock.lock();
+        writing = false;
+        queueCondition.notify_all();
+    }
+}
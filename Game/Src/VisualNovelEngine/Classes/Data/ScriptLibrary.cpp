@@ -0,0 +1,105 @@
+#include "Misc/Utils.hpp"
+#include "Database/QueryCursor.hpp"
+#include "VisualNovelEngine/Classes/Data/ScriptLibrary.hpp"
+#include "VisualNovelEngine/Classes/Data/Novel.hpp"
+#include "Exceptions/ResourceException.hpp"
+
+ScriptLibrary::ScriptLibrary() = default;
+
+ScriptLibrary::~ScriptLibrary() {
+    for (auto &program : programs) {
+        delete (program);
+    }
+}
+
+/**
+ * [ScriptLibrary::load Reads every enabled script and checks it can be run. Character sprites are looked up once here,
+ * so the novel must have loaded its characters]
+ * @param resourceDb [The resource database]
+ * @param novel      [The novel the scripts are run in]
+ */
+void ScriptLibrary::load(DatabaseConnection *resourceDb, NovelData *novel) {
+
+    std::unordered_map<int, ScriptProgram *> programsById;
+
+    QueryCursor scriptData(resourceDb->prepare(
+            "SELECT id, name, register_count FROM scripts WHERE enabled = 1 ORDER BY id;"));
+
+    while (scriptData.next()) {
+        auto *program = new ScriptProgram(InternedString(scriptData.getText(1)), scriptData.getInteger(2));
+
+        programs.push_back(program);
+        programsById[scriptData.getInteger(0)] = program;
+        programsByName[program->getName().getId()] = program;
+    }
+
+    if (programs.empty()) {
+        return;
+    }
+
+    // Instructions are stored as signed ints, as that is what SQLite reads back
+    QueryCursor instructionData(resourceDb->prepare(
+            "SELECT script_id, instruction FROM script_instructions ORDER BY script_id, id;"));
+
+    while (instructionData.next()) {
+        auto program = programsById.find(instructionData.getInteger(0));
+
+        if (program != programsById.end()) {
+            program->second->addInstruction(static_cast<uint32_t>(instructionData.getInteger(1)));
+        }
+    }
+
+    QueryCursor constantData(resourceDb->prepare(
+            "SELECT script_id, value FROM script_constants ORDER BY script_id, id;"));
+
+    while (constantData.next()) {
+        auto program = programsById.find(constantData.getInteger(0));
+
+        if (program != programsById.end()) {
+            program->second->addConstant(constantData.getInteger(1));
+        }
+    }
+
+    QueryCursor operandData(resourceDb->prepare(
+            "SELECT script_id, kind, value, name FROM script_operands ORDER BY script_id, id;"));
+
+    while (operandData.next()) {
+        auto program = programsById.find(operandData.getInteger(0));
+
+        if (program == programsById.end()) {
+            continue;
+        }
+
+        ScriptOperand operand = {operandData.getInteger(1), InternedString(operandData.getText(3)), nullptr};
+
+        if (operand.kind == SCRIPT_OPERAND_SPRITE) {
+            operand.characterSprite = novel->findCharacterSprite(operandData.getInteger(2), operand.name.str());
+
+            if (!operand.characterSprite) {
+                std::vector<std::string> error = {
+                        "The script '", program->second->getName().str(), "' shows the sprite '", operand.name.str(),
+                        "' of character ", std::to_string(operandData.getInteger(2)), ", which does not exist"
+                };
+                throw ResourceException(Utils::implodeString(error));
+            }
+        }
+
+        program->second->addOperand(operand);
+    }
+
+    for (auto &program : programs) {
+        program->validate(novel->getFlags());
+    }
+}
+
+/**
+ * [ScriptLibrary::find Finds a script by name]
+ * @param  name [Name of the script]
+ * @return      [The script, or nullptr if there is no enabled script with that name]
+ */
+const ScriptProgram *ScriptLibrary::find(InternedString name) const {
+
+    auto program = programsByName.find(name.getId());
+
+    return program != programsByName.end() ? program->second : nullptr;
+}
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include "Misc/Utils.hpp"
+#include "VisualNovelEngine/Classes/Data/ScriptMachine.hpp"
+
+ScriptMachine::ScriptMachine() {
+    program = nullptr;
+    state = ScriptState::Stopped;
+    programCounter = 0;
+    executedCount = 0;
+    std::fill(registers, registers + SCRIPT_MAX_REGISTERS, 0);
+}
+
+/**
+ * [ScriptMachine::start Starts a script from its first instruction, in place of any script already running]
+ * @param scriptProgram [The script, which must have been validated against the flags it is run with]
+ */
+void ScriptMachine::start(const ScriptProgram *scriptProgram) {
+    program = scriptProgram;
+    state = program ? ScriptState::Running : ScriptState::Stopped;
+    programCounter = 0;
+    executedCount = 0;
+    error.clear();
+
+    if (program) {
+        std::fill(registers, registers + program->getRegisterCount(), 0);
+    }
+}
+
+/**
+ * [ScriptMachine::stop Stops the script where it is]
+ */
+void ScriptMachine::stop() {
+    program = nullptr;
+    state = ScriptState::Stopped;
+}
+
+/**
+ * [ScriptMachine::run Runs the script until it yields, finishes or has run the given number of instructions, in which
+ * case it carries on from the same place the next time it is run]
+ * @param  instructionBudget [The most instructions to run]
+ * @param  host              [What the script acts on]
+ * @return                   [Running unless the script has finished or failed]
+ */
+ScriptState ScriptMachine::run(int instructionBudget, ScriptHost *host) {
+
+    if (state != ScriptState::Running) {
+        return state;
+    }
+
+    NovelFlags &flags = host->getScriptFlags();
+    const uint32_t *instructions = program->getInstructions();
+    const int32_t *constants = program->getConstants();
+    const int instructionCount = program->getInstructionCount();
+    int32_t *r = registers;
+    int pc = programCounter;
+    int executed = 0;
+
+    // Arithmetic wraps around rather than overflowing
+    auto wrap = [](uint32_t value) {
+        return static_cast<int32_t>(value);
+    };
+
+    while (executed < instructionBudget) {
+
+        if (pc >= instructionCount) {
+            state = ScriptState::Stopped;
+            break;
+        }
+
+        uint32_t instruction = instructions[pc++];
+        uint32_t a = SCRIPT_DECODE_A(instruction);
+        executed++;
+
+        switch (SCRIPT_DECODE_OP(instruction)) {
+            case SCRIPT_OP_HALT:
+                state = ScriptState::Stopped;
+                break;
+            case SCRIPT_OP_YIELD:
+                programCounter = pc;
+                executedCount += executed;
+                return state;
+            case SCRIPT_OP_LOADI:
+                r[a] = SCRIPT_DECODE_SBX(instruction);
+                break;
+            case SCRIPT_OP_LOADK:
+                r[a] = constants[SCRIPT_DECODE_BX(instruction)];
+                break;
+            case SCRIPT_OP_MOVE:
+                r[a] = r[SCRIPT_DECODE_B(instruction)];
+                break;
+            case SCRIPT_OP_ADD:
+                r[a] = wrap(static_cast<uint32_t>(r[SCRIPT_DECODE_B(instruction)])
+                            + static_cast<uint32_t>(r[SCRIPT_DECODE_C(instruction)]));
+                break;
+            case SCRIPT_OP_SUB:
+                r[a] = wrap(static_cast<uint32_t>(r[SCRIPT_DECODE_B(instruction)])
+                            - static_cast<uint32_t>(r[SCRIPT_DECODE_C(instruction)]));
+                break;
+            case SCRIPT_OP_MUL:
+                r[a] = wrap(static_cast<uint32_t>(r[SCRIPT_DECODE_B(instruction)])
+                            * static_cast<uint32_t>(r[SCRIPT_DECODE_C(instruction)]));
+                break;
+            case SCRIPT_OP_DIV:
+            case SCRIPT_OP_MOD: {
+                int32_t dividend = r[SCRIPT_DECODE_B(instruction)];
+                int32_t divisor = r[SCRIPT_DECODE_C(instruction)];
+
+                if (divisor == 0) {
+                    programCounter = pc - 1;
+                    executedCount += executed;
+                    return fail("it divided by 0");
+                }
+
+                bool division = SCRIPT_DECODE_OP(instruction) == SCRIPT_OP_DIV;
+
+                // The one quotient which doesn't fit wraps around like any other arithmetic
+                if (divisor == -1) {
+                    r[a] = division ? wrap(0u - static_cast<uint32_t>(dividend)) : 0;
+                } else {
+                    r[a] = division ? dividend / divisor : dividend % divisor;
+                }
+                break;
+            }
+            case SCRIPT_OP_EQ:
+                r[a] = r[SCRIPT_DECODE_B(instruction)] == r[SCRIPT_DECODE_C(instruction)];
+                break;
+            case SCRIPT_OP_NE:
+                r[a] = r[SCRIPT_DECODE_B(instruction)] != r[SCRIPT_DECODE_C(instruction)];
+                break;
+            case SCRIPT_OP_LT:
+                r[a] = r[SCRIPT_DECODE_B(instruction)] < r[SCRIPT_DECODE_C(instruction)];
+                break;
+            case SCRIPT_OP_LE:
+                r[a] = r[SCRIPT_DECODE_B(instruction)] <= r[SCRIPT_DECODE_C(instruction)];
+                break;
+            case SCRIPT_OP_AND:
+                r[a] = r[SCRIPT_DECODE_B(instruction)] && r[SCRIPT_DECODE_C(instruction)];
+                break;
+            case SCRIPT_OP_OR:
+                r[a] = r[SCRIPT_DECODE_B(instruction)] || r[SCRIPT_DECODE_C(instruction)];
+                break;
+            case SCRIPT_OP_NOT:
+                r[a] = !r[SCRIPT_DECODE_B(instruction)];
+                break;
+            case SCRIPT_OP_NEG:
+                r[a] = wrap(0u - static_cast<uint32_t>(r[SCRIPT_DECODE_B(instruction)]));
+                break;
+            case SCRIPT_OP_JMP:
+                pc += SCRIPT_DECODE_SBX(instruction);
+                break;
+            case SCRIPT_OP_JMPIFNOT:
+                if (!r[a]) {
+                    pc += SCRIPT_DECODE_SBX(instruction);
+                }
+                break;
+            case SCRIPT_OP_FLAG:
+                r[a] = flags.isSet(SCRIPT_DECODE_BX(instruction));
+                break;
+            case SCRIPT_OP_COUNTER:
+                r[a] = flags.getCounter(SCRIPT_DECODE_BX(instruction));
+                break;
+            case SCRIPT_OP_SETFLAG:
+                host->changeFlag({NOVEL_FLAG_CHANGE_SET_FLAG, static_cast<int>(SCRIPT_DECODE_BX(instruction)),
+                                  r[a] ? 1 : 0});
+                break;
+            case SCRIPT_OP_SETCOUNTER:
+                host->changeFlag({NOVEL_FLAG_CHANGE_SET_COUNTER, static_cast<int>(SCRIPT_DECODE_BX(instruction)), r[a]});
+                break;
+            case SCRIPT_OP_BACKGROUND:
+                host->showBackground(program->getOperand(SCRIPT_DECODE_BX(instruction)).name);
+                break;
+            case SCRIPT_OP_MORPH:
+                host->morphBackground(program->getOperand(SCRIPT_DECODE_BX(instruction)).name, std::max(0, r[a]));
+                break;
+            case SCRIPT_OP_FADEIN:
+                host->fadeInBackground(std::max(0, r[a]));
+                break;
+            case SCRIPT_OP_FADEOUT:
+                host->fadeOutBackground(std::max(0, r[a]));
+                break;
+            case SCRIPT_OP_TRANSITIONING:
+                r[a] = host->isBackgroundTransitioning();
+                break;
+            case SCRIPT_OP_SPRITE:
+            case SCRIPT_OP_CLEARSPRITE: {
+                CharacterSprite *characterSprite = nullptr;
+
+                if (SCRIPT_DECODE_OP(instruction) == SCRIPT_OP_SPRITE) {
+                    characterSprite = program->getOperand(SCRIPT_DECODE_BX(instruction)).characterSprite;
+                }
+
+                if (!host->showSprite(r[a], characterSprite)) {
+                    programCounter = pc - 1;
+                    executedCount += executed;
+                    return fail(Utils::implodeString({"it used sprite slot ", std::to_string(r[a]),
+                                                      ", which doesn't exist"}));
+                }
+                break;
+            }
+            case SCRIPT_OP_MUSIC:
+                host->playMusic(program->getOperand(SCRIPT_DECODE_BX(instruction)).name);
+                break;
+            case SCRIPT_OP_STOPMUSIC:
+                host->stopMusic();
+                break;
+            default:
+                break;
+        }
+
+        if (state != ScriptState::Running) {
+            break;
+        }
+    }
+
+    programCounter = pc;
+    executedCount += executed;
+
+    return state;
+}
+
+/**
+ * [ScriptMachine::fail Stops the script because of an error]
+ * @param  reason [What went wrong]
+ * @return        [Failed]
+ */
+ScriptState ScriptMachine::fail(const std::string &reason) {
+
+    std::vector<std::string> message = {
+            "The script '", program->getName().str(), "' was stopped at instruction ", std::to_string(programCounter),
+            " because ", reason
+    };
+
+    error = Utils::implodeString(message);
+    state = ScriptState::Failed;
+
+    return state;
+}
@@ -0,0 +1,127 @@
+#include "Misc/Utils.hpp"
+#include "VisualNovelEngine/Classes/Data/ScriptProgram.hpp"
+#include "Exceptions/ResourceException.hpp"
+
+/**
+ * [ScriptProgram::ScriptProgram Creates a script with no instructions, which finishes as soon as it starts]
+ * @param programName          [Name of the script]
+ * @param programRegisterCount [How many registers its instructions use]
+ */
+ScriptProgram::ScriptProgram(InternedString programName, int programRegisterCount) {
+    name = programName;
+    registerCount = programRegisterCount;
+}
+
+void ScriptProgram::addInstruction(uint32_t instruction) {
+    instructions.push_back(instruction);
+}
+
+void ScriptProgram::addConstant(int32_t value) {
+    constants.push_back(value);
+}
+
+void ScriptProgram::addOperand(const ScriptOperand &operand) {
+    operands.push_back(operand);
+}
+
+/**
+ * [ScriptProgram::validate Checks every instruction, so that the ScriptMachine doesn't have to. Throws a
+ * ResourceException if one is unknown or refers to something the script or the novel doesn't have]
+ * @param flags [The flags and counters the script is run with]
+ */
+void ScriptProgram::validate(const NovelFlags &flags) const {
+
+    bool valid = registerCount >= 0 && registerCount <= SCRIPT_MAX_REGISTERS;
+    int count = getInstructionCount();
+
+    auto isRegister = [&](uint32_t index) {
+        return static_cast<int>(index) < registerCount;
+    };
+
+    auto isOperand = [&](uint32_t index, int kind) {
+        return index < operands.size() && operands[index].kind == kind;
+    };
+
+    for (int i = 0; i < count && valid; i++) {
+        uint32_t instruction = instructions[i];
+        uint32_t a = SCRIPT_DECODE_A(instruction);
+        uint32_t b = SCRIPT_DECODE_B(instruction);
+        uint32_t c = SCRIPT_DECODE_C(instruction);
+        uint32_t bx = SCRIPT_DECODE_BX(instruction);
+
+        // A jump may lead to just past the last instruction, which finishes the script
+        int target = i + 1 + SCRIPT_DECODE_SBX(instruction);
+        bool targetValid = target >= 0 && target <= count;
+
+        switch (SCRIPT_DECODE_OP(instruction)) {
+            case SCRIPT_OP_HALT:
+            case SCRIPT_OP_YIELD:
+            case SCRIPT_OP_STOPMUSIC:
+                break;
+            case SCRIPT_OP_LOADI:
+            case SCRIPT_OP_FADEIN:
+            case SCRIPT_OP_FADEOUT:
+            case SCRIPT_OP_TRANSITIONING:
+            case SCRIPT_OP_CLEARSPRITE:
+                valid = isRegister(a);
+                break;
+            case SCRIPT_OP_LOADK:
+                valid = isRegister(a) && bx < constants.size();
+                break;
+            case SCRIPT_OP_MOVE:
+            case SCRIPT_OP_NOT:
+            case SCRIPT_OP_NEG:
+                valid = isRegister(a) && isRegister(b);
+                break;
+            case SCRIPT_OP_ADD:
+            case SCRIPT_OP_SUB:
+            case SCRIPT_OP_MUL:
+            case SCRIPT_OP_DIV:
+            case SCRIPT_OP_MOD:
+            case SCRIPT_OP_EQ:
+            case SCRIPT_OP_NE:
+            case SCRIPT_OP_LT:
+            case SCRIPT_OP_LE:
+            case SCRIPT_OP_AND:
+            case SCRIPT_OP_OR:
+                valid = isRegister(a) && isRegister(b) && isRegister(c);
+                break;
+            case SCRIPT_OP_JMP:
+                valid = targetValid;
+                break;
+            case SCRIPT_OP_JMPIFNOT:
+                valid = isRegister(a) && targetValid;
+                break;
+            case SCRIPT_OP_FLAG:
+            case SCRIPT_OP_SETFLAG:
+                valid = isRegister(a) && static_cast<int>(bx) < flags.getFlagCount();
+                break;
+            case SCRIPT_OP_COUNTER:
+            case SCRIPT_OP_SETCOUNTER:
+                valid = isRegister(a) && static_cast<int>(bx) < flags.getCounterCount();
+                break;
+            case SCRIPT_OP_BACKGROUND:
+                valid = isOperand(bx, SCRIPT_OPERAND_BACKGROUND);
+                break;
+            case SCRIPT_OP_MORPH:
+                valid = isRegister(a) && isOperand(bx, SCRIPT_OPERAND_BACKGROUND);
+                break;
+            case SCRIPT_OP_SPRITE:
+                valid = isRegister(a) && isOperand(bx, SCRIPT_OPERAND_SPRITE) && operands[bx].characterSprite;
+                break;
+            case SCRIPT_OP_MUSIC:
+                valid = isOperand(bx, SCRIPT_OPERAND_MUSIC);
+                break;
+            default:
+                valid = false;
+        }
+    }
+
+    if (!valid) {
+        std::vector<std::string> error = {
+                "The script '", name.str(), "' is damaged, it may have been written by a different version of the ",
+                "GameCompiler"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+}
@@ -0,0 +1,128 @@
+#include <cstring>
+#include <vector>
+#include "Misc/Utils.hpp"
+#include "VisualNovelEngine/Classes/Data/StringPack.hpp"
+#include <Exceptions/ResourceException.hpp>
+
+/**
+ * [StringPack::StringPack Maps a string pack into memory]
+ * @param path [Path of the pack]
+ */
+StringPack::StringPack(const std::string &path) {
+    packPath = path;
+    file = new MappedFile(path);
+    data = file->getData();
+    size = file->getSize();
+    header = reinterpret_cast<const StringPackHeader *>(data);
+
+    try {
+        checkHeader();
+    } catch (ResourceException &e) {
+        delete file;
+        throw;
+    }
+}
+
+StringPack::~StringPack() {
+    delete file;
+}
+
+/**
+ * [StringPack::getPath Returns where the compiler writes the string pack of a locale]
+ * @param  locale [Name of the locale]
+ * @return        [Path of the pack]
+ */
+std::string StringPack::getPath(const std::string &locale) {
+    return std::string(STRING_PACK_DIRECTORY) + locale + STRING_PACK_EXTENSION;
+}
+
+std::string StringPack::getLocale() {
+    return std::string(header->locale, strnlen(header->locale, STRING_PACK_LOCALE_LENGTH));
+}
+
+std::string_view StringPack::getLineText(int lineId) {
+    return getString(header->lineTexts, lineId);
+}
+
+std::string_view StringPack::getLineCharacterName(int lineId) {
+    return getString(header->lineCharacterNames, lineId);
+}
+
+std::string_view StringPack::getCharacterName(int characterId) {
+    return getString(header->characterNames, characterId);
+}
+
+std::string_view StringPack::getChapterTitle(int chapterId) {
+    return getString(header->chapterTitles, chapterId);
+}
+
+/**
+ * [StringPack::checkHeader Checks that the pack was written by a compatible compiler, and that every table is within the file]
+ */
+void StringPack::checkHeader() {
+
+    if (size < sizeof(StringPackHeader) || std::memcmp(header->magic, STRING_PACK_MAGIC, STRING_PACK_MAGIC_LENGTH) != 0) {
+        std::vector<std::string> error = {
+                "'", packPath, "' is not a string pack"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    if (header->version != STRING_PACK_VERSION || header->byteOrderMark != STRING_PACK_BYTE_ORDER_MARK
+        || header->headerSize != sizeof(StringPackHeader)) {
+        std::vector<std::string> error = {
+                "The string pack '", packPath, "' was written by an incompatible version of the compiler (pack version ",
+                std::to_string(header->version), ", expected ", std::to_string(STRING_PACK_VERSION), ")"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    if (header->fileSize != size) {
+        std::vector<std::string> error = {
+                "The string pack '", packPath, "' is ", std::to_string(size), " bytes, but should be ",
+                std::to_string(header->fileSize), " bytes"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    checkTable(header->lineTexts, sizeof(StringPackString), "line_texts");
+    checkTable(header->lineCharacterNames, sizeof(StringPackString), "line_character_names");
+    checkTable(header->characterNames, sizeof(StringPackString), "character_names");
+    checkTable(header->chapterTitles, sizeof(StringPackString), "chapter_titles");
+    checkTable(header->strings, 1, "strings");
+}
+
+void StringPack::checkTable(const StringPackTable &table, size_t recordSize, const std::string &tableName) {
+
+    if (table.offset % STRING_PACK_TABLE_ALIGNMENT != 0
+        || static_cast<uint64_t>(table.offset) + static_cast<uint64_t>(table.count) * recordSize > size) {
+        std::vector<std::string> error = {
+                "The table '", tableName, "' of the string pack '", packPath, "' is outside of the file"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+}
+
+/**
+ * [StringPack::getString Returns a string from the string blob without copying it]
+ * @param  table [The table the string is listed in]
+ * @param  id    [Id of whatever the string belongs to]
+ * @return       [The string, valid for as long as the pack is. Empty if the table has no entry for the id]
+ */
+std::string_view StringPack::getString(const StringPackTable &table, int id) {
+
+    if (id < 0 || static_cast<uint32_t>(id) >= table.count) {
+        return std::string_view();
+    }
+
+    const StringPackString &packString = reinterpret_cast<const StringPackString *>(data + table.offset)[id];
+
+    if (static_cast<uint64_t>(packString.offset) + packString.length > header->strings.count) {
+        std::vector<std::string> error = {
+                "The string pack '", packPath, "' contains a string outside of its string blob"
+        };
+        throw ResourceException(Utils::implodeString(error));
+    }
+
+    return std::string_view(data + header->strings.offset + packString.offset, packString.length);
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <unordered_map>
 #include "Base/Engine.hpp"
 #include "Misc/Utils.hpp"
 #include "VisualNovelEngine/Classes/Data/Novel.hpp"
@@ -95,6 +97,14 @@ void CharacterSpriteRenderer::draw() {
 void CharacterSpriteRenderer::initData(NovelData *novelData) {
     novel = novelData;
 
+    // Read the name of every texture at once, rather than querying for each sprite
+    std::unordered_map<int, InternedString> textureNames;
+    QueryCursor textures(resource->prepare("SELECT id, name FROM textures;"));
+
+    while (textures.next()) {
+        textureNames[textures.getInteger(0)] = InternedString(textures.getText(1));
+    }
+
     // Link all of the Character Sprites up with their textures
     int count = 0;
 
@@ -106,17 +116,9 @@ void CharacterSpriteRenderer::initData(NovelData *novelData) {
         while (character->getSprite(spriteCount)) {
             CharacterSprite *sprite = character->getSprite(spriteCount);
 
-            std::vector<std::string> textureNameQuery = {
-                    "SELECT name FROM textures WHERE id = ",
-                    std::to_string(sprite->getTextureId()),
-                    ";"
-            };
-
-            DataSet *dataSet = new DataSet();
-
-            resource->executeQuery(Utils::implodeString(textureNameQuery), dataSet);
+            auto textureName = textureNames.find(sprite->getTextureId());
 
-            if (dataSet->getRowCount() == 0) {
+            if (textureName == textureNames.end()) {
                 std::vector<std::string> error = {
                         "Could not find texture with id: ",
                         std::to_string(sprite->getTextureId())
@@ -125,9 +127,7 @@ void CharacterSpriteRenderer::initData(NovelData *novelData) {
                 throw ResourceException(Utils::implodeString(error));
             }
 
-            sprite->setTextureName(dataSet->getRow(0)->getColumn("name")->getRawData());
-
-            delete (dataSet);
+            sprite->setTextureName(textureName->second);
 
             spriteCount++;
         }
@@ -164,6 +164,66 @@ void CharacterSpriteRenderer::push(std::vector<CharacterSpriteDrawRequest *> spr
 
 }
 
+/**
+ * [CharacterSpriteRenderer::getCharacterSprites Returns the sprite in each slot in use]
+ * @return [The sprites, nullptr for an empty slot]
+ */
+std::vector<CharacterSprite *> CharacterSpriteRenderer::getCharacterSprites() {
+
+    std::vector<CharacterSprite *> sprites;
+
+    for (int i = 0; i < activeSpriteCount; i++) {
+        sprites.push_back(spriteSlot[i]->getCharacterSprite());
+    }
+
+    return sprites;
+}
+
+/**
+ * [CharacterSpriteRenderer::show Puts sprites straight into the slots, without any transitions]
+ * @param sprites [One sprite for each slot to use, nullptr for an empty slot]
+ */
+void CharacterSpriteRenderer::show(const std::vector<CharacterSprite *> &sprites) {
+
+    int spriteCount = std::min(static_cast<int>(sprites.size()), MAX_CHARACTER_SPRITE_SLOTS);
+
+    for (int i = 0; i < MAX_CHARACTER_SPRITE_SLOTS; i++) {
+        spriteSlot[i]->show(i < spriteCount ? sprites[i] : nullptr);
+    }
+
+    activeSpriteCount = spriteCount;
+    processedPositioning = false;
+}
+
+/**
+ * [CharacterSpriteRenderer::pushToSlot Transitions a single slot to a sprite, leaving the other slots as they are]
+ * @param  slot            [Index of the slot]
+ * @param  characterSprite [The sprite, nullptr to empty the slot]
+ * @return                 [Whether there is such a slot]
+ */
+bool CharacterSpriteRenderer::pushToSlot(int slot, CharacterSprite *characterSprite) {
+
+    if (slot < 0 || slot >= MAX_CHARACTER_SPRITE_SLOTS) {
+        return false;
+    }
+
+    CharacterSpriteDrawRequest request(characterSprite);
+    spriteSlot[slot]->push(characterSprite ? &request : nullptr);
+
+    // The slots in use run up to the last one with a sprite in it
+    if (characterSprite) {
+        activeSpriteCount = std::max(activeSpriteCount, slot + 1);
+    }
+
+    while (activeSpriteCount > 0 && !spriteSlot[activeSpriteCount - 1]->getCharacterSprite()) {
+        activeSpriteCount--;
+    }
+
+    processedPositioning = false;
+
+    return true;
+}
+
 void CharacterSpriteRenderer::clear() {
 
 }
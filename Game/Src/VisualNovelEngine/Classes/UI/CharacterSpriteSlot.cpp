@@ -12,6 +12,7 @@ CharacterSpriteSlot::CharacterSpriteSlot(SpriteRenderer *sRenderer, ResourceMana
     id = myId;
     previousCharacterId = 0;
     currentCharacterId = 0;
+    currentCharacterSprite = nullptr;
     setAlpha(0, 0);
     setAlpha(1, 0);
     updateState = UPDATE_STATE_NOTHING;
@@ -109,6 +110,8 @@ void CharacterSpriteSlot::fadeUpdate() {
 
 void CharacterSpriteSlot::push(CharacterSpriteDrawRequest *drawRequest) {
 
+    currentCharacterSprite = drawRequest ? drawRequest->characterSprite : nullptr;
+
     if (!drawRequest) {
         sprite[0]->setVisible(false);
         sprite[1]->setVisible(false);
@@ -131,6 +134,32 @@ void CharacterSpriteSlot::push(CharacterSpriteDrawRequest *drawRequest) {
     // Todo: Handle priority and positioning
 }
 
+/**
+ * [CharacterSpriteSlot::show Shows a sprite straight away, without any transition. Used when restoring a save]
+ * @param characterSprite [The sprite, or nullptr to empty the slot]
+ */
+void CharacterSpriteSlot::show(CharacterSprite *characterSprite) {
+
+    currentCharacterSprite = characterSprite;
+    updateState = UPDATE_STATE_NOTHING;
+    fadingOut = false;
+
+    sprite[1]->setVisible(false);
+    setAlpha(1, 0);
+
+    if (!characterSprite) {
+        sprite[0]->setVisible(false);
+        setAlpha(0, 0);
+        previousCharacterId = 0;
+        return;
+    }
+
+    sprite[0]->setTextureName(characterSprite->getTextureName(), true);
+    sprite[0]->setVisible(true);
+    setAlpha(0, 255);
+    previousCharacterId = characterSprite->getCharacterId();
+}
+
 Sprite *CharacterSpriteSlot::getSprite(int id) {
     return sprite[id];
 }
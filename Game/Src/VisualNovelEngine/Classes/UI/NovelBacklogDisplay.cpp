@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <SFML/Graphics.hpp>
+#include "Database/DatabaseConnection.hpp"
+#include "BackgroundRenderer/BackgroundImageRenderer.hpp"
+#include "Resource/ResourceManager.hpp"
+#include "TextRenderer/TextRenderer.hpp"
+#include "SpriteRenderer/SpriteRenderer.hpp"
+#include "VisualNovelEngine/Classes/Data/Novel.hpp"
+#include "VisualNovelEngine/Classes/UI/NovelTextDisplay.hpp"
+#include "VisualNovelEngine/Classes/UI/NovelBacklogDisplay.hpp"
+
+#define NOVEL_BACKLOG_TOP 40
+#define NOVEL_BACKLOG_ENTRY_HEIGHT 130
+
+NovelBacklogDisplay::NovelBacklogDisplay(TextRenderer *tRenderer, NovelData *novelData, NovelBacklog *novelBacklog) {
+
+  textRenderer = tRenderer;
+  fontManager = tRenderer->getFontManager();
+  novel = novelData;
+  backlog = novelBacklog;
+  scrollPosition = 0;
+  maxTextWidth = 980;
+  opened = false;
+
+  // Every row is created now, opening the backlog only changes their strings
+  for (int i = 0; i < NOVEL_BACKLOG_VISIBLE_ENTRIES; i++) {
+    int rowPosition = NOVEL_BACKLOG_TOP + (i * NOVEL_BACKLOG_ENTRY_HEIGHT);
+
+    nameText[i] = textRenderer->addText("novel_backlog_name_" + std::to_string(i), "story_font");
+    nameText[i]->setPosition(150, rowPosition);
+    nameText[i]->setOutline(sf::Color::Black, 2);
+    nameText[i]->setVisible(false);
+
+    lineText[i] = textRenderer->addText("novel_backlog_text_" + std::to_string(i), "story_font");
+    lineText[i]->setPosition(150, rowPosition + 40);
+    lineText[i]->setOutline(sf::Color::Black, 2);
+    lineText[i]->setVisible(false);
+
+    shownLineId[i] = -1;
+  }
+}
+
+NovelBacklogDisplay::~NovelBacklogDisplay() {
+
+}
+
+/**
+ * [NovelBacklogDisplay::open Shows the backlog, scrolled to the newest line]
+ */
+void NovelBacklogDisplay::open() {
+  opened = true;
+  scrollPosition = 0;
+  layout();
+}
+
+void NovelBacklogDisplay::close() {
+  opened = false;
+
+  for (int i = 0; i < NOVEL_BACKLOG_VISIBLE_ENTRIES; i++) {
+    nameText[i]->setVisible(false);
+    lineText[i]->setVisible(false);
+  }
+}
+
+/**
+ * [NovelBacklogDisplay::scroll Scrolls the backlog, stopping at the oldest and newest lines]
+ * @param entries [How many entries to scroll towards older lines, negative to scroll towards newer ones]
+ */
+void NovelBacklogDisplay::scroll(int entries) {
+
+  int maxScrollPosition = std::max(backlog->getEntryCount() - NOVEL_BACKLOG_VISIBLE_ENTRIES, 0);
+  int newScrollPosition = std::min(std::max(scrollPosition + entries, 0), maxScrollPosition);
+
+  if (newScrollPosition == scrollPosition) {
+    return;
+  }
+
+  scrollPosition = newScrollPosition;
+  layout();
+}
+
+/**
+ * [NovelBacklogDisplay::invalidate Makes every row read its text and name again the next time it is laid out, for when
+ * the locale being played changes]
+ */
+void NovelBacklogDisplay::invalidate() {
+
+  for (int i = 0; i < NOVEL_BACKLOG_VISIBLE_ENTRIES; i++) {
+    shownLineId[i] = -1;
+  }
+}
+
+/**
+ * [NovelBacklogDisplay::layout Fills each row with the entry scrolled into it, the bottom row holds the newest]
+ */
+void NovelBacklogDisplay::layout() {
+
+  int entryCount = backlog->getEntryCount();
+
+  for (int i = 0; i < NOVEL_BACKLOG_VISIBLE_ENTRIES; i++) {
+    int entryIndex = entryCount - scrollPosition - NOVEL_BACKLOG_VISIBLE_ENTRIES + i;
+
+    if (entryIndex < 0) {
+      nameText[i]->setVisible(false);
+      lineText[i]->setVisible(false);
+      shownLineId[i] = -1;
+      continue;
+    }
+
+    const NovelBacklogEntry &entry = backlog->getEntry(entryIndex);
+
+    if (shownLineId[i] != entry.lineId) {
+      nameText[i]->setString(novel->getCharacterName(entry.lineId));
+      lineText[i]->setString(NovelTextDisplay::wordWrap(novel->getLineText(entry.lineId),
+                                                        fontManager->getFont("story_font"), maxTextWidth));
+      shownLineId[i] = entry.lineId;
+    }
+
+    nameText[i]->setVisible(true);
+    lineText[i]->setVisible(true);
+  }
+}
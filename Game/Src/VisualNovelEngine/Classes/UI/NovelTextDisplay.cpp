@@ -50,7 +50,8 @@ NovelTextDisplay::~NovelTextDisplay() {
 }
 
 void NovelTextDisplay::setText(std::string newText, std::string cName) {
-  newText = wordWrap(newText, maxTextWidth);
+  text = newText;
+  newText = wordWrap(newText, fontManager->getFont(storyFont), maxTextWidth);
   currentDisplayText = "";
   fullDisplayText = newText;
   characterName = cName;
@@ -115,10 +116,9 @@ void NovelTextDisplay::displayWholeStringImmediately() {
 /**
  * [NovelTextDisplay::wordWrap Inserts newlines into a string until it fits within the specified width]
  */
-std::string NovelTextDisplay::wordWrap(std::string textToWrap, float maxWidth) {
+std::string NovelTextDisplay::wordWrap(std::string textToWrap, Font *font, float maxWidth) {
 
   sf::Text *text = new sf::Text();
-  Font *font = fontManager->getFont("story_font");
 
   text->setFont(*font->getFont());
   text->setString(textToWrap);
@@ -177,6 +177,7 @@ void NovelTextDisplay::setInvisible() {
 }
 
 void NovelTextDisplay::clear() {
+  text = "";
   currentDisplayText = "";
   fullDisplayText = "";
   characterName = "";
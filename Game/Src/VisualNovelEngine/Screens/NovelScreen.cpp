@@ -4,11 +4,15 @@
 #include "VisualNovelEngine/Screens/NovelScreen.hpp"
 #include "Misc/ColourBuilder.hpp"
 #include <iostream>
+#include <algorithm>
 #include "VisualNovelEngine/Classes/Data/VisualNovelEngineConstants.hpp"
 
 // Objects used on this screen
 #include "VisualNovelEngine/Classes/UI/NovelTextDisplay.hpp"
 
+// How much of each frame is spent advancing through lines in skip mode, the rest is left for drawing
+#define SKIP_MICROSECONDS_PER_FRAME 8000
+
 NovelScreen::NovelScreen(Engine *enginePointer, NovelData *novelPointer) {
     engine = enginePointer;
     window = engine->getWindow();
@@ -22,17 +26,50 @@ NovelScreen::NovelScreen(Engine *enginePointer, NovelData *novelPointer) {
     backgroundTransitionRenderer = engine->getBackgroundTransitionRenderer();
     characterSpriteRenderer = engine->getCharacterSpriteRenderer();
     sceneTransitioning = false;
+    skipping = false;
+    skipUnreadText = false;
+    skippedLine = nullptr;
+    skippedCharacterSpritesChanged = false;
 
     textDisplay = new NovelTextDisplay(textRenderer, spriteRenderer, resourceManager);
+    backlogDisplay = new NovelBacklogDisplay(textRenderer, novel, &backlog);
 
     // User input bindings for this screen (TODO: Also react to gamepad and mouse input)
     advanceEventId = inputManager->bindKeyboardEvent("novel_screen_text_advance", "return", true);
     advanceMouseEvent = inputManager->getMouseHandler()->addEvent("novel_screen_text_advance",
                                                                   MouseEventType::LeftClick);
+    quickSaveEventId = inputManager->bindKeyboardEvent("novel_screen_quick_save", "F5", true);
+    quickLoadEventId = inputManager->bindKeyboardEvent("novel_screen_quick_load", "F9", true);
+    skipEventId = inputManager->bindKeyboardEvent("novel_screen_skip", "S", true);
+    backlogEventId = inputManager->bindKeyboardEvent("novel_screen_backlog", "B", true);
+    backlogScrollUpEventId = inputManager->bindKeyboardEvent("novel_screen_backlog_scroll_up", "up", true);
+    backlogScrollDownEventId = inputManager->bindKeyboardEvent("novel_screen_backlog_scroll_down", "down", true);
+    backlogCloseEventId = inputManager->bindKeyboardEvent("novel_screen_backlog_close", "escape", true);
+    rollbackEventId = inputManager->bindKeyboardEvent("novel_screen_rollback", "left", true);
+    localeEventId = inputManager->bindKeyboardEvent("novel_screen_next_locale", "L", true);
+
+    saveGameWriter = new SaveGameWriter();
+
+    scripts.load(resourceManager->getResourceDatabase(), novel);
+
+    try {
+        readText = ReadTextLog::readFromFile(READ_TEXT_LOG_PATH);
+    } catch (ResourceException &e) {
+        std::cout << "Unable to read which lines have been read, every line will be treated as unread: " << e.what()
+                  << std::endl;
+    }
 }
 
 NovelScreen::~NovelScreen() {
-
+    // Waits for any save still being written
+    delete (saveGameWriter);
+    delete (backlogDisplay);
+
+    try {
+        readText.writeToFile(READ_TEXT_LOG_PATH);
+    } catch (ResourceException &e) {
+        std::cout << "Unable to save which lines have been read: " << e.what() << std::endl;
+    }
 }
 
 void NovelScreen::start() {
@@ -41,6 +78,55 @@ void NovelScreen::start() {
 
 void NovelScreen::update() {
 
+    if (inputManager->isEventPressed(quickSaveEventId)) {
+        quickSave();
+    }
+
+    // Loading is allowed during a transition, which is cancelled
+    if (inputManager->isEventPressed(quickLoadEventId)) {
+        try {
+            quickLoad();
+        } catch (ResourceException &e) {
+            std::cout << "Unable to load the quick save: " << e.what() << std::endl;
+        }
+        return;
+    }
+
+    if (backlogDisplay->isOpen()) {
+        updateBacklog();
+        return;
+    }
+
+    if (scriptMachine.isRunning()) {
+        runScript();
+    }
+
+    if (inputManager->isEventPressed(localeEventId)) {
+        nextLocale();
+    }
+
+    // The backlog can't be opened during a transition, as the text display is hidden until it has finished
+    if ((inputManager->isEventPressed(backlogEventId) || inputManager->isEventPressed(backlogScrollUpEventId))
+        && backgroundTransitionRenderer->hasTransitionCompleted() && !sceneTransitioning) {
+        openBacklog();
+        return;
+    }
+
+    // Going back a line is allowed during a transition, which is cancelled
+    if (inputManager->isEventPressed(rollbackEventId)) {
+        rollBack(1);
+        return;
+    }
+
+    if (inputManager->isEventPressed(skipEventId)) {
+        setSkipping(!skipping);
+    }
+
+    if (skipping) {
+        skip();
+        return;
+    }
+
     // If a transition is going on, do nothing
     if (!backgroundTransitionRenderer->hasTransitionCompleted()) {
         return;
@@ -101,25 +187,48 @@ void NovelScreen::nextLine() {
 
     NovelSceneSegmentLine *nextLine = novel->getNextLine();
 
-    // If the next line has a character or override name attached to it, use that as the character name
-    int characterId = nextLine->getCharacterId();
+    bool alreadyRead = readText.markRead(nextLine->getId());
+    backlog.push(nextLine->getId());
 
-    std::string characterName;
+    CharacterStateGroup *characterStateGroup = nextLine->getCharacterStateGroup();
+    std::vector<CharacterSprite *> sprites;
+
+    // Skipped lines are recorded as well, with what they would have shown, so that any of them can be rolled back to
+    if (characterStateGroup) {
+        for (auto &state : characterStateGroup->getCharacterStates()) {
+            sprites.push_back(state->getCharacterSprite());
+        }
 
-    if (!nextLine->getOverrideCharacterName().empty()) {
-        characterName = nextLine->getOverrideCharacterName();
+        rollback.setCharacterSprites(sprites);
     }
 
-    if (characterId > 0 && characterName.empty()) {
-        Character *character = novel->getCharacter(characterId - 1);
+    rollback.pushLine(novel->getCurrentChapterIndex(), novel->getCurrentSceneIndex(),
+                      novel->getCurrentSceneSegmentIndex(), novel->getCurrentSceneSegmentLineIndex());
 
-        if (character) {
-            characterName = character->getFirstName();
+    if (skipping && !alreadyRead && !skipUnreadText) {
+        // Skipping stops at the first line which hasn't been read before, which is then shown as normal
+        skippedLine = nullptr;
+        showSkippedLines();
+        setSkipping(false);
+    }
+
+    if (skipping) {
+        // Only the last line skipped in a frame is shown, once the frame's skipping has finished
+        skippedLine = nextLine;
+
+        // The sprites are kept rather than the group, as a windowed novel may release the group's scene before the
+        // frame's skipping has finished
+        if (characterStateGroup) {
+            skippedCharacterSprites = sprites;
+            skippedCharacterSpritesChanged = true;
         }
+
+        return;
     }
 
+    std::string characterName = novel->getCharacterName(nextLine);
+
     // Handle character sprite drawing
-    CharacterStateGroup *characterStateGroup = nextLine->getCharacterStateGroup();
     if (characterStateGroup) {
         std::vector<CharacterState *> states = characterStateGroup->getCharacterStates();
 
@@ -138,16 +247,39 @@ void NovelScreen::nextLine() {
 
     }
 
-    textDisplay->setText(nextLine->getText(), characterName);
+    textDisplay->setText(novel->getLineText(nextLine), characterName);
 }
 
 void NovelScreen::nextSegment() {
 
     NovelSceneSegment *nextSegment = novel->advanceToNextSegment();
 
+    // Made before the segment's first line, so that they are undone by rolling back past it
+    const NovelFlagChange *flagChanges = nullptr;
+    int flagChangeCount = novel->getFlagChanges(nextSegment->getId(), &flagChanges);
+
+    for (int i = 0; i < flagChangeCount; i++) {
+        rollback.recordFlagChange(novel->getFlags().apply(flagChanges[i]));
+    }
+
+    // A segment which starts a script stops the one before it, if it is still running
+    const ScriptProgram *script = scripts.find(novel->getSegmentScript(nextSegment->getId()));
+
+    if (script) {
+        scriptMachine.start(script);
+    }
+
     // Play the music file related to the scene segment
     MusicPlaybackRequest *musicPlaybackRequest = nextSegment->getMusicPlaybackRequest();
+
     if (musicPlaybackRequest) {
+        rollback.setMusic(musicPlaybackRequest->getMusicName());
+    }
+
+    if (musicPlaybackRequest && skipping) {
+        // Only the music of the last segment skipped in a frame is played
+        skippedMusicName = musicPlaybackRequest->getMusicName();
+    } else if (musicPlaybackRequest) {
         // TODO: Handle metadata
         MusicPlaybackRequestMetadata *metadata = musicPlaybackRequest->getMetadata();
 
@@ -171,6 +303,20 @@ void NovelScreen::nextScene() {
     // TODO: use the scene transition id and colour stored with the scene in the database
     NovelScene *nextScene = novel->advanceToNextScene();
 
+    rollback.setBackground(nextScene->getBackgroundImageName());
+
+    if (skipping) {
+        // Scenes change straight away while skipping, without any transition
+        backgroundTransitionRenderer->cancelTransition();
+        backgroundImageRenderer->setBackground(nextScene->getBackgroundImageName());
+
+        nextSegment();
+
+        sceneTransitioning = false;
+        textDisplay->setVisible();
+        return;
+    }
+
     sf::Color *colour = ColourBuilder::get(novel->getCurrentScene()->getStartTransitionColourId());
 
     bool needsToFadeIn = true;
@@ -201,17 +347,209 @@ void NovelScreen::nextScene() {
     textDisplay->setVisible();
 }
 
+/**
+ * Saves the story and what is on the screen to the quick save slot. The save is written on another thread
+ */
+void NovelScreen::quickSave() {
+
+    // The screen has already been cleared for the next scene, which the story hasn't reached yet
+    if (sceneTransitioning) {
+        std::cout << "The game can't be saved while changing scene" << std::endl;
+        return;
+    }
+
+    SaveGame saveGame;
+    saveGame.chapter = novel->getCurrentChapterIndex();
+    saveGame.scene = novel->getCurrentSceneIndex();
+    saveGame.sceneSegment = novel->getCurrentSceneSegmentIndex();
+    saveGame.sceneSegmentLine = novel->getCurrentSceneSegmentLineIndex();
+    saveGame.backgroundName = backgroundImageRenderer->getBackgroundName().str();
+    saveGame.musicName = musicManager->getPlayingStreamName().str();
+    saveGame.text = textDisplay->getText();
+    saveGame.characterName = textDisplay->getCharacterName();
+
+    for (auto &characterSprite : characterSpriteRenderer->getCharacterSprites()) {
+        if (characterSprite) {
+            saveGame.characterSprites.push_back({characterSprite->getCharacterId(), characterSprite->getName().str()});
+        } else {
+            saveGame.characterSprites.push_back({0, ""});
+        }
+    }
+
+    saveGame.flagWords = novel->getFlags().getFlagWords();
+    saveGame.counters = novel->getFlags().getCounters();
+
+    saveGameWriter->write(QUICK_SAVE_PATH, saveGame);
+}
+
+/**
+ * Puts the story and the screen back as they were when the game was quick saved
+ */
+void NovelScreen::quickLoad() {
+
+    sf::Clock loadClock;
+
+    // A quick save which hasn't finished being written yet is the one that should be loaded
+    saveGameWriter->flush();
+
+    restore(SaveGame::readFromFile(QUICK_SAVE_PATH));
+
+    std::cout << "Quick save loaded in " << loadClock.getElapsedTime().asMilliseconds() << "ms" << std::endl;
+}
+
+/**
+ * Moves the story to a saved line and shows what was on the screen at the time, without replaying the lines before it.
+ * If the save doesn't match the novel, a ResourceException is thrown before anything is changed.
+ * @param saveGame the save to restore
+ */
+void NovelScreen::restore(const SaveGame &saveGame) {
+
+    std::vector<CharacterSprite *> sprites;
+
+    for (auto &characterSprite : saveGame.characterSprites) {
+
+        if (characterSprite.spriteName.empty()) {
+            sprites.push_back(nullptr);
+            continue;
+        }
+
+        CharacterSprite *sprite = novel->findCharacterSprite(characterSprite.characterId, characterSprite.spriteName);
+
+        if (!sprite) {
+            std::vector<std::string> error = {
+                    "The save shows the sprite '", characterSprite.spriteName, "' of character ",
+                    std::to_string(characterSprite.characterId), ", which does not exist"
+            };
+            throw ResourceException(Utils::implodeString(error));
+        }
+
+        sprites.push_back(sprite);
+    }
+
+    NovelSceneSegmentLine *line = novel->jumpTo(saveGame.chapter, saveGame.scene, saveGame.sceneSegment,
+                                                saveGame.sceneSegmentLine);
+
+    // Anything the save doesn't have, such as a flag added to the novel since, starts at its default
+    novel->resetFlags();
+    novel->getFlags().assign(saveGame.flagWords, saveGame.counters);
+
+    // The backlog held the lines leading up to where the game was, which are not the ones leading up to the save
+    if (backlogDisplay->isOpen()) {
+        closeBacklog();
+    }
+
+    // The line is shown in the locale being played, which needn't be the one the game was saved in
+    std::string characterName = novel->getCharacterName(line);
+
+    backlog.clear();
+    backlog.push(line->getId());
+
+    showImmediately(InternedString(saveGame.backgroundName), sprites, novel->getLineText(line), characterName);
+    resumeMusic(InternedString(saveGame.musicName));
+
+    // The lines before the save can't be rolled back to, as what was shown with them isn't saved
+    rollback.clear();
+    rollback.setBackground(InternedString(saveGame.backgroundName));
+    rollback.setMusic(InternedString(saveGame.musicName));
+    rollback.setCharacterSprites(sprites);
+    rollback.pushLine(saveGame.chapter, saveGame.scene, saveGame.sceneSegment, saveGame.sceneSegmentLine);
+}
+
+/**
+ * Goes back through the lines which have been shown, and shows the line reached as it was shown at the time. Only the
+ * changes between lines are undone, and the screen is only updated once for the line reached
+ * @param lineCount how many lines to go back by
+ */
+void NovelScreen::rollBack(int lineCount) {
+
+    int linesGoneBack = rollback.rollBack(lineCount, &novel->getFlags());
+
+    if (linesGoneBack == 0) {
+        return;
+    }
+
+    const NovelRollbackState &state = rollback.getState();
+    NovelSceneSegmentLine *line = novel->jumpTo(state.chapter, state.scene, state.sceneSegment, state.sceneSegmentLine);
+
+    // The lines gone back past are shown again, and added to the backlog again, if the story moves on to them
+    backlog.removeNewest(linesGoneBack);
+
+    showImmediately(state.backgroundName, state.characterSprites, novel->getLineText(line), novel->getCharacterName(line));
+
+    // Music which is already playing carries on rather than starting again
+    if (state.musicName != musicManager->getPlayingStreamName()) {
+        resumeMusic(state.musicName);
+    }
+}
+
+/**
+ * Shows a line after the story has moved straight to it, stopping anything which was happening before
+ * @param backgroundName the background to show
+ * @param sprites the sprite to show in each slot, nullptr for an empty slot
+ * @param text the text of the line
+ * @param characterName the name shown with the text
+ */
+void NovelScreen::showImmediately(InternedString backgroundName, const std::vector<CharacterSprite *> &sprites,
+                                  const std::string &text, const std::string &characterName) {
+
+    // Nothing which was skipped before the story moved is shown
+    setSkipping(false);
+    skippedLine = nullptr;
+    skippedCharacterSprites.clear();
+    skippedCharacterSpritesChanged = false;
+    skippedMusicName = InternedString();
+
+    backgroundTransitionRenderer->cancelTransition();
+    sceneTransitioning = false;
+    scriptMachine.stop();
+
+    backgroundImageRenderer->setBackground(backgroundName);
+    characterSpriteRenderer->show(sprites);
+
+    textDisplay->setText(text, characterName);
+    textDisplay->displayWholeStringImmediately();
+    textDisplay->setVisible();
+}
+
+/**
+ * Plays music which was playing at the line the story has moved to. The current segment's playback settings are used
+ * if it is the segment which started the music
+ * @param musicName the music, or empty to stop the music
+ */
+void NovelScreen::resumeMusic(InternedString musicName) {
+
+    if (musicName.empty()) {
+        musicManager->stopAudioStreams();
+        return;
+    }
+
+    MusicPlaybackRequest *musicPlaybackRequest = novel->getCurrentSceneSegment()->getMusicPlaybackRequest();
+    MusicPlaybackRequestMetadata *metadata = nullptr;
+
+    if (musicPlaybackRequest && musicPlaybackRequest->getMusicName() == musicName) {
+        metadata = musicPlaybackRequest->getMetadata();
+    }
+
+    musicManager->playAudioStream(musicName, metadata);
+}
+
 /**
  * Starts a transition to the next scene - Performs a morph or fade-out transition if it needs to.
  */
 void NovelScreen::transitionToNextScene() {
 
+    // The next scene is started by skip() straight away
+    if (skipping) {
+        textDisplay->clear();
+        sceneTransitioning = true;
+        return;
+    }
+
     sf::Color *colour = ColourBuilder::get(novel->getCurrentScene()->getEndTransitionColourId());
 
-    // Calculate that the next scene will be
-    // This is easy now, but in the future we won't always be transitioning between scenes in a linear fashion
-    // TODO: Move this code into a "changeScene" function which can be called by this one with the arguments to get the next scene
-    NovelScene *nextScene = novel->getCurrentChapter()->getScene(novel->getCurrentSceneIndex() + 1);
+    // The next scene is wherever the compiler resolved the current segment to lead, which may be in another chapter
+    // When the novel is windowed, this is where the prefetched scene is handed over
+    NovelScene *nextScene = novel->getUpcomingScene();
 
     // Figure out which type of start transition we need to use
     switch (novel->getCurrentScene()->getEndTransitionTypeId()) {
@@ -239,3 +577,227 @@ void NovelScreen::transitionToNextScene() {
     textDisplay->clear();
     sceneTransitioning = true;
 }
+
+/**
+ * Starts or stops skip mode, where lines which have been read before are advanced through as fast as possible
+ * @param shouldSkip whether to skip
+ */
+void NovelScreen::setSkipping(bool shouldSkip) {
+
+    if (skipping == shouldSkip) {
+        return;
+    }
+
+    skipping = shouldSkip;
+
+    if (!skipping) {
+        return;
+    }
+
+    // Whatever was still being animated when skipping started is finished straight away
+    backgroundTransitionRenderer->finishTransition();
+    textDisplay->displayWholeStringImmediately();
+}
+
+/**
+ * Advances through the novel for part of the frame, without showing any of the lines until the end of it
+ */
+void NovelScreen::skip() {
+
+    // The player has chosen to read the text themselves
+    if (inputManager->isEventPressed(advanceEventId) || advanceMouseEvent->conditionsMet()) {
+        setSkipping(false);
+        return;
+    }
+
+    sf::Clock frameClock;
+
+    while (skipping && frameClock.getElapsedTime().asMicroseconds() < SKIP_MICROSECONDS_PER_FRAME) {
+
+        if (sceneTransitioning) {
+            nextScene();
+            continue;
+        }
+
+        if (novel->getNextAction() == AdvanceState::StoryEnd) {
+            setSkipping(false);
+            break;
+        }
+
+        advance();
+    }
+
+    showSkippedLines();
+}
+
+/**
+ * Shows the line that skipping has reached, along with the sprites and music of the lines and segments skipped to
+ * get there. Everything is shown straight away without any transitions
+ */
+void NovelScreen::showSkippedLines() {
+
+    if (!skippedMusicName.empty()) {
+        resumeMusic(skippedMusicName);
+    }
+
+    if (skippedCharacterSpritesChanged) {
+        characterSpriteRenderer->show(skippedCharacterSprites);
+    }
+
+    if (skippedLine) {
+        textDisplay->setText(novel->getLineText(skippedLine), novel->getCharacterName(skippedLine));
+        textDisplay->displayWholeStringImmediately();
+    }
+
+    skippedLine = nullptr;
+    skippedCharacterSprites.clear();
+    skippedCharacterSpritesChanged = false;
+    skippedMusicName = InternedString();
+}
+
+/**
+ * Switches to the next of the novel's locales, and shows the current line again in it. The story carries on from
+ * where it is, only the novel's text is changed
+ */
+void NovelScreen::nextLocale() {
+
+    const std::vector<std::string> &locales = novel->getLocales();
+
+    if (locales.size() < 2) {
+        return;
+    }
+
+    auto current = std::find(locales.begin(), locales.end(), novel->getLocale());
+    size_t nextIndex = current == locales.end() ? 0 : (current - locales.begin() + 1) % locales.size();
+
+    try {
+        novel->setLocale(locales[nextIndex]);
+    } catch (ResourceException &e) {
+        std::cout << "Unable to switch to the locale '" << locales[nextIndex] << "': " << e.what() << std::endl;
+        return;
+    }
+
+    std::cout << "Switched to the locale '" << locales[nextIndex] << "'" << std::endl;
+
+    // The backlog's rows still hold the text of the previous locale
+    backlogDisplay->invalidate();
+
+    NovelSceneSegmentLine *line = novel->getCurrentLine();
+
+    // Nothing is shown between scenes, the next scene's lines are shown in the new locale anyway
+    if (!line || sceneTransitioning || skipping) {
+        return;
+    }
+
+    bool textFinished = textDisplay->hasTextFinished();
+    textDisplay->setText(novel->getLineText(line), novel->getCharacterName(line));
+
+    if (textFinished) {
+        textDisplay->displayWholeStringImmediately();
+    }
+}
+
+/**
+ * Opens the backlog, hiding the text display and stopping the story until it is closed
+ */
+void NovelScreen::openBacklog() {
+    setSkipping(false);
+    textDisplay->setInvisible();
+    backlogDisplay->open();
+}
+
+void NovelScreen::closeBacklog() {
+    backlogDisplay->close();
+    textDisplay->setVisible();
+}
+
+/**
+ * Scrolls or closes the backlog
+ */
+void NovelScreen::updateBacklog() {
+
+    if (inputManager->isEventPressed(backlogEventId) || inputManager->isEventPressed(backlogCloseEventId)) {
+        closeBacklog();
+        return;
+    }
+
+    if (inputManager->isEventPressed(backlogScrollUpEventId)) {
+        backlogDisplay->scroll(1);
+    }
+
+    if (inputManager->isEventPressed(backlogScrollDownEventId)) {
+        backlogDisplay->scroll(-1);
+    }
+}
+
+/**
+ * Runs the script started by the current segment for the rest of its share of the frame
+ */
+void NovelScreen::runScript() {
+
+    if (scriptMachine.run(SCRIPT_INSTRUCTIONS_PER_FRAME, this) == ScriptState::Failed) {
+        std::cout << scriptMachine.getError() << std::endl;
+    }
+}
+
+NovelFlags &NovelScreen::getScriptFlags() {
+    return novel->getFlags();
+}
+
+/**
+ * Changes a flag or counter for a script, which is undone by rolling back to any earlier line
+ * @param change the change
+ */
+void NovelScreen::changeFlag(const NovelFlagChange &change) {
+    rollback.recordFlagChange(novel->getFlags().apply(change));
+}
+
+void NovelScreen::showBackground(InternedString backgroundName) {
+    rollback.setBackground(backgroundName);
+    backgroundImageRenderer->setBackground(backgroundName);
+}
+
+void NovelScreen::morphBackground(InternedString backgroundName, int milliseconds) {
+    rollback.setBackground(backgroundName);
+    backgroundImageRenderer->setUpcomingBackground(backgroundName);
+    backgroundTransitionRenderer->startTransition(BackgroundTransition::MORPH, sf::Color::Black, 0, 0, milliseconds);
+}
+
+void NovelScreen::fadeInBackground(int milliseconds) {
+    backgroundTransitionRenderer->startTransition(BackgroundTransition::FADE_IN, sf::Color::Black, 0, 0, milliseconds);
+}
+
+void NovelScreen::fadeOutBackground(int milliseconds) {
+    backgroundTransitionRenderer->startTransition(BackgroundTransition::FADE_OUT, sf::Color::Black, 0, 0, milliseconds);
+}
+
+bool NovelScreen::isBackgroundTransitioning() {
+    return !backgroundTransitionRenderer->hasTransitionCompleted();
+}
+
+/**
+ * Shows a sprite in a slot for a script, leaving the other slots as they are
+ * @param slot the slot
+ * @param characterSprite the sprite, nullptr to empty the slot
+ * @return whether there is such a slot
+ */
+bool NovelScreen::showSprite(int slot, CharacterSprite *characterSprite) {
+
+    if (!characterSpriteRenderer->pushToSlot(slot, characterSprite)) {
+        return false;
+    }
+
+    rollback.setCharacterSprites(characterSpriteRenderer->getCharacterSprites());
+
+    return true;
+}
+
+void NovelScreen::playMusic(InternedString musicName) {
+    rollback.setMusic(musicName);
+    musicManager->playAudioStream(musicName);
+}
+
+void NovelScreen::stopMusic() {
+    rollback.setMusic(InternedString());
+    musicManager->stopAudioStreams();
+}